@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    AnalysisService.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerNew.h"
+#include "FFTPlanCache.h"
+#include <atomic>
+
+// Runs the FFT + averaging for every registered AnalyserNew on a small pool of worker
+// threads instead of one thread per analyser. Channels that receive no audio cost nothing;
+// channels that do are picked up by whichever worker is free, so adding channels scales
+// with the number of cores rather than the number of threads.
+class AnalysisService
+{
+public:
+    AnalysisService() = default;
+
+    ~AnalysisService()
+    {
+        stop (1000);
+    }
+
+    // Message thread, before start()
+    void addAnalyser (AnalyserNew<float>& analyserToAdd)
+    {
+        jassert (workers.isEmpty());
+
+        analyserToAdd.attachToService (planCache, dataReady);
+        analysers.add (&analyserToAdd);
+    }
+
+    void start()
+    {
+        if (! workers.isEmpty())
+            return;
+
+        const int numWorkers = jlimit (1, maxWorkers, SystemStats::getNumCpus() - 1);
+
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add (new Worker (*this, i))->startThread (Thread::Priority::normal);
+    }
+
+    void stop (int timeoutMs)
+    {
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (int i = 0; i < workers.size(); ++i)
+            dataReady.signal();
+
+        for (auto* worker : workers)
+            worker->stopThread (timeoutMs);
+
+        workers.clear();
+    }
+
+    int getNumWorkers() const { return workers.size(); }
+
+    FFTPlanCache& getPlanCache() { return planCache; }
+
+private:
+    static constexpr int maxWorkers = 4;
+
+    class Worker : public Thread
+    {
+    public:
+        Worker (AnalysisService& s, int index)
+            : Thread (String::formatted ("FFT Analysis Worker%i", index)), service (s)
+        {
+            workspace.allocate (FFTPlanCache::maxSize * 2, true);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                if (! service.processPendingFrames (workspace))
+                    service.dataReady.wait (100);
+            }
+        }
+
+    private:
+        AnalysisService& service;
+        HeapBlock<float> workspace;
+    };
+
+    // Gives every analyser one frame per pass, starting at a rotating index so busy
+    // workers do not all contend for channel 0 first.
+    bool processPendingFrames (float* workspace)
+    {
+        const int numAnalysers = analysers.size();
+
+        if (numAnalysers == 0)
+            return false;
+
+        const int first   = (int) (nextAnalyser.fetch_add (1) % (unsigned int) numAnalysers);
+        bool didWork      = false;
+
+        for (int i = 0; i < numAnalysers; ++i)
+            didWork |= analysers.getUnchecked ((first + i) % numAnalysers)->processNextFrame (workspace);
+
+        return didWork;
+    }
+
+    FFTPlanCache planCache;
+    WaitableEvent dataReady;
+    Array<AnalyserNew<float>*> analysers;
+    OwnedArray<Worker> workers;
+    std::atomic<unsigned int> nextAnalyser { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisService)
+};
@@ -435,30 +435,33 @@ float Analyser::calculateHarmonics()
     }
     const auto* fftData = averager.getReadPointer (0);
     
-    // Peak Frequency
-    float highest   = 0.f;
-    int highestBin  = 0;
-    
     // calc fft bin scan range from min/mx frequencies...
     
-    auto binRangeMin = 0;
-    auto binRangeMax = (sampleRate / 2) / sampleRate * fft->getSize();
+    int binRangeMin = 0;
+    int binRangeMax = averager.getNumSamples();
     
     if (customRange)
     {
-        binRangeMin = static_cast<int>(customRangeMinFrequency / sampleRate * fft->getSize());
-        binRangeMax = static_cast<int>(customRangeMaxFrequency / sampleRate * fft->getSize());
+        binRangeMin = jlimit (0, averager.getNumSamples(), static_cast<int>(customRangeMinFrequency / sampleRate * fft->getSize()));
+        binRangeMax = jlimit (0, averager.getNumSamples(), static_cast<int>(customRangeMaxFrequency / sampleRate * fft->getSize()));
     }
 
-    for (int i = binRangeMin; i < binRangeMax; ++i)
+    // one pass for the tonic and every harmonic window below
+    spectralPeaks.find (fftData, binRangeMin, binRangeMax);
+
+    if (spectralPeaks.isEmpty())
     {
-        if (fftData[i] > highest)
+        for (auto& h : harmonics.get_harmonics_array())
         {
-            highest = fftData[i];
-            highestBin = i;
+            h.isActive = false;
+            h.freq = 0;
         }
+
+        return 0.f;
     }
 
+    const auto& tonicPeak = spectralPeaks[0];
+
     auto numHarmonics = numHarmonicsToTrack.load();
     
     // harmonics - replaced VLAs with vectors for safety
@@ -475,10 +478,10 @@ float Analyser::calculateHarmonics()
         bin[i]              = 0;
     }
     
-    bin[0] = highestBin;
+    bin[0] = tonicPeak.binIndex;
 
     // is highest over input threshold ?
-    double binDB = 20.0 * log10(fftData[bin[0]]);
+    double binDB = 20.0 * log10(tonicPeak.magnitude);
 
     auto& harmonicData = harmonics.get_harmonics_array();
 
@@ -491,10 +494,10 @@ float Analyser::calculateHarmonics()
         tonicHarmonic.isActive    = true;
         tonicHarmonic.binRef      = bin[0];
 
-        harmonicFreq[0]             = (sampleRate * bin[0]) / fftSize;
+        harmonicFreq[0]             = (sampleRate * tonicPeak.bin) / fftSize;
         tonicHarmonic.freq        = harmonicFreq[0];
 
-        peakDBBin[0]                = 20.0 * log10(fftData[bin[0]]);
+        peakDBBin[0]                = binDB;
         tonicHarmonic.db          = peakDBBin[0];
     }
     else
@@ -514,8 +517,6 @@ float Analyser::calculateHarmonics()
             }
             else
             {
-                highest = 0.f;
-
                 int lastBin          = bin[harmonic - 1];
                 float lastFreq       = (sampleRate * lastBin) / fftSize;
                 float minFreq        = lastFreq * powf(2.f, minIntervalInOctaves);
@@ -530,18 +531,12 @@ float Analyser::calculateHarmonics()
                 int maxIntervalBin = juce::jmax(0, juce::jmin((int)maxBinCalc, fft->getSize() - 1));
                 bool didFindHarmonic = false;
 
-                for (int i = minIntervalBin; i < maxIntervalBin && i < binRangeMax; ++i)
-                {
-                    if (fftData[i] > highest)
-                    {
-                        highest             = fftData[i];
-                        bin[harmonic]       = i;
-                    }
-                }
+                const auto* peak = spectralPeaks.findLoudestInRange (minIntervalBin, maxIntervalBin);
 
-                if (highest != 0)
+                if (peak != nullptr && peak->magnitude != 0)
                 {
-                    double db = 20.0 * log10(fftData[bin[harmonic]]);
+                    bin[harmonic]   = peak->binIndex;
+                    double db       = 20.0 * log10(peak->magnitude);
 
                     if (db > inputThreshold)
                     {
@@ -549,8 +544,8 @@ float Analyser::calculateHarmonics()
 
                         harmonicData[harmonic].isActive     = true;
                         harmonicData[harmonic].binRef       = bin[harmonic];
-                        harmonicData[harmonic].freq         = (sampleRate * bin[harmonic]) / fftSize;
-                        harmonicData[harmonic].db           = 20.0 * log10(fftData[bin[harmonic]]);
+                        harmonicData[harmonic].freq         = (sampleRate * peak->bin) / fftSize;
+                        harmonicData[harmonic].db           = db;
                         int midiNote    = -1;
                         float freqDif   = 0.f;
                         int octave      = 0;
@@ -16,6 +16,7 @@
 #include "JuceHeader.h"
 #include "Parameters.h"
 #include "FrequencyManager.h"
+#include "SpectralPeakPicker.h"
 
 //==============================================================================
 /*
@@ -331,6 +332,9 @@ private:
     juce::AudioBuffer<float> averager;
     juce::AudioBuffer<float> pitchDetectorBuffer;
 
+    // peaks of averager, refreshed by calculateHarmonics
+    SpectralPeaks<64> spectralPeaks;
+
     /* ITERATION */
     
     std::vector<float> iterationMedianData;
@@ -14,23 +14,26 @@
 #pragma once
 
 #include  <JuceHeader.h>
-
+#include "FFTPlanCache.h"
+#include "SpectrumSnapshot.h"
+#include "utilities/triple_buffer.h"
+
+// Per-channel spectrum state. Analysis runs on the AnalysisService worker pool, which
+// calls processNextFrame() whenever enough samples have been queued by addAudioData().
+// Each finished frame is published as a SpectrumSnapshot through a triple buffer; the
+// create*/get* readers run on the message thread and never block the analysis.
 template<typename Type>
-class AnalyserNew : public juce::Thread
+class AnalyserNew
 {
 public:
-    AnalyserNew() : Thread ("FFT Analyser New")
+    AnalyserNew()
     {
         averager.clear();
 
-        initMovingAverage();
-
-        initGradient();
-    }
-
-    AnalyserNew(int instance) : Thread (String::formatted("FFT Analyser%i", instance))
-    {
-        averager.clear();
+        spectrum.for_each_buffer ([] (SpectrumSnapshot& snapshot)
+        {
+            snapshot.magnitudes.resize ((size_t) FFTPlanCache::maxSize / 2, 0.f);
+        });
 
         initMovingAverage();
 
@@ -39,21 +42,25 @@ public:
 
     virtual ~AnalyserNew() = default;
 
+    // Called once by the owning AnalysisService before any other method
+    void attachToService (FFTPlanCache& cacheToUse, WaitableEvent& dataReadyEvent)
+    {
+        planCache   = &cacheToUse;
+        dataReady   = &dataReadyEvent;
+    }
+
     void initFFT()
     {
-        forwardFFT1024      = std::make_unique<dsp::FFT>(10);
-        forwardFFT2048      = std::make_unique<dsp::FFT>(11);
-        forwardFFT4096      = std::make_unique<dsp::FFT>(12);
-        forwardFFT8192      = std::make_unique<dsp::FFT>(13);
-        forwardFFT16384     = std::make_unique<dsp::FFT>(14);
-        forwardFFT32768     = std::make_unique<dsp::FFT>(15);
-        forwardFFT65536     = std::make_unique<dsp::FFT>(16);
+        jassert (planCache != nullptr);
+
+        const ScopedLock claimed (frameLock);
 
-        fftSize             = forwardFFT1024->getSize();
-        fft                 = forwardFFT1024.get();
+        fftOrder            = FFTPlanCache::minOrder;
+        fftSize             = 1 << fftOrder;
+        fft                 = planCache->getPlan (fftOrder);
+        windowing           = planCache->getWindow (fftOrder, windowingEnum);
 
-        averager            .setSize (5, forwardFFT65536->getSize() / 2, false, false, true);
-        fftBuffer           .setSize (1, forwardFFT65536->getSize(), false, false, true );
+        averager            .setSize (5, fftSize / 2, false, false, true);
 
         shouldProcess       = true;
     }
@@ -77,92 +84,82 @@ public:
                 if (block2 > 0) audioFifo.addFrom (0, start2, buffer.getReadPointer (channel, block1), block2);
             }
             abstractFifo.finishedWrite (block1 + block2);
-            waitForData.signal();
+
+            if (dataReady != nullptr && abstractFifo.getNumReady() >= fftSize)
+                dataReady->signal();
         }
     }
 
     void setupAnalyser (int audioFifoSize, Type sampleRateToUse)
     {
+        const ScopedLock claimed (frameLock);
+
         sampleRate = sampleRateToUse;
         audioFifo.setSize (1, audioFifoSize);
         abstractFifo.setTotalSize (audioFifoSize);
-
-        startThread (juce::Thread::Priority::normal);
     }
 
-    void run() override
+    // Worker thread: runs one FFT frame if this channel has enough data and no other
+    // worker is already busy with it. workspace must hold 2 * FFTPlanCache::maxSize floats.
+    bool processNextFrame (float* workspace)
     {
-        while (! threadShouldExit())
-        {
-            if (shouldProcess)
-            {
-                if (abstractFifo.getNumReady() >= fft->getSize())
-                {
-                    fftBuffer.clear();
+        const ScopedTryLock claimed (frameLock);
 
-                    int start1, block1, start2, block2;
-                    abstractFifo.prepareToRead (fft->getSize(), start1, block1, start2, block2);
-                    if (block1 > 0) fftBuffer.copyFrom (0, 0, audioFifo.getReadPointer (0, start1), block1);
-                    if (block2 > 0) fftBuffer.copyFrom (0, block1, audioFifo.getReadPointer (0, start2), block2);
-                    abstractFifo.finishedRead ((block1 + block2) / 2);
+        if (! claimed.isLocked() || ! shouldProcess || fft == nullptr || windowing == nullptr)
+            return false;
 
-                    windowing->multiplyWithWindowingTable (fftBuffer.getWritePointer (0), size_t (fft->getSize()));
+        if (abstractFifo.getNumReady() < fftSize)
+            return false;
 
-                    fft->performFrequencyOnlyForwardTransform (fftBuffer.getWritePointer (0));
+        FloatVectorOperations::clear (workspace, fftSize * 2);
 
-                    ScopedLock lockedForWriting (pathCreationLock);
-                    averager.addFrom (0, 0, averager.getReadPointer (averagerPtr), averager.getNumSamples(), -1.0f);
-                    averager.copyFrom (averagerPtr, 0, fftBuffer.getReadPointer (0), averager.getNumSamples(), 1.0f / (averager.getNumSamples() * (averager.getNumChannels() - 1)));
-                    averager.addFrom (0, 0, averager.getReadPointer (averagerPtr), averager.getNumSamples());
-                    if (++averagerPtr == averager.getNumChannels()) averagerPtr = 1;
+        int start1, block1, start2, block2;
+        abstractFifo.prepareToRead (fftSize, start1, block1, start2, block2);
+        if (block1 > 0) FloatVectorOperations::copy (workspace, audioFifo.getReadPointer (0, start1), block1);
+        if (block2 > 0) FloatVectorOperations::copy (workspace + block1, audioFifo.getReadPointer (0, start2), block2);
+        abstractFifo.finishedRead ((block1 + block2) / 2);
 
-                    // here to calculate plots etc
+        windowing->multiplyWithWindowingTable (workspace, size_t (fftSize));
 
-                    newDataAvailable = true;
-                }
+        fft->performFrequencyOnlyForwardTransform (workspace);
 
-                if (abstractFifo.getNumReady() < fft->getSize())
-                    waitForData.wait (100);
-            }
-        }
+        averager.addFrom (0, 0, averager.getReadPointer (averagerPtr), averager.getNumSamples(), -1.0f);
+        averager.copyFrom (averagerPtr, 0, workspace, averager.getNumSamples(), 1.0f / (averager.getNumSamples() * (averager.getNumChannels() - 1)));
+        averager.addFrom (0, 0, averager.getReadPointer (averagerPtr), averager.getNumSamples());
+        if (++averagerPtr == averager.getNumChannels()) averagerPtr = 1;
+
+        publishSpectrum();
+
+        newDataAvailable = true;
+
+        return true;
+    }
+
+    // Message thread: latest published spectrum, valid until the next call
+    const SpectrumSnapshot& acquireSpectrum()
+    {
+        return spectrum.acquire();
     }
 
     void createPath (Path& p, const Rectangle<float> bounds, float minFreq, float maxFreq) // half sample rate
     {
         p.clear();
 
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid()) return;
 
-        //        ScopedLock lockedForReading (pathCreationLock);
-        const auto* fftData = averager.getReadPointer (0);
+        const auto* fftData = snapshot.magnitudes.data();
         float octaves =  (log2(maxFreq) - log2(minFreq));
         const auto  factor  = bounds.getWidth() / octaves;
-        p.startNewSubPath (bounds.getX() + factor * indexToX (0, minFreq), binToY (fftData [0], bounds));
+        p.startNewSubPath (bounds.getX() + factor * indexToX (0, minFreq, snapshot), binToY (fftData [0], bounds));
 
-        // Peak freq vars
-        float highest   = 0.f;
-        int highestBin  = 0;
-
-        for (int i = 0; i < averager.getNumSamples(); ++i)
+        for (int i = 0; i < snapshot.numBins; ++i)
         {
-            float x = bounds.getX() + factor * indexToX (i, minFreq);
+            float x = bounds.getX() + factor * indexToX (i, minFreq, snapshot);
             p.lineTo (x, binToY (fftData [i], bounds));
-
-            // peak freq
-            if (shouldProcessMovingAvg)
-            {
-                if (fftData[i] > highest)
-                {
-                    highest         = fftData[i];
-                    highestBin      = i;
-                }
-            }
         }
 
-        peakFreq    = (sampleRate * highestBin) / fftSize;
-
-        peakDB      = 20.0 * log10(sqrt(fftData[highestBin])); // * might not need the sqrt **
-
-        calculateMovingAverage();
+        updatePeak (snapshot);
 
         p.lineTo(bounds.getWidth(), bounds.getHeight());
         p.lineTo(0, bounds.getHeight());
@@ -174,104 +171,18 @@ public:
 
     void createPathOptimised (Path& p, const Rectangle<float> bounds, float minFreq, float maxFreq) // half sample rate
     {
-        p.clear();
-        //        p.preallocateSpace (8 + averager.getNumSamples() * 3);
-
-        //        ScopedLock lockedForReading (pathCreationLock);
-        const auto* fftData = averager.getReadPointer (0);
-        float octaves =  (log2(maxFreq) - log2(minFreq));
-        const auto  factor  = bounds.getWidth() / octaves;
-        p.startNewSubPath (bounds.getX() + factor * indexToX (0, minFreq), binToY (fftData [0], bounds));
-
-        // Peak freq vars
-        float highest   = 0.f;
-        int highestBin  = 0;
-
-        // only for actual pixels
-
-        for (int x = 0; x < bounds.getWidth(); x++)
-        {
-            int index = xToBinIndex(x, bounds.getWidth(), minFreq, maxFreq, sampleRate, fftSize);
-
-            // need lin interpolation here for a smooth plot....
-
-            p.lineTo (x, binToY (fftData [index], bounds));
-        }
-
-        for (int i = 0; i < averager.getNumSamples(); ++i)
+        createPooledPath (p, bounds, minFreq, maxFreq, [this, bounds] (float magnitude)
         {
-            //            float x = bounds.getX() + factor * indexToX (i, minFreq);
-            //            p.lineTo (x, binToY (fftData [i], bounds));
-
-            // peak freq
-            if (shouldProcessMovingAvg)
-            {
-                if (fftData[i] > highest)
-                {
-                    highest         = fftData[i];
-                    highestBin      = i;
-                }
-            }
-        }
-
-        peakFreq    = (sampleRate * highestBin) / fftSize;
-        peakDB      = 20.0 * log10(sqrt(fftData[highestBin])); // * might not need the sqrt **
-
-        calculateMovingAverage();
-
-        p.lineTo(bounds.getWidth(), bounds.getHeight());
-        p.lineTo(0, bounds.getHeight());
-        p.closeSubPath();
-
+            return binToY (magnitude, bounds);
+        });
     }
 
     void createPathOptimisedWithRange (Path& p, const Rectangle<float> bounds, float minFreq, float maxFreq, float minDB, float maxDB)
     {
-        p.clear();
-        //        p.preallocateSpace (8 + averager.getNumSamples() * 3);
-
-        //        ScopedLock lockedForReading (pathCreationLock);
-        const auto* fftData = averager.getReadPointer (0);
-
-        float octaves =  (log2(maxFreq) - log2(minFreq)); // could be permanent, recalulated on resize..
-        const auto  factor  = bounds.getWidth() / octaves; // as above
-
-        p.startNewSubPath (bounds.getX() + factor * indexToX (0, minFreq), binToYWithRange (fftData [0], bounds, minDB, maxDB));
-
-        // Peak freq vars
-        float highest   = 0.f;
-        int highestBin  = 0;
-
-        // only for actual pixels
-
-        for (int x = 0; x < bounds.getWidth(); x++)
+        createPooledPath (p, bounds, minFreq, maxFreq, [this, bounds, minDB, maxDB] (float magnitude)
         {
-            int index = xToBinIndex(x, bounds.getWidth(), minFreq, maxFreq, sampleRate, fftSize);
-
-            p.lineTo (x, binToYWithRange (fftData [index], bounds, minDB, maxDB));
-        }
-
-        for (int i = 0; i < averager.getNumSamples(); ++i)
-        {
-            if (shouldProcessMovingAvg)
-            {
-                if (fftData[i] > highest)
-                {
-                    highest         = fftData[i];
-                    highestBin      = i;
-                }
-            }
-        }
-
-        peakFreq    = (sampleRate * highestBin) / fftSize;
-        peakDB      = 20.0 * log10(sqrt(fftData[highestBin])); // * might not need the sqrt **
-
-        calculateMovingAverage();
-
-        p.lineTo(bounds.getWidth(), bounds.getHeight());
-        p.lineTo(0, bounds.getHeight());
-        p.closeSubPath();
-
+            return binToYWithRange (magnitude, bounds, minDB, maxDB);
+        });
     }
 
     inline float dLinTerp(float x1, float x2, float y1, float y2, float x)
@@ -292,65 +203,47 @@ public:
 
     void getPeakFrequency(float & freq, float & db)
     {
-        ScopedLock lockedForReading (pathCreationLock);
-        const auto* fftData = averager.getReadPointer (0);
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid()) return;
 
-        float highest   = 0.f;
-        int highestBin  = 0;
+        const auto& peak = snapshot.peaks[0];
 
-        for (int i = 0; i < averager.getNumSamples(); ++i)
-        {
-            if (fftData[i] > highest)
-            {
-                highest         = fftData[i];
-                highestBin      = i;
-            }
-        }
-
-        freq    = (sampleRate * highestBin) / fftSize;
-        db      = 20.0 * log10(sqrt(fftData[highestBin])); // * might not need the sqrt **
+        freq    = snapshot.binToFrequency (peak.bin);
+        db      = 20.0 * log10(sqrt(peak.magnitude)); // * might not need the sqrt **
     }
 
     void getHarmonics(Array<float>& frequencies, Array<float>& db, int numHarmonicsToFind, bool upper)
     {
         if (numHarmonicsToFind <= 0) return;
 
-        const auto* fftData = averager.getReadPointer(0);
-        int numSamples = averager.getNumSamples();
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid()) return;
 
-        std::vector<float> highest(numHarmonicsToFind, 0.0f);
-        std::vector<int> highestBin(numHarmonicsToFind, 0);
+        // the loudest peaks, or nothing but bin 0 for the lower harmonics, as before
+        const auto& peaks = snapshot.peaks;
+        const float silentDB = -100.0f;
 
         for (int harmonic = 0; harmonic < numHarmonicsToFind; harmonic++)
         {
-            for (int i = 0; i < numSamples; ++i)
+            float frequency = 0.f;
+            float dbVal     = silentDB;
+
+            if (upper && harmonic < peaks.size())
             {
-                if (upper)
-                {
-                    bool alreadyFound = false;
-                    for (int h = 0; h < harmonic; h++)
-                    {
-                        if (i == highestBin[h])
-                        {
-                            alreadyFound = true;
-                            break;
-                        }
-                    }
-
-                    if (!alreadyFound && fftData[i] > highest[harmonic])
-                    {
-                        highest[harmonic] = fftData[i];
-                        highestBin[harmonic] = i;
-                    }
-                }
+                frequency   = snapshot.binToFrequency (peaks[harmonic].bin);
+                dbVal       = peaks[harmonic].magnitude > 0 ? 20.0f * std::log10(std::sqrt(peaks[harmonic].magnitude)) : silentDB;
+            }
+            else if (! upper)
+            {
+                const float dc = snapshot.magnitudes[0];
+                dbVal       = dc > 0 ? 20.0f * std::log10(std::sqrt(dc)) : silentDB;
             }
 
             if (harmonic < frequencies.size())
-                frequencies.set(harmonic, (sampleRate * (float)highestBin[harmonic]) / (float)fftSize);
+                frequencies.set(harmonic, frequency);
             else
-                frequencies.add((sampleRate * (float)highestBin[harmonic]) / (float)fftSize);
+                frequencies.add(frequency);
 
-            float dbVal = (fftData[highestBin[harmonic]] > 0) ? 20.0f * std::log10(std::sqrt(fftData[highestBin[harmonic]])) : -100.0f;
             if (harmonic < db.size())
                 db.set(harmonic, dbVal);
             else
@@ -455,29 +348,32 @@ public:
     float octaveMinFreq = 0;
     float octaveMaxFreq = 0;
     int octaveFFTSize   = 0;
+    float octaveSampleRate = 0;
     bool isFirstRun = true;
     int startBin = 0; // set as minFreqBin
 
     void getMagnitudeDataForOctave(Array<float>& magnitude, int& numBands, float minFreq, float maxFreq, float sr, Array<float>& centralFreqs)
     {
         magnitude.clear();
-        
-        if (averager.getNumChannels() == 0)
+
+        const auto& snapshot = acquireSpectrum();
+
+        if (! snapshot.isValid())
         {
             numBands = 0;
             return;
         }
 
-        const auto* fftData = averager.getReadPointer(0);
+        const auto* fftData = snapshot.magnitudes.data();
 
-        if (minFreq != octaveMinFreq || maxFreq != octaveMaxFreq || sr != sampleRate || octaveFFTSize != fftSize || isFirstRun)
+        if (minFreq != octaveMinFreq || maxFreq != octaveMaxFreq || sr != octaveSampleRate || octaveFFTSize != snapshot.fftSize || isFirstRun)
         {
             isFirstRun      = false;
-            octaveFFTSize   = fftSize;
-            sampleRate      = sr;
+            octaveFFTSize   = snapshot.fftSize;
+            octaveSampleRate = sr;
             octaveMinFreq   = minFreq;
             octaveMaxFreq   = maxFreq;
-            octaveNumBands  = calculateBands(octaveMinFreq, octaveMaxFreq, sr, fftSize);
+            octaveNumBands  = calculateBands(octaveMinFreq, octaveMaxFreq, sr, snapshot.fftSize);
         }
 
         centralFreqs = centralFrequencies;
@@ -489,7 +385,7 @@ public:
         int bandRef = 0;
 
         int firstBin = (binBandStarts.size() > 0) ? binBandStarts[0] : 0;
-        int maxBin = averager.getNumSamples();
+        int maxBin = snapshot.numBins;
 
         for (int bin = firstBin; bin < maxBin; ++bin)
         {
@@ -526,6 +422,10 @@ public:
 
     ColourGradient gradientDecibels;
 
+    // gradientDecibels sampled at colourPaletteSize evenly spaced levels, index 0 = -80 dB
+    static constexpr int colourPaletteSize = 256;
+    PixelARGB colourPalette[colourPaletteSize];
+
     void initGradient()
     {
         gradientDecibels.addColour(0.f, Colours::black);
@@ -533,99 +433,103 @@ public:
         gradientDecibels.addColour(0.4f, Colours::red);
         gradientDecibels.addColour(0.6f, Colours::yellow);
         gradientDecibels.addColour(0.8f, Colours::white);
+
+        for (int i = 0; i < colourPaletteSize; ++i)
+            colourPalette[i] = gradientDecibels.getColourAtPosition ((double) i / (colourPaletteSize - 1)).getPixelARGB();
     }
 
-    void createColourSpectrum(Image & imageToRenderTo, float minFreq, float maxFreq, float logScale)
+    // Writes the current spectrum into one column of the image, lowest frequency at the
+    // bottom. The caller owns the scrolling: it advances the column itself and draws the
+    // image as a ring, so nothing already drawn is moved.
+    void createColourSpectrum(Image & imageToRenderTo, int column, float minFreq, float maxFreq)
     {
-        ScopedLock lockedForReading (pathCreationLock);
-        if (averager.getNumChannels() == 0 || fft == nullptr || sampleRate <= 0)
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid() || snapshot.sampleRate <= 0)
             return;
 
-        if (imageToRenderTo.getWidth() <= 0 || imageToRenderTo.getHeight() <= 0)
+        const int imageHeight = imageToRenderTo.getHeight();
+
+        if (! isPositiveAndBelow (column, imageToRenderTo.getWidth()) || imageHeight <= 0)
             return;
 
-        const auto* fftData = averager.getReadPointer (0);
+        updateColourRowBins (imageHeight, minFreq, maxFreq, snapshot);
+
+        const auto* fftData = snapshot.magnitudes.data();
 
-        auto rightHandEdge = imageToRenderTo.getWidth() - 1;
-        auto imageHeight   = imageToRenderTo.getHeight();
+        // dB -> palette index, the same -80..0 dB mapping gradientDecibels always had
+        const float infinity    = -80.f;
+        const float floorGain   = Decibels::decibelsToGain (infinity);
+        const float indexScale  = (colourPaletteSize - 1) * 20.f / -infinity;
+        const float indexOffset = (float) (colourPaletteSize - 1);
 
-        imageToRenderTo.moveImageSection (0, 0, 1, 0, rightHandEdge, imageHeight);
+        Image::BitmapData pixels (imageToRenderTo, column, 0, 1, imageHeight, Image::BitmapData::writeOnly);
 
-        for (auto y = 0; y < imageHeight; ++y)
+        for (int y = 0; y < imageHeight; ++y)
         {
-            float y2                = (float)imageHeight - y;
+            const float magnitude = fftData[colourRowBins[(size_t) y]];
 
-            auto fftDataIndex       = xToBinIndex(y2, (float)imageHeight, minFreq, maxFreq, (float)sampleRate, fftSize);
+            const int index = magnitude > floorGain
+                            ? jlimit (0, colourPaletteSize - 1, (int) (indexScale * std::log10 (magnitude) + indexOffset))
+                            : 0;
 
-            if (fftDataIndex >= 0 && fftDataIndex < averager.getNumSamples())
-            {
-                float infinity          = -80.f;
-                auto level              = jmap (Decibels::gainToDecibels (fftData[fftDataIndex], infinity), infinity, 0.0f, 0.f, 1.f);
-                imageToRenderTo.setPixelAt (rightHandEdge, y, gradientDecibels.getColourAtPosition(level));
-            }
+            auto* pixel = pixels.getLinePointer (y);
+
+            if (pixels.pixelFormat == Image::RGB)
+                reinterpret_cast<PixelRGB*> (pixel)->set (colourPalette[index]);
+            else if (pixels.pixelFormat == Image::ARGB)
+                reinterpret_cast<PixelARGB*> (pixel)->set (colourPalette[index]);
         }
     }
 
     void getFrequencyData(double& peakFrequency, double& peakDB, Array<float>& harmonics, Array<float>& intervals, double& ema)
     {
-        const auto* fftData = averager.getReadPointer(0);
-        int numSamples = averager.getNumSamples();
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid()) return;
 
-        if (numSamples <= 0) return;
+        const auto& peaks = snapshot.peaks;
+        const int numSamples = snapshot.numBins;
 
-        // Peak Frequency
-        float highest = 0.f;
-        int highestBin = 0;
-        for (int i = 0; i < numSamples; ++i)
+        auto peakToDB = [] (const SpectralPeak& peak)
         {
-            if (fftData[i] > highest)
-            {
-                highest = fftData[i];
-                highestBin = i;
-            }
-        }
+            return peak.magnitude > 0 ? 20.0f * std::log10(std::sqrt(peak.magnitude)) : -100.0f;
+        };
 
+        // Peak Frequency, then each harmonic is the loudest peak at least a quarter
+        // octave above the previous one
         std::vector<float> harmonicFreq(6, 0.0f);
         std::vector<float> peakDBBin(6, -100.0f);
-        std::vector<float> interval(6, 0.0f);
-        std::vector<int> bin(6, 0);
 
-        bin[0] = highestBin;
-        harmonicFreq[0] = (sampleRate * (float)bin[0]) / (float)fftSize;
-        peakDBBin[0] = (fftData[bin[0]] > 0) ? 20.0f * std::log10(std::sqrt(fftData[bin[0]])) : -100.0f;
+        const SpectralPeak* previous = &peaks[0];
+
+        harmonicFreq[0] = snapshot.binToFrequency (previous->bin);
+        peakDBBin[0]    = peakToDB (*previous);
 
         for (int harmonic = 1; harmonic < 6; harmonic++)
         {
-            highest = 0.f;
-            int lastBin = bin[harmonic - 1];
-            float lastFreq = (sampleRate * (float)lastBin) / (float)fftSize;
-            float nextFreq = lastFreq * powf(2.f, 0.25f);
-            int nextBin = (int)((nextFreq / sampleRate) * (float)fftSize);
+            float nextFreq = harmonicFreq[harmonic - 1] * powf(2.f, 0.25f);
+            int nextBin = (int)((nextFreq / snapshot.sampleRate) * (float)snapshot.fftSize);
 
             if (nextBin >= numSamples) break;
 
-            for (int i = nextBin; i < numSamples; ++i)
-            {
-                if (fftData[i] > highest)
-                {
-                    highest = fftData[i];
-                    bin[harmonic] = i;
-                }
-            }
+            const SpectralPeak* found = peaks.findLoudestInRange (jmax (nextBin, previous->binIndex + 1), numSamples);
+
+            if (found == nullptr) break;
 
-            harmonicFreq[harmonic] = (sampleRate * (float)bin[harmonic]) / (float)fftSize;
-            peakDBBin[harmonic] = (fftData[bin[harmonic]] > 0) ? 20.0f * std::log10(std::sqrt(fftData[bin[harmonic]])) : -100.0f;
+            previous = found;
+
+            harmonicFreq[harmonic] = snapshot.binToFrequency (found->bin);
+            peakDBBin[harmonic] = peakToDB (*found);
 
             if (harmonic < harmonics.size())
                 harmonics.set(harmonic, harmonicFreq[harmonic]);
             else
                 harmonics.add(harmonicFreq[harmonic]);
 
-            interval[harmonic] = harmonicFreq[harmonic] - harmonicFreq[harmonic - 1];
+            const float interval = harmonicFreq[harmonic] - harmonicFreq[harmonic - 1];
             if (harmonic < intervals.size())
-                intervals.set(harmonic, interval[harmonic]);
+                intervals.set(harmonic, interval);
             else
-                intervals.add(interval[harmonic]);
+                intervals.add(interval);
         }
 
         peakFrequency = harmonicFreq[0];
@@ -646,63 +550,151 @@ public:
     {
         if (fft == nullptr) return;
 
-        shouldProcess   = false;
+        const ScopedLock claimed (frameLock);
 
         windowingEnum   = windowEnum;
 
-        windowMethod    = (dsp::WindowingFunction<float>::WindowingMethod) windowingEnum ;
-
-        windowing       = std::make_unique<dsp::WindowingFunction<float>> (fft->getSize(),  windowMethod, true, 4 );
-
-        shouldProcess   = true;
+        windowing       = planCache->getWindow (fftOrder, windowingEnum);
     }
 
     void setNewFFTSize(int fftEnum)
     {
-        shouldProcess = false;
+        const ScopedLock claimed (frameLock);
 
         averager.clear();
-        fftBuffer.clear();
 
         abstractFifo.reset();
 
-        if      (fftEnum == 1 || fftEnum == 0) { fftSize = 1024; fft = forwardFFT1024.get(); }
-        else if (fftEnum == 2) { fftSize = 2048; fft = forwardFFT2048.get(); }
-        else if (fftEnum == 3) { fftSize = 4096; fft = forwardFFT4096.get(); }
-        else if (fftEnum == 4) { fftSize = 8192; fft = forwardFFT8192.get(); }
-        else if (fftEnum == 5) { fftSize = 16384; fft = forwardFFT16384.get(); }
-        else if (fftEnum == 6) { fftSize = 32768; fft = forwardFFT32768.get(); }
-        else if (fftEnum == 7) { fftSize = 65536; fft = forwardFFT65536.get(); }
-
-        if (fft != nullptr)
-        {
-            fftBuffer.setSize(1, fftSize, false, false, true); 
-            averager.setSize(5, fftSize / 2, false, false, true);
-            audioFifo.setSize (1, fftSize + 1);
-            abstractFifo.setTotalSize (fftSize + 1);
-
-            windowMethod    = (dsp::WindowingFunction<float>::WindowingMethod) windowingEnum ;
-            windowing       = std::make_unique<dsp::WindowingFunction<float>> (fft->getSize(),  windowMethod, true, 4 );
-        }
+        fftOrder        = FFTPlanCache::orderForFFTSizeEnum (fftEnum);
+        fftSize         = 1 << fftOrder;
+        fft             = planCache->getPlan (fftOrder);
+        windowing       = planCache->getWindow (fftOrder, windowingEnum);
 
-        shouldProcess   = true;
+        averager.setSize(5, fftSize / 2, false, false, true);
+        audioFifo.setSize (1, fftSize + 1);
+        abstractFifo.setTotalSize (fftSize + 1);
     }
 
 private:
 
-    inline float indexToX (float index, float minFreq) const
+    inline float indexToX (float index, float minFreq, const SpectrumSnapshot& snapshot) const
     {
-        const auto freq = (sampleRate * index) / fft->getSize();
+        const auto freq = snapshot.binToFrequency (index);
         return (freq > 0.01f) ? std::log (freq / minFreq) / std::log (2.0f) : 0.0f;
     }
 
-    inline int xToBinIndex (float x, float w, float minFreq, float maxFreq, float sr, int fftSize) const
+    inline int xToBinIndex (float x, float w, float minFreq, float maxFreq, const SpectrumSnapshot& snapshot) const
     {
         float xScale                = x / w;
         float freq                  = powf(10.f, xScale * (log10f(maxFreq)-log10f(minFreq)) + log10f(minFreq));
-        int binIndex                = (int)freq / sampleRate  * fft->getSize();
+        int binIndex                = (int) ((int)freq / snapshot.sampleRate  * snapshot.fftSize);
+
+        return jlimit (0, snapshot.numBins - 1, binIndex);
+    }
+
+    // peaks[0] is the loudest bin, refined between bins
+    void updatePeak (const SpectrumSnapshot& snapshot)
+    {
+        const auto& peak = snapshot.peaks[0];
+
+        peakFreq    = snapshot.binToFrequency (peak.bin);
+        peakDB      = 20.0 * log10(sqrt(peak.magnitude)); // * might not need the sqrt **
 
-        return binIndex;
+        calculateMovingAverage();
+    }
+
+    // One point per pixel column, at the loudest of the bins that fall in that column. At
+    // large FFT sizes a column spans many bins, and picking one of them would drop peaks.
+    template <typename MagnitudeToY>
+    void createPooledPath (Path& p, const Rectangle<float> bounds, float minFreq, float maxFreq, MagnitudeToY&& magnitudeToY)
+    {
+        p.clear();
+
+        const auto& snapshot = acquireSpectrum();
+        if (! snapshot.isValid() || bounds.getWidth() <= 0) return;
+
+        const auto* fftData = snapshot.magnitudes.data();
+
+        updatePathColumnBins (bounds.getWidth(), minFreq, maxFreq, snapshot);
+
+        const int numColumns = (int) pathColumnBins.size() - 1;
+
+        p.preallocateSpace (3 * (numColumns + 4));
+        p.startNewSubPath (bounds.getX(), magnitudeToY (fftData [0]));
+
+        for (int x = 0; x < numColumns; x++)
+        {
+            const int start     = pathColumnBins[(size_t) x];
+            const int end       = jmax (start + 1, pathColumnBins[(size_t) x + 1]);
+            const float peak    = FloatVectorOperations::findMaximum (fftData + start, end - start);
+
+            p.lineTo ((float) x, magnitudeToY (peak));
+        }
+
+        updatePeak (snapshot);
+
+        p.lineTo(bounds.getWidth(), bounds.getHeight());
+        p.lineTo(0, bounds.getHeight());
+        p.closeSubPath();
+    }
+
+    // First bin of every pixel column, plus the end of the last one. Rebuilt only when the
+    // width, the frequency range or the FFT layout changes.
+    void updatePathColumnBins (float width, float minFreq, float maxFreq, const SpectrumSnapshot& snapshot)
+    {
+        if (width == pathColumnWidth && minFreq == pathColumnMinFreq && maxFreq == pathColumnMaxFreq
+            && snapshot.fftSize == pathColumnFFTSize && snapshot.sampleRate == pathColumnSampleRate)
+            return;
+
+        const int numColumns = jmax (1, (int) std::ceil (width));
+
+        pathColumnBins.resize ((size_t) numColumns + 1);
+
+        for (int x = 0; x <= numColumns; ++x)
+            pathColumnBins[(size_t) x] = xToBinIndex ((float) x, width, minFreq, maxFreq, snapshot);
+
+        pathColumnWidth         = width;
+        pathColumnMinFreq       = minFreq;
+        pathColumnMaxFreq       = maxFreq;
+        pathColumnFFTSize       = snapshot.fftSize;
+        pathColumnSampleRate    = snapshot.sampleRate;
+    }
+
+    // Bin shown on each row of the colour spectrum, rebuilt only when the image height,
+    // the frequency range or the FFT layout changes
+    void updateColourRowBins (int imageHeight, float minFreq, float maxFreq, const SpectrumSnapshot& snapshot)
+    {
+        if (imageHeight == colourRowHeight && minFreq == colourRowMinFreq && maxFreq == colourRowMaxFreq
+            && snapshot.fftSize == colourRowFFTSize && snapshot.sampleRate == colourRowSampleRate)
+            return;
+
+        colourRowBins.resize ((size_t) imageHeight);
+
+        for (int y = 0; y < imageHeight; ++y)
+            colourRowBins[(size_t) y] = xToBinIndex ((float) (imageHeight - y), (float) imageHeight, minFreq, maxFreq, snapshot);
+
+        colourRowHeight     = imageHeight;
+        colourRowMinFreq    = minFreq;
+        colourRowMaxFreq    = maxFreq;
+        colourRowFFTSize    = snapshot.fftSize;
+        colourRowSampleRate = snapshot.sampleRate;
+    }
+
+    // Worker thread, frameLock held
+    void publishSpectrum()
+    {
+        auto& snapshot      = spectrum.write_buffer();
+        const int numBins   = jmin (averager.getNumSamples(), (int) snapshot.magnitudes.size());
+
+        FloatVectorOperations::copy (snapshot.magnitudes.data(), averager.getReadPointer (0), numBins);
+        snapshot.peaks.find (snapshot.magnitudes.data(), 0, numBins);
+
+        snapshot.version    = ++publishedVersion;
+        snapshot.fftSize    = fftSize;
+        snapshot.numBins    = numBins;
+        snapshot.sampleRate = (float) sampleRate;
+
+        spectrum.publish();
     }
 
     inline float binToY (float bin, const Rectangle<float> bounds) const
@@ -719,27 +711,23 @@ private:
                      minDB, maxDB, bounds.getBottom(), bounds.getY());
     }
 
-    WaitableEvent waitForData;
-    CriticalSection pathCreationLock;
+    FFTPlanCache*   planCache { nullptr };
+    WaitableEvent*  dataReady { nullptr };
+    CriticalSection frameLock;          // held by the worker processing this channel
+
+    audio_devs::triple_buffer<SpectrumSnapshot> spectrum;
+    uint64 publishedVersion = 0;
 
     Type sampleRate {};
 
+    int fftOrder = FFTPlanCache::minOrder;
     int fftSize = 0;
     int windowingEnum = 0;
 
-    // mine
-    dsp::FFT * fft { nullptr };
-    std::unique_ptr<dsp::FFT> forwardFFT1024;
-    std::unique_ptr<dsp::FFT> forwardFFT2048;
-    std::unique_ptr<dsp::FFT> forwardFFT4096;
-    std::unique_ptr<dsp::FFT> forwardFFT8192;
-    std::unique_ptr<dsp::FFT> forwardFFT16384;
-    std::unique_ptr<dsp::FFT> forwardFFT32768;
-    std::unique_ptr<dsp::FFT> forwardFFT65536;
-
-    std::unique_ptr<dsp::WindowingFunction<float>> windowing;
-    dsp::WindowingFunction<float>::WindowingMethod  windowMethod;
-    AudioBuffer<float> fftBuffer;
+    // shared, owned by the FFTPlanCache
+    const dsp::FFT * fft { nullptr };
+    const dsp::WindowingFunction<float> * windowing { nullptr };
+
     AudioBuffer<float> averager;
     int averagerPtr = 1;
     AbstractFifo abstractFifo              { 96000 };
@@ -747,7 +735,23 @@ private:
 
     std::atomic<bool> newDataAvailable { false };
 
-    bool shouldProcess = false;
+    std::atomic<bool> shouldProcess { false };
+
+    // message thread, see createPooledPath
+    std::vector<int> pathColumnBins;
+    float pathColumnWidth       = 0;
+    float pathColumnMinFreq     = 0;
+    float pathColumnMaxFreq     = 0;
+    int pathColumnFFTSize       = 0;
+    float pathColumnSampleRate  = 0;
+
+    // message thread, see createColourSpectrum
+    std::vector<int> colourRowBins;
+    int colourRowHeight         = 0;
+    float colourRowMinFreq      = 0;
+    float colourRowMaxFreq      = 0;
+    int colourRowFFTSize        = 0;
+    float colourRowSampleRate   = 0;
 
 #define NUM_AVG 30
 
@@ -15,26 +15,33 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "AnalyzerNew.h"
+#include "AnalysisService.h"
 #include "TSSConstants.h"
 #include <array>
 
+// Channel-indexed facade over the AnalysisService: 0-3 are the inputs, 4-7 the outputs.
 class AnalyzerPool
 {
 public:
     static constexpr int kMaxAnalyzers = TSS::Audio::kMaxAnalyzers;
 
-    AnalyzerPool() = default;
+    AnalyzerPool()
+    {
+        for (auto& analyzer : analyzers)
+            service.addAnalyser (analyzer);
+    }
 
     void stopAllThreads(int timeoutMs)
     {
-        for (int i = 0; i < kMaxAnalyzers; ++i)
-            analyzers[i].stopThread(timeoutMs);
+        service.stop (timeoutMs);
     }
 
     void setupAll(int sampleRateInt, float sampleRateFloat)
     {
         for (int i = 0; i < kMaxAnalyzers; ++i)
             analyzers[i].setupAnalyser(sampleRateInt, sampleRateFloat);
+
+        service.start();
     }
 
     void setNewFFTSizeAll(int fftSizeEnumValue)
@@ -76,8 +83,12 @@ public:
         return analyzers[channel];
     }
 
+    AnalysisService& getService() { return service; }
+
 private:
+    // declared before the service so the workers are stopped before the analysers go away
     std::array<AnalyserNew<float>, kMaxAnalyzers> analyzers;
+    AnalysisService service;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyzerPool)
 };
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    BLEPTables.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "BLEPTables.h"
+#include <cmath>
+#include <vector>
+
+const BLEPTables& BLEPTables::get() noexcept
+{
+    static const BLEPTables tables;
+    return tables;
+}
+
+namespace
+{
+    // built while the program starts, so the first oscillator on the audio thread doesn't
+    const BLEPTables& startupTables = BLEPTables::get();
+}
+
+BLEPTables::BLEPTables()
+{
+    generate (twoPoint,                 1, Window::rectangular);
+    generate (eightPointBlackmanHarris, 2, Window::blackmanHarris);
+}
+
+void BLEPTables::generate (double* table, int lobesPerSide, Window window)
+{
+    const double pi = 3.14159265358979323846;
+    const int    last = tableLength - 1;
+
+    std::vector<double> pulse ((size_t) tableLength);
+    double total = 0.0;
+
+    for (int i = 0; i < tableLength; ++i)
+    {
+        const double x = lobesPerSide * (2.0 * i / last - 1.0);
+        const double sinc = x == 0.0 ? 1.0 : std::sin (pi * x) / (pi * x);
+
+        double gain = 1.0;
+
+        if (window == Window::blackmanHarris)
+            gain = 0.42323 - 0.49755 * std::cos (2.0 * pi * i / last) + 0.07922 * std::cos (4.0 * pi * i / last);
+
+        pulse[(size_t) i] = sinc * gain;
+        total += pulse[(size_t) i];
+    }
+
+    // trapezoidal running integral, so the halves mirror each other exactly
+    double sum = 0.0;
+
+    for (int i = 0; i < tableLength; ++i)
+    {
+        sum += pulse[(size_t) i];
+
+        const double step = (sum - 0.5 * pulse[(size_t) i]) / total;
+        const double ideal = 2 * i > last ? 1.0 : 0.0;
+
+        table[i] = 2.0 * (step - ideal);
+    }
+}
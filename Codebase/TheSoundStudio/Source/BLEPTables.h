@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    BLEPTables.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+// Band-limited step residuals for the BLEP sawtooths in Oscillators.h and VAOscillator.h.
+//
+// Each table is a windowed sinc, integrated and normalised to a unit step, minus the ideal
+// step, scaled to an edge height of 2; tableLength points evenly spaced over the pulse,
+// zero at both ends and jumping from +1 to -1 in the middle. The oscillators read them as
+// doBLEP (table, tableLength, ...) with the points per side given next to each.
+//
+// They are built once while the program starts, in well under a millisecond, rather than
+// compiled in as literals.
+class BLEPTables
+{
+public:
+    static constexpr int tableLength = 4096;
+
+    static const BLEPTables& get() noexcept;
+
+    // 1 point per side: one sinc lobe, rectangular window
+    const double* getTwoPointTable() const noexcept                     { return twoPoint; }
+
+    // 4 points per side: two sinc lobes, 3-term Blackman-Harris window
+    const double* getEightPointBlackmanHarrisTable() const noexcept     { return eightPointBlackmanHarris; }
+
+private:
+    enum class Window { rectangular, blackmanHarris };
+
+    BLEPTables();
+
+    static void generate (double* table, int lobesPerSide, Window window);
+
+    double twoPoint[tableLength];
+    double eightPointBlackmanHarris[tableLength];
+};
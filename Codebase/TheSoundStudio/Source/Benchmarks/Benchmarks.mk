@@ -0,0 +1,49 @@
+# Builds the DSP benchmark runner on top of the Projucer Linux Makefile, which it
+# includes for the app's objects, flags and compile rules. Run it from that exporter's
+# folder so the generated paths resolve:
+#
+#   make -C Builds/LinuxMakefile -f ../../Source/Benchmarks/Benchmarks.mk CONFIG=Release
+#
+# The runner links every app object except Main, which holds the app's main(), and the
+# EnhancedLissajousEngine, which is not in the app target yet but is benchmarked here.
+
+include Makefile
+
+.DEFAULT_GOAL := benchmark
+
+JUCE_TARGET_BENCHMARK := TheSoundStudioBenchmarks
+
+OBJECTS_BENCHMARK := \
+  $(filter-out $(JUCE_OBJDIR)/Main_90ebc5c2.o,$(OBJECTS_APP)) \
+  $(JUCE_OBJDIR)/DSPBenchmarks_27852e73.o \
+  $(JUCE_OBJDIR)/EnhancedLissajousEngine_2f58cf9a.o \
+
+.PHONY: benchmark clean-benchmark
+
+benchmark : $(JUCE_OUTDIR)/$(JUCE_TARGET_BENCHMARK)
+
+$(JUCE_OUTDIR)/$(JUCE_TARGET_BENCHMARK) : $(OBJECTS_BENCHMARK) $(JUCE_OBJDIR)/execinfo.cmd $(RESOURCES)
+	@command -v $(PKG_CONFIG) >/dev/null 2>&1 || { echo >&2 "pkg-config not installed. Please, install it."; exit 1; }
+	@$(PKG_CONFIG) --print-errors alsa freetype2 fontconfig gl libcurl
+	@echo Linking "The Sound Studio - Benchmarks"
+	-$(V_AT)mkdir -p $(JUCE_BINDIR)
+	-$(V_AT)mkdir -p $(JUCE_LIBDIR)
+	-$(V_AT)mkdir -p $(JUCE_OUTDIR)
+	$(V_AT)$(CXX) -o $(JUCE_OUTDIR)/$(JUCE_TARGET_BENCHMARK) $(OBJECTS_BENCHMARK) $(JUCE_LDFLAGS) $(shell cat $(JUCE_OBJDIR)/execinfo.cmd) $(JUCE_LDFLAGS_APP) $(RESOURCES) $(TARGET_ARCH)
+
+$(JUCE_OBJDIR)/DSPBenchmarks_27852e73.o: ../../Source/Benchmarks/DSPBenchmarks.cpp
+	-$(V_AT)mkdir -p $(@D)
+	@echo "Compiling DSPBenchmarks.cpp"
+	$(V_AT)$(CXX) $(JUCE_CXXFLAGS) $(JUCE_CPPFLAGS_APP) $(JUCE_CFLAGS_APP) -o "$@" -c "$<"
+
+$(JUCE_OBJDIR)/EnhancedLissajousEngine_2f58cf9a.o: ../../Source/EnhancedLissajousEngine.cpp
+	-$(V_AT)mkdir -p $(@D)
+	@echo "Compiling EnhancedLissajousEngine.cpp"
+	$(V_AT)$(CXX) $(JUCE_CXXFLAGS) $(JUCE_CPPFLAGS_APP) $(JUCE_CFLAGS_APP) -o "$@" -c "$<"
+
+clean-benchmark:
+	$(V_AT)rm -f $(JUCE_OUTDIR)/$(JUCE_TARGET_BENCHMARK) $(JUCE_OBJDIR)/DSPBenchmarks_27852e73.o $(JUCE_OBJDIR)/DSPBenchmarks_27852e73.d
+	$(V_AT)rm -f $(JUCE_OBJDIR)/EnhancedLissajousEngine_2f58cf9a.o $(JUCE_OBJDIR)/EnhancedLissajousEngine_2f58cf9a.d
+
+-include $(JUCE_OBJDIR)/DSPBenchmarks_27852e73.d
+-include $(JUCE_OBJDIR)/EnhancedLissajousEngine_2f58cf9a.d
@@ -0,0 +1,711 @@
+/*
+  ==============================================================================
+
+    DSPBenchmarks.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ProjectManager.h"
+#include "VotanSynthProcessor.h"
+#include "WavetableSynthProcessor.h"
+#include "ChordPlayerProcessor.h"
+#include "ChordScannerProcessor.h"
+#include "FrequencyPlayerProcessor.h"
+#include "FrequencyScannerProcessor.h"
+#include "AnalyzerNew.h"
+#include "RepeaterScheduler.h"
+#include "BLEPTables.h"
+#include "EnhancedLissajousEngine.h"
+#include "EnhancedLissajousComponent.h"     // not in the app target yet, compiled here so it keeps building
+#include <iostream>
+
+//=============================================================
+// DSP Benchmarks
+//=============================================================
+// Stand-alone timing of the audio hot paths, built with
+//
+//   make -C Builds/LinuxMakefile -f ../../Source/Benchmarks/Benchmarks.mk CONFIG=Release
+//
+// and run as
+//
+//   build/TheSoundStudioBenchmarks [--output results.json] [--filter text]
+//                                  [--repeats 5] [--min-time-ms 200]
+//                                  [--sample-rate 44100] [--block-size 512]
+//
+// or, to run only the accuracy checks that precede the timings, as
+//
+//   build/TheSoundStudioBenchmarks --check
+//
+// Every benchmark starts from the same state and the same seeded input, so runs on one
+// machine are comparable between releases. Each one is calibrated to run for at least
+// --min-time-ms, then timed --repeats times; the JSON holds the median, min and max time
+// per iteration and, for anything that produces audio, how many times faster than real
+// time it runs.
+
+namespace
+{
+    struct Benchmark
+    {
+        String group;
+        String name;
+        int    samplesPerIteration = 0;   // audio processed per iteration, 0 when not audio
+
+        // setup runs once, outside the timing, and returns the body that is timed
+        std::function<std::function<void()>()> setup;
+    };
+
+    struct Settings
+    {
+        File    outputFile;
+        String  filter;
+        int     repeats     = 5;
+        int     minTimeMs   = 200;
+        double  sampleRate  = 44100.0;
+        int     blockSize   = 512;
+    };
+
+    // read by every body so the optimiser cannot drop the work
+    volatile float sink = 0.f;
+
+    void consume (const AudioBuffer<float>& buffer)
+    {
+        sink = sink + buffer.getSample (0, buffer.getNumSamples() - 1);
+    }
+
+    void fillWithTestSignal (AudioBuffer<float>& buffer, double sampleRate, double frequency)
+    {
+        // a harmonic tone with a little seeded noise, the same on every run
+        Random random (0x5EED);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const double phase = MathConstants<double>::twoPi * frequency * i / sampleRate;
+
+                data[i] = (float) (0.5 * std::sin (phase) + 0.25 * std::sin (2.0 * phase) + 0.125 * std::sin (3.0 * phase))
+                        + 0.01f * (random.nextFloat() * 2.f - 1.f);
+            }
+        }
+    }
+
+    File getBenchmarkLogDirectory()
+    {
+        return File::getSpecialLocation (File::tempDirectory).getChildFile ("TSSBenchmarkLogs");
+    }
+
+    std::unique_ptr<ProjectManager> createProjectManager (AUDIO_MODE mode, const Settings& settings)
+    {
+        auto projectManager = std::make_unique<ProjectManager>();
+
+        // keep the sequencer logs of a benchmark run out of the user's documents
+        getBenchmarkLogDirectory().createDirectory();
+        projectManager->setDirectoryFileForSettingParameter (LOG_FILE_LOCATION, getBenchmarkLogDirectory());
+
+        projectManager->setMode (mode);
+        projectManager->prepareToPlay (settings.blockSize, settings.sampleRate);
+        projectManager->setPlayerPlayMode (PLAY_MODE::LOOP);
+        projectManager->setPlayerCommand (COMMAND_PLAYER_PLAYPAUSE);
+
+        return projectManager;
+    }
+
+    //=============================================================
+    // Synth voices
+    //=============================================================
+    // One voice of each synth, started through its processor so it has the same tables
+    // and settings as in the app, then rendered directly through renderNextBlock
+
+    // Synths whose tables come from the builder thread play silence until they arrive,
+    // which would be timed as nearly free
+    template <typename SynthType>
+    void waitForTables (SynthType&)
+    {
+    }
+
+    void waitForTables (WavetableSynthProcessor& synth)
+    {
+        const bool ready = synth.waitForWaveTables (10000);
+        jassert (ready);
+        ignoreUnused (ready);
+    }
+
+    template <typename SynthType>
+    std::function<void()> createVoiceBody (const Settings& settings, std::function<void (SynthType&)> configure)
+    {
+        auto frequencyManager   = std::make_shared<FrequencyManager>();
+        auto synth              = std::make_shared<SynthType> ((float) settings.sampleRate, frequencyManager.get());
+        auto buffer             = std::make_shared<AudioBuffer<float>> (2, settings.blockSize);
+
+        synth->prepareToPlay ((float) settings.sampleRate, settings.blockSize);
+        synth->setParameter (ENV_AMPLITUDE, 100.0);
+        synth->setParameter (ENV_ATTACK,    1.0);
+        synth->setParameter (ENV_DECAY,     1.0);
+        synth->setParameter (ENV_SUSTAIN,   100.0);
+        synth->setParameter (ENV_RELEASE,   1.0);
+        configure (*synth);
+
+        waitForTables (*synth);
+
+        synth->noteOn (1, 57, 216.f);
+
+        SynthesiserVoice* voice = nullptr;
+
+        for (int i = 0; i < synth->getNumVoices() && voice == nullptr; ++i)
+            if (synth->getVoice (i)->isVoiceActive())
+                voice = synth->getVoice (i);
+
+        jassert (voice != nullptr);
+
+        return [frequencyManager, synth, buffer, voice]
+        {
+            buffer->clear();
+            voice->renderNextBlock (*buffer, 0, buffer->getNumSamples());
+            consume (*buffer);
+        };
+    }
+
+    void addSynthVoiceBenchmarks (Array<Benchmark>& benchmarks, const Settings& settings)
+    {
+        const std::pair<int, const char*> waveforms[] = { { 1, "sine" }, { 2, "triangle" }, { 3, "square" }, { 4, "sawtooth" } };
+
+        for (const auto& waveform : waveforms)
+        {
+            const int type = waveform.first;
+
+            benchmarks.add ({ "ChordSynthVoice", waveform.second, settings.blockSize, [&settings, type]
+            {
+                return createVoiceBody<ChordSynthProcessor> (settings, [type] (ChordSynthProcessor& synth)
+                {
+                    synth.setParameter (WAVEFORM_TYPE, type);
+                });
+            } });
+        }
+
+        const std::pair<int, const char*> instruments[] =
+        {
+            { PIANO, "piano" }, { ELEC_PIANO, "electric_piano" }, { FLUTE, "flute" }, { GUITAR, "guitar" },
+            { HARP, "harp" }, { BELL, "bell" }, { STRINGS, "strings" }, { VIOLIN, "violin" }
+        };
+
+        for (const auto& instrument : instruments)
+        {
+            const int type = instrument.first;
+
+            benchmarks.add ({ "WavetableSynthVoice", instrument.second, settings.blockSize, [&settings, type]
+            {
+                return createVoiceBody<WavetableSynthProcessor> (settings, [type] (WavetableSynthProcessor& synth)
+                {
+                    synth.setParameter (INSTRUMENT_TYPE, type);
+                });
+            } });
+        }
+    }
+
+    //=============================================================
+    // Analysis
+    //=============================================================
+    void addAnalysisBenchmarks (Array<Benchmark>& benchmarks, const Settings& settings)
+    {
+        // FFT + averager + published spectrum for one hop (half a frame) of input
+        for (int fftEnum = 1; fftEnum <= 7; ++fftEnum)
+        {
+            const int fftSize = 1 << FFTPlanCache::orderForFFTSizeEnum (fftEnum);
+
+            benchmarks.add ({ "AnalyserNew", "fft_" + String (fftSize), fftSize / 2, [&settings, fftEnum, fftSize]
+            {
+                struct State
+                {
+                    FFTPlanCache        planCache;
+                    WaitableEvent       dataReady;
+                    AnalyserNew<float>  analyser;
+                    AudioBuffer<float>  hop;
+                    HeapBlock<float>    workspace;
+                };
+
+                auto state = std::make_shared<State>();
+
+                state->analyser.attachToService (state->planCache, state->dataReady);
+                state->analyser.initFFT();
+                state->analyser.setupAnalyser (fftSize + 1, (float) settings.sampleRate);
+                state->analyser.setNewFFTSize (fftEnum);
+
+                state->workspace.calloc (2 * FFTPlanCache::maxSize);
+                state->hop.setSize (1, fftSize / 2);
+                fillWithTestSignal (state->hop, settings.sampleRate, 216.0);
+
+                // prime the first half frame, every iteration then completes one frame
+                state->analyser.addAudioData (state->hop, 0, 1);
+
+                return std::function<void()> ([state]
+                {
+                    state->analyser.addAudioData (state->hop, 0, 1);
+                    const bool processed = state->analyser.processNextFrame (state->workspace.get());
+                    jassertquiet (processed);
+                    sink = sink + state->workspace[1];
+                });
+            } });
+        }
+
+        for (const int bufferSize : { 1024, 2048, 4096 })
+        {
+            benchmarks.add ({ "PitchYIN", "buffer_" + String (bufferSize), bufferSize, [&settings, bufferSize]
+            {
+                auto yin    = std::make_shared<PitchYIN> ((int) settings.sampleRate, (unsigned int) bufferSize);
+                auto input  = std::make_shared<AudioBuffer<float>> (1, bufferSize);
+                fillWithTestSignal (*input, settings.sampleRate, 216.0);
+
+                return std::function<void()> ([yin, input]
+                {
+                    sink = sink + yin->getPitchInHz (input->getReadPointer (0));
+                });
+            } });
+
+            benchmarks.add ({ "PitchMPM", "buffer_" + String (bufferSize), bufferSize, [&settings, bufferSize]
+            {
+                auto mpm    = std::make_shared<PitchMPM> ((int) settings.sampleRate, (size_t) bufferSize);
+                auto input  = std::make_shared<AudioBuffer<float>> (1, bufferSize);
+                fillWithTestSignal (*input, settings.sampleRate, 216.0);
+
+                return std::function<void()> ([mpm, input]
+                {
+                    sink = sink + mpm->getPitch (input->getReadPointer (0));
+                });
+            } });
+        }
+    }
+
+    //=============================================================
+    // Visualisers
+    //=============================================================
+    void addVisualiserBenchmarks (Array<Benchmark>& benchmarks)
+    {
+        // one animation frame of the six-axis preset, the points the window moved onto
+        for (const bool withFrequencyModulation : { false, true })
+        {
+            const char* name = withFrequencyModulation ? "animation_frame_fm" : "animation_frame";
+
+            benchmarks.add ({ "EnhancedLissajousEngine", name, 0, [withFrequencyModulation]
+            {
+                auto engine = std::make_shared<EnhancedLissajousEngine>();
+
+                engine->loadChaotic();
+                engine->setResolution (MAX_CURVE_POINTS);
+
+                if (withFrequencyModulation)
+                {
+                    for (int i = 0; i < engine->getNumberOfAxes(); ++i)
+                    {
+                        engine->getAxis (i).freqModDepth = 0.1f;
+                        engine->getAxis (i).freqModRate  = 0.25f;
+                    }
+                }
+
+                // animation is switched on after initialize, so no timer is started and
+                // only the body advances it
+                engine->initialize();
+                engine->setAnimationMode (true);
+
+                return std::function<void()> ([engine]
+                {
+                    engine->timerCallback();
+                    sink = sink + engine->getMultiAxisCurve().back()[0];
+                });
+            } });
+        }
+    }
+
+    //=============================================================
+    // Audio callback and repeaters
+    //=============================================================
+    void addProjectManagerBenchmarks (Array<Benchmark>& benchmarks, const Settings& settings)
+    {
+        const std::pair<AUDIO_MODE, const char*> modes[] =
+        {
+            { MODE_CHORD_PLAYER,            "chord_player" },
+            { MODE_CHORD_SCANNER,           "chord_scanner" },
+            { MODE_FUNDAMENTAL_FREQUENCY,   "fundamental_frequency" },
+            { MODE_FREQUENCY_PLAYER,        "frequency_player" },
+            { MODE_FREQUENCY_SCANNER,       "frequency_scanner" },
+            { MODE_REALTIME_ANALYSIS,       "realtime_analysis" },
+            { MODE_LISSAJOUS_CURVES,        "lissajous_curves" },
+            { MODE_FEEDBACK_MODULE,         "feedback_module" }
+        };
+
+        // the whole device callback, fed the same input block every time
+        for (const auto& mode : modes)
+        {
+            const auto audioMode = mode.first;
+
+            benchmarks.add ({ "ProjectManager::getNextAudioBlock", mode.second, settings.blockSize, [&settings, audioMode]
+            {
+                std::shared_ptr<ProjectManager> projectManager (createProjectManager (audioMode, settings));
+
+                auto input  = std::make_shared<AudioBuffer<float>> (2, settings.blockSize);
+                auto buffer = std::make_shared<AudioBuffer<float>> (2, settings.blockSize);
+                fillWithTestSignal (*input, settings.sampleRate, 216.0);
+
+                return std::function<void()> ([projectManager, input, buffer]
+                {
+                    buffer->makeCopyOf (*input, true);
+                    projectManager->getNextAudioBlock (AudioSourceChannelInfo (buffer.get(), 0, buffer->getNumSamples()));
+                    consume (*buffer);
+                });
+            } });
+        }
+
+        // the event scheduling alone, without rendering the segments between events
+        const auto addRepeater = [&benchmarks, &settings] (const char* name, AUDIO_MODE audioMode,
+                                                           std::function<int (ProjectManager&, int)> tick)
+        {
+            benchmarks.add ({ "PlayRepeater", name, settings.blockSize, [&settings, audioMode, tick]
+            {
+                std::shared_ptr<ProjectManager> projectManager (createProjectManager (audioMode, settings));
+                const int blockSize = settings.blockSize;
+
+                return std::function<void()> ([projectManager, tick, blockSize]
+                {
+                    int numSegments = 0;
+
+                    RepeaterScheduler::processBlock (blockSize,
+                                                     [&] (int maxSamples) { return tick (*projectManager, maxSamples); },
+                                                     [&] (int, int) { ++numSegments; });
+
+                    sink = sink + (float) numSegments;
+                });
+            } });
+        };
+
+        addRepeater ("chord_player", MODE_CHORD_PLAYER, [] (ProjectManager& pm, int maxSamples)
+        {
+            return pm.chordPlayerProcessor->repeater->tickUntilNextEvent (maxSamples);
+        });
+
+        addRepeater ("chord_scanner", MODE_CHORD_SCANNER, [] (ProjectManager& pm, int maxSamples)
+        {
+            return pm.chordScannerProcessor->repeater->tickUntilNextEvent (maxSamples);
+        });
+
+        addRepeater ("frequency_player", MODE_FREQUENCY_PLAYER, [] (ProjectManager& pm, int maxSamples)
+        {
+            return pm.frequencyPlayerProcessor->repeater->tickUntilNextEvent (maxSamples);
+        });
+
+        addRepeater ("frequency_scanner", MODE_FREQUENCY_SCANNER, [] (ProjectManager& pm, int maxSamples)
+        {
+            return pm.frequencyScannerProcessor->repeater->tickUntilNextEvent (maxSamples);
+        });
+    }
+
+    //=============================================================
+    // Runner
+    //=============================================================
+    double timeIterations (const std::function<void()>& body, int64 numIterations)
+    {
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int64 i = 0; i < numIterations; ++i)
+            body();
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+    }
+
+    var runBenchmark (const Benchmark& benchmark, const Settings& settings)
+    {
+        const auto body = benchmark.setup();
+
+        // warm caches and lazily built tables, then double the count until one run is long enough
+        timeIterations (body, 8);
+
+        const double minSeconds = settings.minTimeMs / 1000.0;
+        int64 numIterations = 1;
+
+        while (timeIterations (body, numIterations) < minSeconds && numIterations < ((int64) 1 << 40))
+            numIterations *= 2;
+
+        Array<double> secondsPerIteration;
+
+        for (int r = 0; r < settings.repeats; ++r)
+            secondsPerIteration.add (timeIterations (body, numIterations) / (double) numIterations);
+
+        std::sort (secondsPerIteration.begin(), secondsPerIteration.end());
+
+        const double median = secondsPerIteration[secondsPerIteration.size() / 2];
+
+        auto* result = new DynamicObject();
+        result->setProperty ("group",               benchmark.group);
+        result->setProperty ("name",                benchmark.name);
+        result->setProperty ("iterations",          numIterations);
+        result->setProperty ("repeats",             settings.repeats);
+        result->setProperty ("nsPerIteration",      median * 1.0e9);
+        result->setProperty ("nsPerIterationMin",   secondsPerIteration.getFirst() * 1.0e9);
+        result->setProperty ("nsPerIterationMax",   secondsPerIteration.getLast() * 1.0e9);
+
+        if (benchmark.samplesPerIteration > 0)
+        {
+            result->setProperty ("samplesPerIteration", benchmark.samplesPerIteration);
+            result->setProperty ("realtimeFactor", (benchmark.samplesPerIteration / settings.sampleRate) / median);
+        }
+
+        return var (result);
+    }
+
+    //=============================================================
+    // Accuracy checks
+    //=============================================================
+    // Tables the app builds at startup instead of compiling in, compared with what they
+    // were, so a change to a generator fails here rather than only sounding different
+
+    struct CheckResult
+    {
+        String name;
+        double maxError     = 0.0;
+        double tolerance    = 0.0;
+
+        bool hasPassed() const     { return maxError <= tolerance; }
+    };
+
+    // Points of the BLEP residuals as they were compiled in before BLEPTables, every 64th
+    // point and the four around the step
+    struct BLEPReference
+    {
+        int     index;
+        double  twoPoint;
+        double  eightPointBlackmanHarris;
+    };
+
+    const BLEPReference blepReferences[] =
+    {
+        {    0,                 0,                 0 },
+        {   64,   0.0008456535503,  -1.085811379e-05 },
+        {  128,    0.003448353068,  -5.488671884e-05 },
+        {  192,    0.007901334445,  -0.0001661157572 },
+        {  256,      0.0142900798,  -0.0004014825766 },
+        {  320,     0.02269164179,  -0.0008397137992 },
+        {  384,     0.03317400146,   -0.001577371074 },
+        {  448,     0.04579548101,    -0.00272100427 },
+        {  512,     0.06060422262,    -0.00437441711 },
+        {  576,     0.07763769763,   -0.006620417222 },
+        {  640,     0.09692239839,   -0.009496974379 },
+        {  704,      0.1184734423,    -0.01296859549 },
+        {  768,      0.1422942757,    -0.01689456226 },
+        {  832,      0.1683766264,    -0.02099673365 },
+        {  896,      0.1967001525,    -0.02483033702 },
+        {  960,      0.2272326357,    -0.02776174419 },
+        { 1024,      0.2599301895,    -0.02895732698 },
+        { 1088,      0.2947369421,    -0.02738720159 },
+        { 1152,      0.3315856302,    -0.02184662301 },
+        { 1216,      0.3703975169,    -0.01099661026 },
+        { 1280,      0.4110829992,    0.006576454241 },
+        { 1344,      0.4535424084,      0.0322844819 },
+        { 1408,       0.497665487,     0.06744872703 },
+        { 1472,      0.5433329884,      0.1132041558 },
+        { 1536,      0.5904169266,      0.1704044102 },
+        { 1600,      0.6387809621,      0.2395351686 },
+        { 1664,      0.6882816443,      0.3206445188 },
+        { 1728,      0.7387694046,      0.4132955725 },
+        { 1792,      0.7900883913,      0.5165499881 },
+        { 1856,      0.8420780702,       0.628982264 },
+        { 1920,      0.8945739966,      0.7487273523 },
+        { 1984,      0.9474094164,       0.873560106 },
+        { 2046,       0.998757458,       0.997002655 },
+        { 2047,      0.9995860585,      0.9990007087 },
+        { 2048,     -0.9995853415,     -0.9990012443 },
+        { 2049,      -0.998756742,     -0.9970032039 },
+        { 2112,     -0.9465814506,     -0.8715832547 },
+        { 2176,     -0.8937499249,     -0.7468119575 },
+        { 2240,      -0.841260026,     -0.6271645016 },
+        { 2304,     -0.7892795734,     -0.5148627754 },
+        { 2368,     -0.7379726274,     -0.4117639639 },
+        { 2432,     -0.6874987165,     -0.3192873388 },
+        { 2496,     -0.6380144933,     -0.2383626289 },
+        { 2560,     -0.5896694312,     -0.1694203006 },
+        { 2624,     -0.5426062658,     -0.1124037742 },
+        { 2688,     -0.4969619885,    -0.06682098204 },
+        { 2752,     -0.4528638746,    -0.03181410305 },
+        { 2816,       -0.41043147,   -0.006243604253 },
+        { 2880,     -0.3697739428,     0.01121394432 },
+        { 2944,     -0.3309921812,     0.02197024398 },
+        { 3008,     -0.2941751522,     0.02743873984 },
+        { 3072,     -0.2594007847,     0.02895691326 },
+        { 3136,     -0.2267365222,     0.02772669174 },
+        { 3200,     -0.1962381095,     0.02477508923 },
+        { 3264,     -0.1679497035,     0.02093346576 },
+        { 3328,     -0.1419032119,     0.01683100391 },
+        { 3392,     -0.1181176316,     0.01291024258 },
+        { 3456,    -0.09660169756,    0.009447900553 },
+        { 3520,    -0.07735355277,    0.006580989411 },
+        { 3584,    -0.06035501033,    0.004344603926 },
+        { 3648,    -0.04558082341,    0.002699178719 },
+        { 3712,     -0.0329933891,    0.001562783287 },
+        { 3776,     -0.0225438524,    0.000830636261 },
+        { 3840,     -0.0141738723,   0.0003963466714 },
+        { 3904,   -0.007816284338,   0.0001634467753 },
+        { 3968,   -0.003392673342,   5.387184009e-05 },
+        { 4032,  -0.0008191119595,   1.046168572e-05 },
+        { 4095,                 0,                 0 }
+    };
+
+    Array<CheckResult> runAccuracyChecks()
+    {
+        const auto& tables = BLEPTables::get();
+
+        // the generated tables came out at most 3.7e-5 and 1.8e-4 from the old literals
+        CheckResult twoPoint    { "BLEPTables/two_point",                       0.0, 1.0e-4 };
+        CheckResult eightPoint  { "BLEPTables/eight_point_blackman_harris",     0.0, 5.0e-4 };
+
+        for (const auto& reference : blepReferences)
+        {
+            twoPoint.maxError   = jmax (twoPoint.maxError,   std::abs (tables.getTwoPointTable()[reference.index] - reference.twoPoint));
+            eightPoint.maxError = jmax (eightPoint.maxError, std::abs (tables.getEightPointBlackmanHarrisTable()[reference.index]
+                                                                         - reference.eightPointBlackmanHarris));
+        }
+
+        return { twoPoint, eightPoint };
+    }
+
+    var createCheckResult (const CheckResult& check)
+    {
+        auto* result = new DynamicObject();
+        result->setProperty ("name",        check.name);
+        result->setProperty ("maxError",    check.maxError);
+        result->setProperty ("tolerance",   check.tolerance);
+        result->setProperty ("passed",      check.hasPassed());
+        return var (result);
+    }
+
+    var createMachineInfo (const Settings& settings)
+    {
+        auto* info = new DynamicObject();
+        info->setProperty ("appVersion",    ProjectInfo::versionString);
+       #if JUCE_DEBUG
+        info->setProperty ("build",         "Debug");
+       #else
+        info->setProperty ("build",         "Release");
+       #endif
+        info->setProperty ("date",          Time::getCurrentTime().toISO8601 (true));
+        info->setProperty ("os",            SystemStats::getOperatingSystemName());
+        info->setProperty ("cpu",           SystemStats::getCpuModel());
+        info->setProperty ("numCpus",       SystemStats::getNumCpus());
+        info->setProperty ("sampleRate",    settings.sampleRate);
+        info->setProperty ("blockSize",     settings.blockSize);
+        info->setProperty ("minTimeMs",     settings.minTimeMs);
+        return var (info);
+    }
+
+    bool parseArguments (const ArgumentList& args, Settings& settings)
+    {
+        if (args.containsOption ("--output"))
+            settings.outputFile = args.getFileForOption ("--output");
+
+        if (args.containsOption ("--filter"))       settings.filter     = args.getValueForOption ("--filter");
+        if (args.containsOption ("--repeats"))      settings.repeats    = args.getValueForOption ("--repeats").getIntValue();
+        if (args.containsOption ("--min-time-ms"))  settings.minTimeMs  = args.getValueForOption ("--min-time-ms").getIntValue();
+        if (args.containsOption ("--sample-rate"))  settings.sampleRate = args.getValueForOption ("--sample-rate").getDoubleValue();
+        if (args.containsOption ("--block-size"))   settings.blockSize  = args.getValueForOption ("--block-size").getIntValue();
+
+        return settings.repeats > 0 && settings.minTimeMs > 0 && settings.sampleRate >= 8000.0
+            && settings.blockSize >= 16 && settings.blockSize <= 16384;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const ArgumentList args (argc, argv);
+    Settings settings;
+
+    if (args.containsOption ("--help|-h") || ! parseArguments (args, settings))
+    {
+        std::cout << "Usage: TheSoundStudioBenchmarks [--output results.json] [--filter text] [--repeats 5]" << std::endl
+                  << "                                [--min-time-ms 200] [--sample-rate 44100] [--block-size 512]" << std::endl
+                  << "       TheSoundStudioBenchmarks --check" << std::endl;
+        return args.containsOption ("--help|-h") ? 0 : 1;
+    }
+
+   #if JUCE_DEBUG
+    std::cout << "Warning: this is a Debug build, build with CONFIG=Release for comparable numbers" << std::endl;
+   #endif
+
+    // timing code whose tables are wrong tells us nothing, so a failed check stops the run
+    Array<var> checks;
+    bool allChecksPassed = true;
+
+    for (const auto& check : runAccuracyChecks())
+    {
+        checks.add (createCheckResult (check));
+        allChecksPassed = allChecksPassed && check.hasPassed();
+
+        std::cout << check.name.paddedRight (' ', 56)
+                  << String (check.maxError, 8).paddedLeft (' ', 12) << " max error"
+                  << (check.hasPassed() ? "" : "  FAILED, tolerance " + String (check.tolerance)) << std::endl;
+    }
+
+    if (! allChecksPassed)
+    {
+        std::cerr << "Accuracy checks failed" << std::endl;
+        return 1;
+    }
+
+    if (args.containsOption ("--check"))
+        return 0;
+
+    Array<Benchmark> benchmarks;
+    addSynthVoiceBenchmarks (benchmarks, settings);
+    addAnalysisBenchmarks (benchmarks, settings);
+    addVisualiserBenchmarks (benchmarks);
+    addProjectManagerBenchmarks (benchmarks, settings);
+
+    Array<var> results;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        const auto fullName = benchmark.group + "/" + benchmark.name;
+
+        if (settings.filter.isNotEmpty() && ! fullName.containsIgnoreCase (settings.filter))
+            continue;
+
+        const auto result = runBenchmark (benchmark, settings);
+        results.add (result);
+
+        std::cout << fullName.paddedRight (' ', 56)
+                  << String ((double) result["nsPerIteration"] / 1000.0, 2).paddedLeft (' ', 12) << " us";
+
+        if (result.hasProperty ("realtimeFactor"))
+            std::cout << String ((double) result["realtimeFactor"], 1).paddedLeft (' ', 12) << "x realtime";
+
+        std::cout << std::endl;
+    }
+
+    auto* report = new DynamicObject();
+    report->setProperty ("schemaVersion",   1);
+    report->setProperty ("machine",         createMachineInfo (settings));
+    report->setProperty ("checks",          checks);
+    report->setProperty ("benchmarks",      results);
+
+    const auto json = JSON::toString (var (report));
+
+    if (settings.outputFile == File())
+    {
+        std::cout << json << std::endl;
+    }
+    else if (! settings.outputFile.replaceWithText (json))
+    {
+        std::cerr << "Cannot write " << settings.outputFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    getBenchmarkLogDirectory().deleteRecursively();
+
+    return 0;
+}
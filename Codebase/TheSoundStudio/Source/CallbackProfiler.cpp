@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    CallbackProfiler.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "CallbackProfiler.h"
+
+String CallbackProfiler::getStageName (int stage)
+{
+    switch (stage)
+    {
+        case PARAMETER_CHANGES: return "Parameter changes";
+        case INPUT_GAINS:       return "Input gains";
+        case INPUT_ANALYSERS:   return "Input analysers";
+        case MODE_PROCESSOR:    return "Mode processor";
+        case PLUGIN_SLOT_1:     return "Plugin slot 1";
+        case PLUGIN_SLOT_2:     return "Plugin slot 2";
+        case PLUGIN_SLOT_3:     return "Plugin slot 3";
+        case PLUGIN_SLOT_4:     return "Plugin slot 4";
+        case OUTPUT_GAINS:      return "Output gains";
+        case OUTPUT_ANALYSERS:  return "Output analysers";
+        case OSCILLOSCOPE:      return "Oscilloscope";
+        case RECORDER:          return "Recorder";
+        default:                return {};
+    }
+}
+
+CallbackProfiler::CallbackProfiler()
+    : Thread ("Callback Profiler"),
+      timings (timingQueueSize)
+{
+    startThread (Thread::Priority::background);
+}
+
+CallbackProfiler::~CallbackProfiler()
+{
+    stopThread (2000);
+
+    writePendingLog();
+}
+
+void CallbackProfiler::prepareToPlay (double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    // the gap since the last callback of the old stream is not a late callback
+    restartedStream = true;
+}
+
+void CallbackProfiler::setLogDirectory (const File& newLogDirectory)
+{
+    const ScopedLock sl (logDirectoryLock);
+    logDirectory = newLogDirectory;
+}
+
+CallbackProfiler::Summary CallbackProfiler::getSummary() const
+{
+    const ScopedLock sl (summaryLock);
+    return summary;
+}
+
+//=============================================================
+// Profiler thread
+//=============================================================
+void CallbackProfiler::run()
+{
+    windowStartTicks = Time::getHighResolutionTicks();
+
+    while (! threadShouldExit())
+    {
+        wait (collectIntervalMs);
+
+        BlockTiming block;
+
+        while (timings.try_pop (block))
+            addToWindow (block);
+
+        const double windowSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - windowStartTicks);
+
+        if (windowSeconds * 1000.0 >= windowMs)
+            publishWindow();
+    }
+}
+
+void CallbackProfiler::addToWindow (const BlockTiming& block)
+{
+    const double budgetSeconds = block.numSamples / sampleRate.load();
+
+    if (budgetSeconds <= 0.0)
+        return;
+
+    const auto toLoad = [budgetSeconds] (int64 ticks)
+    {
+        return (float) (Time::highResolutionTicksToSeconds (ticks) / budgetSeconds);
+    };
+
+    const float load = toLoad (block.endTicks - block.startTicks);
+
+    window.numBlocks++;
+    windowLoadSum       += load;
+    window.peakLoad     = jmax (window.peakLoad, load);
+
+    int worstStage = 0;
+
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        const float stageLoad = toLoad (block.stageTicks[stage]);
+
+        windowStageLoadSum[stage]   += stageLoad;
+        window.stagePeakLoad[stage] = jmax (window.stagePeakLoad[stage], stageLoad);
+
+        if (block.stageTicks[stage] > block.stageTicks[worstStage])
+            worstStage = stage;
+    }
+
+    if (load > 1.f)
+    {
+        window.numDeadlineMisses++;
+        window.lastWorstStage = worstStage;
+        ++totalDeadlineMisses;
+
+        logMissedBlock (block, budgetSeconds, worstStage);
+    }
+
+    // a callback is late when it starts well after the previous block's audio ran out
+    if (restartedStream.exchange (false))
+    {
+        previousStartTicks = 0;
+    }
+    else if (previousStartTicks != 0 && previousNumSamples > 0)
+    {
+        const double interval = Time::highResolutionTicksToSeconds (block.startTicks - previousStartTicks);
+        const double expected = previousNumSamples / sampleRate.load();
+
+        // over a second apart the stream was stopped, not starved
+        if (interval > 2.0 * expected && interval < 1.0)
+        {
+            window.numLateCallbacks++;
+            ++totalLateCallbacks;
+        }
+    }
+
+    previousStartTicks = block.startTicks;
+    previousNumSamples = block.numSamples;
+}
+
+void CallbackProfiler::publishWindow()
+{
+    if (window.numBlocks > 0)
+    {
+        window.averageLoad = (float) (windowLoadSum / window.numBlocks);
+
+        for (int stage = 0; stage < NUM_STAGES; ++stage)
+            window.stageAverageLoad[stage] = (float) (windowStageLoadSum[stage] / window.numBlocks);
+    }
+
+    window.numDroppedTimings    = numDroppedTimings.exchange (0);
+    window.totalDeadlineMisses  = totalDeadlineMisses;
+    window.totalLateCallbacks   = totalLateCallbacks;
+
+    if (numMissesNotLogged > 0 || window.numLateCallbacks > 0)
+    {
+        pendingLog << Time::getCurrentTime().toString (true, true, true, true) << " - " << window.numDeadlineMisses << " deadline misses ("
+                   << numMissesNotLogged << " not listed), " << window.numLateCallbacks << " late callbacks, peak load "
+                   << String (window.peakLoad * 100.f, 0) << "%" << newLine;
+    }
+
+    {
+        const ScopedLock sl (summaryLock);
+        summary = window;
+    }
+
+    writePendingLog();
+
+    window              = {};
+    windowLoadSum       = 0;
+    numMissesNotLogged  = 0;
+    std::fill (std::begin (windowStageLoadSum), std::end (windowStageLoadSum), 0.0);
+
+    windowStartTicks    = Time::getHighResolutionTicks();
+}
+
+void CallbackProfiler::logMissedBlock (const BlockTiming& block, double budgetSeconds, int worstStage)
+{
+    if (window.numDeadlineMisses > maxLoggedMissesPerWindow)
+    {
+        ++numMissesNotLogged;
+        return;
+    }
+
+    const auto toMs = [] (int64 ticks) { return String (Time::highResolutionTicksToSeconds (ticks) * 1000.0, 3); };
+
+    pendingLog << Time::getCurrentTime().toString (true, true, true, true) << " - deadline miss: " << block.numSamples << " samples at "
+               << String (sampleRate.load(), 0) << " Hz took " << toMs (block.endTicks - block.startTicks)
+               << " ms of " << String (budgetSeconds * 1000.0, 3) << " ms, slowest " << getStageName (worstStage) << " |";
+
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+        pendingLog << " " << getStageName (stage) << " " << toMs (block.stageTicks[stage]);
+
+    pendingLog << newLine;
+}
+
+void CallbackProfiler::writePendingLog()
+{
+    if (pendingLog.isEmpty())
+        return;
+
+    File directory;
+
+    {
+        const ScopedLock sl (logDirectoryLock);
+        directory = logDirectory;
+    }
+
+    if (directory == File())
+    {
+        pendingLog.clear();
+        return;
+    }
+
+    if (logFile == File() || logFile.getParentDirectory() != directory)
+    {
+        logFile = directory.getChildFile (Time::getCurrentTime().formatted ("%d.%m.%Y-%H-%M-") + "Audio-Callback-Profile.txt");
+
+        if (logFile.create().failed())
+        {
+            logFile = File();
+            pendingLog.clear();
+            return;
+        }
+
+        logFile.appendText ("Audio callback deadline misses and late callbacks, times in ms" + String (newLine));
+    }
+
+    logFile.appendText (pendingLog);
+    pendingLog.clear();
+}
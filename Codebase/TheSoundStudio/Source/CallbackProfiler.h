@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    CallbackProfiler.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Parameters.h"
+#include "utilities/spsc_queue.h"
+#include <algorithm>
+#include <atomic>
+
+//=============================================================
+// Callback Profiler
+//=============================================================
+// Times each stage of ProjectManager::getNextAudioBlock. The audio thread only reads the
+// high resolution clock between stages and posts the block's timings to a queue. A
+// background thread sums them into one-second windows for the CPU overlay, and writes
+// every block that ran past its deadline, with its slowest stage, to the log directory.
+//
+// A block's deadline is its own duration at the current sample rate. Callbacks that
+// start more than two blocks after the previous one are counted as late: the device
+// waited on something outside the callback, or the previous block overran.
+class CallbackProfiler : private Thread
+{
+public:
+    enum Stage
+    {
+        PARAMETER_CHANGES = 0,
+        INPUT_GAINS,
+        INPUT_ANALYSERS,
+        MODE_PROCESSOR,
+        PLUGIN_SLOT_1,
+        PLUGIN_SLOT_2,
+        PLUGIN_SLOT_3,
+        PLUGIN_SLOT_4,
+        OUTPUT_GAINS,
+        OUTPUT_ANALYSERS,
+        OSCILLOSCOPE,
+        RECORDER,
+        NUM_STAGES
+    };
+
+    static_assert (PLUGIN_SLOT_4 - PLUGIN_SLOT_1 + 1 == NUM_PLUGIN_SLOTS, "one stage per plugin slot");
+
+    static String getStageName (int stage);
+
+    // One window of callbacks. Loads are the time spent over the block's duration, so
+    // 1.0 is a missed deadline.
+    struct Summary
+    {
+        int     numBlocks               = 0;
+        int     numDeadlineMisses       = 0;
+        int     numLateCallbacks        = 0;
+        int     numDroppedTimings       = 0;    // queue was full, blocks not counted
+        float   averageLoad             = 0.f;
+        float   peakLoad                = 0.f;
+        float   stageAverageLoad[NUM_STAGES] {};
+        float   stagePeakLoad[NUM_STAGES] {};
+        int     lastWorstStage          = -1;   // slowest stage of the last missed block
+        int64   totalDeadlineMisses     = 0;    // since the profiler started
+        int64   totalLateCallbacks      = 0;
+    };
+
+    CallbackProfiler();
+    ~CallbackProfiler() override;
+
+    // Message thread, before the callbacks start
+    void prepareToPlay (double sampleRate);
+    void setEnabled (bool shouldBeEnabled)      { enabled = shouldBeEnabled; }
+
+    // Message thread, any time. Nothing is logged until there is a directory; a new one
+    // starts a new log file there
+    void setLogDirectory (const File& newLogDirectory);
+
+    //=============================================================
+    // Audio thread
+    void beginBlock (int numSamples) noexcept
+    {
+        isTimingBlock = enabled.load (std::memory_order_relaxed);
+
+        if (! isTimingBlock)
+            return;
+
+        std::fill (std::begin (currentBlock.stageTicks), std::end (currentBlock.stageTicks), (int64) 0);
+
+        currentBlock.numSamples = numSamples;
+        currentBlock.startTicks = lastTicks = Time::getHighResolutionTicks();
+    }
+
+    // everything since the previous stage (or the start of the block) goes to this one
+    void endStage (int stage) noexcept
+    {
+        if (! isTimingBlock)
+            return;
+
+        const int64 now = Time::getHighResolutionTicks();
+
+        currentBlock.stageTicks[stage] += now - lastTicks;
+        lastTicks = now;
+    }
+
+    // stages that ran side by side since the last one, each with its own time; their sum
+    // can come to more than the time that passed
+    void endParallelStages (int firstStage, const int64* ticksPerStage, int numStages) noexcept
+    {
+        if (! isTimingBlock)
+            return;
+
+        for (int i = 0; i < numStages; ++i)
+            currentBlock.stageTicks[firstStage + i] += ticksPerStage[i];
+
+        lastTicks = Time::getHighResolutionTicks();
+    }
+
+    void endBlock() noexcept
+    {
+        if (! isTimingBlock)
+            return;
+
+        currentBlock.endTicks = lastTicks;
+
+        if (! timings.try_push (currentBlock))
+            numDroppedTimings.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    //=============================================================
+    // Any other thread: the last complete window
+    Summary getSummary() const;
+
+private:
+    struct BlockTiming
+    {
+        int64   startTicks = 0;
+        int64   endTicks   = 0;
+        int64   stageTicks[NUM_STAGES] {};
+        int     numSamples = 0;
+    };
+
+    void run() override;
+    void addToWindow (const BlockTiming& block);
+    void publishWindow();
+    void logMissedBlock (const BlockTiming& block, double budgetSeconds, int worstStage);
+    void writePendingLog();
+
+    static constexpr int timingQueueSize            = 2048;
+    static constexpr int collectIntervalMs          = 50;
+    static constexpr int windowMs                   = 1000;
+    static constexpr int maxLoggedMissesPerWindow   = 20;
+
+    // audio thread
+    std::atomic<bool> enabled { true };
+    bool        isTimingBlock = false;
+    int64       lastTicks     = 0;
+    BlockTiming currentBlock;
+
+    audio_devs::spsc_queue<BlockTiming> timings;
+    std::atomic<int>    numDroppedTimings { 0 };
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<bool>   restartedStream { true };
+
+    // profiler thread
+    Summary window;
+    double  windowLoadSum = 0;
+    double  windowStageLoadSum[NUM_STAGES] {};
+    int64   windowStartTicks = 0;
+    int64   previousStartTicks = 0;
+    int     previousNumSamples = 0;
+    int     numMissesNotLogged = 0;
+    int64   totalDeadlineMisses = 0;
+    int64   totalLateCallbacks = 0;
+
+    File        logFile;
+    String      pendingLog;
+
+    // message thread -> profiler thread
+    CriticalSection logDirectoryLock;
+    File        logDirectory;
+
+    // profiler thread -> readers
+    mutable CriticalSection summaryLock;
+    Summary summary;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackProfiler)
+};
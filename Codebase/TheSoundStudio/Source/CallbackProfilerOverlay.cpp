@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    CallbackProfilerOverlay.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "CallbackProfilerOverlay.h"
+#include "UI/DesignSystem.h"
+
+using namespace TSS::Design;
+
+CallbackProfilerOverlay::CallbackProfilerOverlay (CallbackProfiler& profilerToShow)
+    : profiler (profilerToShow)
+{
+    setSize (collapsedWidth, collapsedHeight);
+    setMouseCursor (MouseCursor::PointingHandCursor);
+
+    // the summary only changes once a second, this just picks it up promptly
+    startTimerHz (4);
+}
+
+CallbackProfilerOverlay::~CallbackProfilerOverlay()
+{
+    stopTimer();
+}
+
+void CallbackProfilerOverlay::timerCallback()
+{
+    summary = profiler.getSummary();
+    repaint();
+}
+
+void CallbackProfilerOverlay::mouseUp (const MouseEvent&)
+{
+    setExpanded (! isExpanded);
+}
+
+void CallbackProfilerOverlay::setExpanded (bool shouldBeExpanded)
+{
+    isExpanded = shouldBeExpanded;
+
+    const auto bottomRight = getBounds().getBottomRight();
+
+    const int width  = isExpanded ? expandedWidth : collapsedWidth;
+    const int height = isExpanded ? collapsedHeight + Spacing::xxs + CallbackProfiler::NUM_STAGES * rowHeight + Spacing::xxs
+                                  : collapsedHeight;
+
+    setBounds (Rectangle<int> (width, height).withBottomY (bottomRight.y).withRightX (bottomRight.x));
+}
+
+Colour CallbackProfilerOverlay::getLoadColour (float load)
+{
+    if (load >= 1.0f)   return Colors::error;
+    if (load >= 0.7f)   return Colors::warning;
+    return Colors::success;
+}
+
+void CallbackProfilerOverlay::paint (Graphics& g)
+{
+    g.setColour (Colors::Dark::surface.withAlpha (0.9f));
+    g.fillRoundedRectangle (getLocalBounds().toFloat(), 4.0f);
+
+    g.setColour (Colors::Dark::border);
+    g.drawRoundedRectangle (getLocalBounds().toFloat().reduced (0.5f), 4.0f, 1.0f);
+
+    auto area = getLocalBounds().reduced (Spacing::xs, 0);
+
+    paintHeader (g, area.removeFromTop (collapsedHeight));
+
+    if (! isExpanded)
+        return;
+
+    area.removeFromTop (Spacing::xxs);
+
+    for (int stage = 0; stage < CallbackProfiler::NUM_STAGES; ++stage)
+        paintStage (g, area.removeFromTop (rowHeight), CallbackProfiler::getStageName (stage),
+                    summary.stageAverageLoad[stage], summary.stagePeakLoad[stage]);
+}
+
+void CallbackProfilerOverlay::paintHeader (Graphics& g, Rectangle<int> area)
+{
+    g.setFont (Typography::caption);
+
+    String load ("DSP ");
+
+    if (summary.numBlocks > 0)
+        load << String (summary.averageLoad * 100.0f, 0) << "% / peak " << String (summary.peakLoad * 100.0f, 0) << "%";
+    else
+        load << "idle";
+
+    g.setColour (summary.numBlocks > 0 ? getLoadColour (summary.peakLoad) : Colors::Dark::textSecondary);
+    g.drawText (load, area, Justification::centredLeft, true);
+
+    g.setColour (summary.numDeadlineMisses > 0 ? Colors::error : Colors::Dark::textSecondary);
+    g.drawText (String (summary.totalDeadlineMisses) + " xruns", area, Justification::centredRight, true);
+}
+
+void CallbackProfilerOverlay::paintStage (Graphics& g, Rectangle<int> area, const String& name, float averageLoad, float peakLoad)
+{
+    g.setFont (Typography::overline);
+    g.setColour (Colors::Dark::textSecondary);
+    g.drawText (name, area.removeFromLeft (100), Justification::centredLeft, true);
+
+    g.drawText (String (averageLoad * 100.0f, 1) + "%", area.removeFromRight (44), Justification::centredRight, true);
+
+    auto bar = area.reduced (Spacing::xxs, 4).toFloat();
+
+    g.setColour (Colors::Dark::background);
+    g.fillRect (bar);
+
+    // full scale is the whole block, so peaks past it are pinned to the end
+    g.setColour (getLoadColour (averageLoad));
+    g.fillRect (bar.withWidth (bar.getWidth() * jlimit (0.0f, 1.0f, averageLoad)));
+
+    const float peakX = bar.getX() + bar.getWidth() * jlimit (0.0f, 1.0f, peakLoad);
+
+    g.setColour (getLoadColour (peakLoad));
+    g.drawVerticalLine (roundToInt (peakX), bar.getY() - 2.0f, bar.getBottom() + 2.0f);
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    CallbackProfilerOverlay.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "CallbackProfiler.h"
+
+//=============================================================
+// Callback Profiler Overlay
+//=============================================================
+// Audio CPU readout that floats over the main view. Collapsed it shows the callback load
+// and the deadline misses so far; clicking it opens the per-stage breakdown of the last
+// second, average as a bar and peak as a tick, with the budget of one block as full scale.
+// It keeps its bottom right corner where it was placed when it opens and closes.
+class CallbackProfilerOverlay : public Component, private Timer
+{
+public:
+    explicit CallbackProfilerOverlay (CallbackProfiler& profilerToShow);
+    ~CallbackProfilerOverlay() override;
+
+    void paint (Graphics& g) override;
+    void mouseUp (const MouseEvent& e) override;
+
+    // the collapsed size, for placing it
+    static constexpr int collapsedWidth     = 190;
+    static constexpr int collapsedHeight    = 20;
+
+private:
+    void timerCallback() override;
+    void setExpanded (bool shouldBeExpanded);
+
+    void paintHeader (Graphics& g, Rectangle<int> area);
+    void paintStage (Graphics& g, Rectangle<int> area, const String& name, float averageLoad, float peakLoad);
+
+    static Colour getLoadColour (float load);
+
+    static constexpr int expandedWidth      = 300;
+    static constexpr int rowHeight          = 16;
+
+    CallbackProfiler& profiler;
+    CallbackProfiler::Summary summary;
+    bool isExpanded = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackProfilerOverlay)
+};
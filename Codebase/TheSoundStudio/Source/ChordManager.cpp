@@ -66,7 +66,7 @@ void ChordManager::calculateKeysInChord()
     // called after any changes in the Chord Player settings
     chordIsReady = false;
     
-    midiKeysInChord.clear();
+    midiKeysInChord.clearQuick();     // keeps its storage, chords are recalculated on the audio thread
     numNotesInChord =  midiKeysInChord.size();
     
     if (isCustomChord)
@@ -38,6 +38,7 @@ public:
     Array<double> getFrequenciesForChord();
     int getMIDINoteFor(KEYNOTES noteRef, int octave);
     Array<int> getMIDIKeysForChord();
+    const Array<int>& getMIDIKeysInChord() const noexcept { return midiKeysInChord; }     // no copy, for the audio thread
     int getNumNotesInSelectedChord();
     
     void getKeynoteOctaveForLowestFrequency(float frequencyFrom, int &keynoteFrom, int &octaveFrom, int &midiNoteFromRef)
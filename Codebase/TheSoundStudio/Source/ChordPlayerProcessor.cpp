@@ -15,6 +15,9 @@
 #include "ProjectManager.h"
 
 ChordPlayerProcessor::ChordPlayerProcessor(FrequencyManager * fm, SynthesisLibraryManager * slm, SynthesisEngine * se, ProjectManager * pm)
+    : enginePool([this] { return createShortcutEngine(); },
+                 [this] (int synthRef, ShortcutEngine& engine) { shortcutEngineAttached(synthRef, engine); },
+                 [this] (int synthRef, ShortcutEngine& engine) { shortcutEngineDetached(synthRef, engine); })
 {
     projectManager          = pm;
     frequencyManager        = fm;
@@ -23,19 +26,6 @@ ChordPlayerProcessor::ChordPlayerProcessor(FrequencyManager * fm, SynthesisLibra
     
     for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]            = new ChordSynthProcessor(44100, frequencyManager);
-        synth[i]            ->setNoteStealingEnabled(true);
-        
-        sampler[i]          = new SamplerProcessor(frequencyManager, sampleLibraryManager, 44100, i);
-        sampler[i]          ->setNoteStealingEnabled(true);
-        
-        wavetableSynth[i]   = new WavetableSynthProcessor(44100, frequencyManager);
-        wavetableSynth[i]   ->setNoteStealingEnabled(true);
-        
-        synth[i]            ->setCurrentPlaybackSampleRate(44100);
-        sampler[i]          ->setCurrentPlaybackSampleRate(44100);
-        wavetableSynth[i]   ->setCurrentPlaybackSampleRate(44100);
-        
         chordManager[i]     = new ChordManager(frequencyManager);
         shouldMute[i]       = false;
         waveformType[i]     = SAMPLER; // Keep original - will redirect SAMPLER to use synthesis
@@ -56,27 +46,11 @@ ChordPlayerProcessor::ChordPlayerProcessor(FrequencyManager * fm, SynthesisLibra
 
 ChordPlayerProcessor::~ChordPlayerProcessor()
 {
+    renderPool.stop(1000);
+    
     // Properly clean up allocated resources
     for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        if (synth[i])
-        {
-            delete synth[i];
-            synth[i] = nullptr;
-        }
-        
-        if (sampler[i])
-        {
-            delete sampler[i];
-            sampler[i] = nullptr;
-        }
-        
-        if (wavetableSynth[i])
-        {
-            delete wavetableSynth[i];
-            wavetableSynth[i] = nullptr;
-        }
-        
         if (chordManager[i])
         {
             delete chordManager[i];
@@ -93,36 +67,162 @@ ChordPlayerProcessor::~ChordPlayerProcessor()
 
 void ChordPlayerProcessor::prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock)
 {
-    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]            ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
-        sampler[i]          ->setCurrentPlaybackSampleRate(sampleRate);
-        wavetableSynth[i]   ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
+        const ScopedLock sl (enginePool.getLock());
+        
+        hostSampleRate  = sampleRate;
+        hostBlockSize   = maximumExpectedSamplesPerBlock;
+        
+        enginePool.forEachEngine([this] (ShortcutEngine& engine) { prepareShortcutEngine(engine); });
     }
     
-    outputBuffer.clear();
-    
-    outputBuffer.setSize(1, maximumExpectedSamplesPerBlock);
+    renderPool.start();
     
     repeater->prepareToPlay(sampleRate);
 }
 
-void ChordPlayerProcessor::setParameter(int synthRef, int index, var newValue)
+//=============================================================
+// Shortcut Engines
+//=============================================================
+ChordPlayerProcessor::ShortcutEngine::ShortcutEngine(FrequencyManager * fm, SynthesisLibraryManager * slm)
+    : synth(44100, fm),
+      sampler(fm, slm, 44100, -1),
+      wavetableSynth(44100, fm)
+{
+    synth           .setNoteStealingEnabled(true);
+    sampler         .setNoteStealingEnabled(true);
+    wavetableSynth  .setNoteStealingEnabled(true);
+    
+    synth           .setCurrentPlaybackSampleRate(44100);
+    sampler         .setCurrentPlaybackSampleRate(44100);
+    wavetableSynth  .setCurrentPlaybackSampleRate(44100);
+}
+
+// called with the pool's lock held
+std::unique_ptr<ChordPlayerProcessor::ShortcutEngine> ChordPlayerProcessor::createShortcutEngine()
+{
+    auto engine = std::make_unique<ShortcutEngine>(frequencyManager, sampleLibraryManager);
+    
+    prepareShortcutEngine(*engine);
+    
+    return engine;
+}
+
+void ChordPlayerProcessor::prepareShortcutEngine(ShortcutEngine& engine)
+{
+    engine.synth            .setOversamplingFactor(oversamplingFactor);
+    engine.wavetableSynth   .setOversamplingFactor(oversamplingFactor);
+    engine.oversampler      .setFactor(oversamplingFactor);
+    
+    if (hostBlockSize > 0)
+    {
+        engine.synth            .prepareToPlay(hostSampleRate, hostBlockSize);
+        engine.sampler          .setCurrentPlaybackSampleRate(hostSampleRate);
+        engine.wavetableSynth   .prepareToPlay(hostSampleRate, hostBlockSize);
+        engine.oversampler      .prepare(hostBlockSize);
+        
+        engine.buffer.setSize(1, hostBlockSize);
+        engine.buffer.clear();
+    }
+}
+
+void ChordPlayerProcessor::shortcutEngineAttached(int synthRef, ShortcutEngine& engine)
+{
+    // engines come back once their tail is silent, unless it was cut short
+    engine.synth            .allNotesOff(0, false);
+    engine.sampler          .allNotesOff(0, false);
+    engine.wavetableSynth   .allNotesOff(0, false);
+    engine.oversampler      .reset();
+    
+    for (int i = 0; i < numEngineParameters; i++)
+    {
+        if (!engineParameters[synthRef][i].isVoid())
+            applyEngineParameter(engine, firstEngineParameter + i, engineParameters[synthRef][i]);
+    }
+}
+
+void ChordPlayerProcessor::shortcutEngineDetached(int synthRef, ShortcutEngine& engine)
+{
+    // the notes release into a tail, rendered until it is silent
+    engine.synth            .allNotesOff(0, true);
+    engine.sampler          .allNotesOff(0, true);
+    engine.wavetableSynth   .allNotesOff(0, true);
+    
+    tailSamplesLeft[synthRef] = (int)(hostSampleRate * maxTailSeconds);
+}
+
+bool ChordPlayerProcessor::isTailSilent(const ShortcutEngine& engine)
+{
+    return !ShortcutEnginePool<ShortcutEngine>::hasActiveVoices(engine.synth)
+        && !ShortcutEnginePool<ShortcutEngine>::hasActiveVoices(engine.sampler)
+        && !ShortcutEnginePool<ShortcutEngine>::hasActiveVoices(engine.wavetableSynth);
+}
+
+void ChordPlayerProcessor::applyEngineParameter(ShortcutEngine& engine, int index, const var& newValue)
 {
     if (index >= INSTRUMENT_TYPE && index <= ENV_RELEASE)
     {
-        synth[synthRef]         ->setParameter(index, newValue);
-        sampler[synthRef]       ->setParameter(index, newValue);
-        wavetableSynth[synthRef]->setParameter(index, newValue);
+        engine.synth            .setParameter(index, newValue);
+        engine.sampler          .setParameter(index, newValue);
+        engine.wavetableSynth   .setParameter(index, newValue);
     }
     else if (index == WAVEFORM_TYPE)
     {
-        panic();
+        engine.synth.setParameter(index, newValue);
+    }
+}
+
+void ChordPlayerProcessor::setShortcutInUse(int synthRef, bool inUse)
+{
+    if (inUse)
+    {
+        enginePool.acquire(synthRef);
+    }
+    else if (auto * engine = enginePool.getEngine(synthRef))
+    {
+        // the wavetable lives in the engine
+        if (!engine->hasEditedWavetable)
+            enginePool.release(synthRef);
+    }
+}
+
+double * ChordPlayerProcessor::getWavetableBuffer(int synthRef)
+{
+    return enginePool.acquire(synthRef)->wavetableSynth.getBaseWavetableBuffer();
+}
+
+void ChordPlayerProcessor::setWavetableBuffer(int synthRef, double * tableArray)
+{
+    auto * engine = enginePool.acquire(synthRef);
+    
+    engine->wavetableSynth.setWavetableBuffer(tableArray);
+    engine->hasEditedWavetable = true;
+}
+
+void ChordPlayerProcessor::initBaseWaveType(int synthRef, int newType)
+{
+    auto * engine = enginePool.acquire(synthRef);
+    
+    // engines are created with the first type
+    engine->wavetableSynth.initBaseWaveType(newType);
+    engine->hasEditedWavetable = newType != 0;
+}
+
+void ChordPlayerProcessor::setParameter(int synthRef, int index, var newValue)
+{
+    if (index >= firstEngineParameter && index < firstEngineParameter + numEngineParameters)
+    {
+        if (index == WAVEFORM_TYPE)
+        {
+            panic();
+            
+            waveformType[synthRef] = (WAVEFORM_TYPES)newValue.operator int();
+        }
         
-        waveformType[synthRef] = (WAVEFORM_TYPES)newValue.operator int();
+        engineParameters[synthRef][index - firstEngineParameter] = newValue;
         
-        synth[synthRef]->setParameter(index, newValue);
-//        sampler[synthRef]->setParameter(index, newValue);
+        if (auto * engine = enginePool.get(synthRef))
+            applyEngineParameter(*engine, index, newValue);
     }
     
     else if (index == CHORD_SOURCE)
@@ -250,12 +350,18 @@ void ChordPlayerProcessor::setParameter(int synthRef, int index, var newValue)
 
 void ChordPlayerProcessor::setOversamplingFactor(int newFactor)
 {
-    // ** NOT WORKING YET
+    if (!ShortcutOversampler::isValidFactor(newFactor) || newFactor == oversamplingFactor)
+        return;
+    
+    // processBlock() skips blocks while suspended, so the synths and buffers can be rebuilt here
     suspendProcessing(true);
     
-    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-//        synth[i]->setOversamplingFactor(newFactor);
+        const ScopedLock sl (enginePool.getLock());
+        
+        oversamplingFactor = newFactor;
+        
+        enginePool.forEachEngine([this] (ShortcutEngine& engine) { prepareShortcutEngine(engine); });
     }
     
     suspendProcessing(false);
@@ -264,69 +370,144 @@ void ChordPlayerProcessor::setOversamplingFactor(int newFactor)
 void ChordPlayerProcessor::processBlock (AudioBuffer<float>& buffer,
                            MidiBuffer& midiMessages)
 {
+    const ScopedTryLock stl (getCallbackLock());
     
+    if (!stl.isLocked() || isSuspended())
+        return;
     
+    enginePool.update();
     
-    if (playState == PLAY_STATE::PLAYING)
+    // run the repeater and render the shortcuts in the segments between its events,
+    // so every repeat starts and stops on the sample it was scheduled for
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &buffer, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        renderActiveShortcuts(buffer, midiMessages, startSample, numSamples);
+                                    });
+}
+
+void ChordPlayerProcessor::renderActiveShortcuts(AudioBuffer<float>& buffer, MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    struct RenderJob
     {
-        repeater->tickBuffer(buffer.getNumSamples());
-    }
+        int                 shortcut;
+        ShortcutEngine *    engine;
+        bool                isTail;
+    };
+    
+    RenderJob jobs[2 * NUM_SHORTCUT_SYNTHS];
+    int numJobs = 0;
     
     for (int s = 0; s < NUM_SHORTCUT_SYNTHS; s++)
     {
-        if (isActive[s] && !shouldMute[s])
+        const bool isAudible = !shouldMute[s] && output[s] != AUDIO_OUTPUTS::NO_OUTPUT;
+        
+        if (isActive[s] && isAudible)
+        {
+            if (auto * engine = enginePool.get(s))
+                jobs[numJobs++] = { s, engine, false };
+        }
+        
+        // a tail keeps playing after its shortcut is switched off, unless nobody would hear it
+        if (auto * tail = enginePool.getTail(s))
+        {
+            if (isAudible)
+                jobs[numJobs++] = { s, tail, true };
+            else
+                enginePool.finishTail(s);
+        }
+    }
+    
+    // every shortcut renders into its own scratch buffer, so they can run on any core..
+    auto renderJob = [&] (int jobIndex)
+    {
+        const auto& job = jobs[jobIndex];
+        
+        // a tail only plays out the notes it has, new ones go to the shortcut's own engine
+        renderShortcut(job.shortcut, *job.engine, job.isTail ? tailMidi : midiMessages, startSample, numSamples);
+    };
+    
+    renderPool.parallelFor(numJobs, renderJob);
+    
+    // ..and are summed in shortcut order, so the mix is identical however the jobs were scheduled
+    for (int i = 0; i < numJobs; i++)
+    {
+        const auto& job = jobs[i];
+        
+        mixShortcut(job.shortcut, *job.engine, buffer, startSample, numSamples);
+        
+        if (job.isTail)
         {
-            outputBuffer.clear();
+            tailSamplesLeft[job.shortcut] -= numSamples;
             
-            if (output[s] != AUDIO_OUTPUTS::NO_OUTPUT)
-            {
-                // Use per-voice processors for continuity and realism
-                if (waveformType[s] == SAMPLER)
-                {
-                    wavetableSynth[s]->processBlock(outputBuffer, midiMessages);
-                }
-                else if (waveformType[s] == WAVETABLE)
-                {
-                    wavetableSynth[s]->processBlock(outputBuffer, midiMessages);
-                }
-                else
-                {
-                    synth[s]->processBlock(outputBuffer, midiMessages);
-                }
-                
-                if      (output[s] == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_4 && buffer.getNumChannels() > 3) { buffer.addFrom(3, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_1_2 && buffer.getNumChannels() > 1)
-                {
-                    buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_3_4 && buffer.getNumChannels() > 2)
-                {
-                    buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(3, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_5 && buffer.getNumChannels() > 4) { buffer.addFrom(4, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_6 && buffer.getNumChannels() > 5) { buffer.addFrom(5, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_7 && buffer.getNumChannels() > 6) { buffer.addFrom(6, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_8 && buffer.getNumChannels() > 7) { buffer.addFrom(7, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_5_6 && buffer.getNumChannels() > 5)
-                {
-                    buffer.addFrom(4, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(5, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_7_8 && buffer.getNumChannels() > 7)
-                {
-                    buffer.addFrom(6, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(7, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-            }
+            if (isTailSilent(*job.engine) || tailSamplesLeft[job.shortcut] <= 0)
+                enginePool.finishTail(job.shortcut);
         }
     }
 }
 
+void ChordPlayerProcessor::renderShortcut(int s, ShortcutEngine& engine, MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    engine.buffer.clear(startSample, numSamples);
+    
+    // voices render at the oversampled rate, the shortcut is decimated once afterwards
+    engine.oversampler.process(engine.buffer, startSample, numSamples,
+                               [this, s, &engine, &midiMessages] (AudioBuffer<float>& renderBuffer, int renderStart, int numRenderSamples)
+                               {
+                                   // Use per-voice processors for continuity and realism
+                                   if (waveformType[s] == SAMPLER)
+                                   {
+                                       engine.wavetableSynth.renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                                   }
+                                   else if (waveformType[s] == WAVETABLE)
+                                   {
+                                       engine.wavetableSynth.renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                                   }
+                                   else
+                                   {
+                                       engine.synth.renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                                   }
+                               });
+}
+
+void ChordPlayerProcessor::mixShortcut(int s, const ShortcutEngine& engine, AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const auto& shortcutBuffer = engine.buffer;
+    
+    if      (output[s] == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_4 && buffer.getNumChannels() > 3) { buffer.addFrom(3, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::STEREO_1_2 && buffer.getNumChannels() > 1)
+    {
+        buffer.addFrom(0, startSample, shortcutBuffer, 0, startSample, numSamples);
+        buffer.addFrom(1, startSample, shortcutBuffer, 0, startSample, numSamples);
+    }
+    else if (output[s] == AUDIO_OUTPUTS::STEREO_3_4 && buffer.getNumChannels() > 2)
+    {
+        buffer.addFrom(2, startSample, shortcutBuffer, 0, startSample, numSamples);
+        buffer.addFrom(3, startSample, shortcutBuffer, 0, startSample, numSamples);
+    }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_5 && buffer.getNumChannels() > 4) { buffer.addFrom(4, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_6 && buffer.getNumChannels() > 5) { buffer.addFrom(5, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_7 && buffer.getNumChannels() > 6) { buffer.addFrom(6, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::MONO_8 && buffer.getNumChannels() > 7) { buffer.addFrom(7, startSample, shortcutBuffer, 0, startSample, numSamples); }
+    else if (output[s] == AUDIO_OUTPUTS::STEREO_5_6 && buffer.getNumChannels() > 5)
+    {
+        buffer.addFrom(4, startSample, shortcutBuffer, 0, startSample, numSamples);
+        buffer.addFrom(5, startSample, shortcutBuffer, 0, startSample, numSamples);
+    }
+    else if (output[s] == AUDIO_OUTPUTS::STEREO_7_8 && buffer.getNumChannels() > 7)
+    {
+        buffer.addFrom(6, startSample, shortcutBuffer, 0, startSample, numSamples);
+        buffer.addFrom(7, startSample, shortcutBuffer, 0, startSample, numSamples);
+    }
+}
+
 // trigger commands
 // temp functions, called when shortcut keys are pressed
 // can be evolved to trigger the repeater later, or called by by repeater
@@ -343,15 +524,17 @@ void ChordPlayerProcessor::triggerKeyUp(int shortcutRef)
 void ChordPlayerProcessor::triggerNoteOn(int shortcutRef)
 {
     // get chord notes from parameters
-    Array<int>notes(chordManager[shortcutRef]->getMIDIKeysForChord());
+    const Array<int>& notes = chordManager[shortcutRef]->getMIDIKeysInChord();
+    
+    auto * engine = enginePool.get(shortcutRef);
 
-    Array<String> noteStrings;
-    Array<float> noteFreqs;
+    // filled in place, so nothing is allocated on the audio thread
+    ProjectManager::LogFileWriter::SequencerEvent loggedChord;
     
     for (int i = 0; i < notes.size(); i++)
     {
         int midiNote = notes.getReference(i);
-        String noteString = ProjectStrings::getKeynoteArray().getReference(midiNote % 12);
+        int noteOctave = 0;
         
         if (midiNote >= 0 && midiNote <= 127)
         {
@@ -363,11 +546,11 @@ void ChordPlayerProcessor::triggerNoteOn(int shortcutRef)
             if (!hasCustomChord[shortcutRef])
             {
                 octShift = octaveShift[shortcutRef];
-                noteString.append(String{(int)projectManager->getChordPlayerParameter(i, OCTAVE)}, 2);
+                noteOctave = octaveShift[shortcutRef] - 1;     // the shortcut's OCTAVE parameter
             }
             else
             {
-                noteString.append(String{std::floor(midiNote / 12.0) - 1}, 2);
+                noteOctave = (int)std::floor(midiNote / 12.0) - 1;
             }
 
             if (manipulateChoseFrequency[shortcutRef])
@@ -387,23 +570,28 @@ void ChordPlayerProcessor::triggerNoteOn(int shortcutRef)
                 freq = baseFreq * pow(2.0, octShift);
             }
 
-            noteStrings.add(noteString);
-            noteFreqs.add(freq);
+            if (loggedChord.numNotes < ProjectManager::LogFileWriter::SequencerEvent::maxNotes)
+            {
+                loggedChord.notes[loggedChord.numNotes]         = midiNote;
+                loggedChord.noteOctaves[loggedChord.numNotes]   = noteOctave;
+                loggedChord.noteFreqs[loggedChord.numNotes]     = (float)freq;
+                loggedChord.numNotes++;
+            }
 
-            if (freq) // check freq does not = 0hz
+            if (freq && engine != nullptr) // check freq does not = 0hz
             {
                 if (waveformType[shortcutRef] == SAMPLER)
                 {
                     // Use synthesis instead of samples for playing instruments
-                    wavetableSynth[shortcutRef]->noteOn(0, midiNote, freq);
+                    engine->wavetableSynth.noteOn(0, midiNote, freq);
                 }
                 else if (waveformType[shortcutRef] == WAVETABLE)
                 {
-                    wavetableSynth[shortcutRef]->noteOn(0, midiNote, freq);
+                    engine->wavetableSynth.noteOn(0, midiNote, freq);
                 }
                 else
                 {
-                    synth[shortcutRef]->noteOn(0, midiNote, freq);
+                    engine->synth.noteOn(0, midiNote, freq);
                 }
             }
         }
@@ -415,12 +603,17 @@ void ChordPlayerProcessor::triggerNoteOn(int shortcutRef)
     // but really need not to offer the chord to the user
 
     if (notes.size() > 0)
-        projectManager->logFileWriter->processLog_ChordPlayer_Sequencer(shortcutRef, noteStrings, noteFreqs);
+        projectManager->logFileWriter->processLog_ChordPlayer_Sequencer(shortcutRef, loggedChord);
 
 }
 
 void ChordPlayerProcessor::triggerNoteOff(int shortcutRef)
 {
+    auto * engine = enginePool.get(shortcutRef);
+    
+    if (engine == nullptr)
+        return;
+    
     Array<int> notes = chordManager[shortcutRef]->getMIDIKeysForChord();
     
     for (int i = 0; i < notes.size(); i++)
@@ -432,15 +625,15 @@ void ChordPlayerProcessor::triggerNoteOff(int shortcutRef)
             if (waveformType[shortcutRef] == SAMPLER)
             {
                 // Use synthesis instead of samples for playing instruments
-                wavetableSynth[shortcutRef]->noteOff(0, midiNote, 1.0, true);
+                engine->wavetableSynth.noteOff(0, midiNote, 1.0, true);
             }
             else if (waveformType[shortcutRef] == WAVETABLE)
             {
-                wavetableSynth[shortcutRef]->noteOff(0, midiNote, 1.0, true);
+                engine->wavetableSynth.noteOff(0, midiNote, 1.0, true);
             }
             else
             {
-                synth[shortcutRef]->noteOff(0, midiNote, 1.0, true);
+                engine->synth.noteOff(0, midiNote, 1.0, true);
             }
         }
     }
@@ -450,9 +643,12 @@ void ChordPlayerProcessor::panic()
 {
     for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]    ->allNotesOff(0, true);
-        sampler[i]  ->allNotesOff(0, true);
-        wavetableSynth[i]->allNotesOff(0, true);
+        if (auto * engine = enginePool.get(i))
+        {
+            engine->synth           .allNotesOff(0, true);
+            engine->sampler         .allNotesOff(0, true);
+            engine->wavetableSynth  .allNotesOff(0, true);
+        }
     }
 }
 
@@ -816,44 +1012,60 @@ void ChordPlayerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void ChordPlayerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int ChordPlayerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    if (playSimultaneous)
+    {
+        processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
+    }
+    else
     {
-        for (int i = 0; i < numSamples; i++)
+        // just sequence through active shortcuts
+        if (isActive[currentPlayingShortcut])
         {
-            processSecondsClock();
-            
-            if (playSimultaneous)
-            {
-                processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
-            }
-            else
-            {
-                // just sequence through active shortcuts
-                if (isActive[currentPlayingShortcut])
-                {
-                    processShortcut(currentPlayingShortcut, sampleCounter);
-                }
-            }
-            
-            sampleCounter++;
+            processShortcut(currentPlayingShortcut, sampleCounter);
+        }
+    }
+    
+    // only the shortcuts the tick above would look at can produce the next event
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
+    {
+        const bool isWatched = playSimultaneous ? isActive[i] : (i == currentPlayingShortcut && isActive[i]);
+        
+        if (isWatched)
+        {
+            RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent[i]);
+            RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent[i]);
+        }
+    }
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop))
+        {
+            currentMS = totalMSOfLoop;
             
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop))
-                {
-                    currentMS = totalMSOfLoop;
-                    
-                    stop();
-                }
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
-            }
+            stop();
         }
     }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
+    }
+    
+    return numSamples;
 }
 
 void ChordPlayerProcessor::PlayRepeater::processShortcut(int shortcutRef, int sampleRef)
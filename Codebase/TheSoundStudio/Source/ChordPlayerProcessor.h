@@ -18,6 +18,10 @@
 #include "SynthesisLibraryManager.h"
 #include "SynthesisEngine.h"
 #include "WavetableSynthProcessor.h"
+#include "RepeaterScheduler.h"
+#include "RealtimeRenderPool.h"
+#include "ShortcutOversampler.h"
+#include "ShortcutEnginePool.h"
 
 class ProjectManager;
 
@@ -63,9 +67,14 @@ public:
     void setPlayerCommand(PLAYER_COMMANDS command);
     void setPlayerPlayMode(PLAY_MODE mode);
     
-    ChordSynthProcessor *   synth[NUM_SHORTCUT_SYNTHS];
-    SamplerProcessor *      sampler[NUM_SHORTCUT_SYNTHS];
-    WavetableSynthProcessor * wavetableSynth[NUM_SHORTCUT_SYNTHS];
+    // Message thread. A shortcut in use gets an engine to play with, see ShortcutEnginePool
+    void setShortcutInUse(int synthRef, bool inUse);
+    
+    // Message thread, for the wavetable editor. Gives the shortcut an engine if it has none,
+    // and a shortcut keeps its engine once its wavetable has been edited
+    double * getWavetableBuffer(int synthRef);
+    void setWavetableBuffer(int synthRef, double * tableArray);
+    void initBaseWaveType(int synthRef, int newType);
     
     ChordManager *          chordManager[NUM_SHORTCUT_SYNTHS];
     
@@ -78,6 +87,48 @@ public:
     PLAY_STATE getPlaystate() { return playState; }
     
 private:
+    //=============================================================
+    // Shortcut Engine
+    //=============================================================
+    struct ShortcutEngine
+    {
+        ShortcutEngine(FrequencyManager * fm, SynthesisLibraryManager * slm);
+        
+        ChordSynthProcessor     synth;
+        SamplerProcessor        sampler;
+        WavetableSynthProcessor wavetableSynth;
+        
+        ShortcutOversampler     oversampler;
+        AudioBuffer<float>      buffer;                         // scratch, written by the render pool
+        
+        bool                    hasEditedWavetable = false;     // message thread
+    };
+    
+    std::unique_ptr<ShortcutEngine> createShortcutEngine();
+    void prepareShortcutEngine(ShortcutEngine& engine);
+    void shortcutEngineAttached(int synthRef, ShortcutEngine& engine);
+    void shortcutEngineDetached(int synthRef, ShortcutEngine& engine);
+    static bool isTailSilent(const ShortcutEngine& engine);
+    void applyEngineParameter(ShortcutEngine& engine, int index, const var& newValue);
+    
+    static constexpr int firstEngineParameter   = WAVEFORM_TYPE;
+    static constexpr int numEngineParameters    = ENV_RELEASE - WAVEFORM_TYPE + 1;
+    
+    // the last value of each engine parameter, void until set, replayed into an engine
+    // when a shortcut gets one. Audio thread
+    var engineParameters[NUM_SHORTCUT_SYNTHS][numEngineParameters];
+    
+    ShortcutEnginePool<ShortcutEngine> enginePool;
+    
+    // a tail longer than this is cut, so a stuck voice can't hold its engine forever
+    static constexpr double maxTailSeconds = 10.0;
+    int         tailSamplesLeft[NUM_SHORTCUT_SYNTHS] {};    // audio thread
+    MidiBuffer  tailMidi;                                   // always empty
+    
+    void renderActiveShortcuts(AudioBuffer<float>& buffer, MidiBuffer& midiMessages, int startSample, int numSamples);
+    void renderShortcut(int s, ShortcutEngine& engine, MidiBuffer& midiMessages, int startSample, int numSamples);
+    void mixShortcut(int s, const ShortcutEngine& engine, AudioBuffer<float>& buffer, int startSample, int numSamples);
+    
     bool samplerOrSynth; // switched between processing of Sampler of Synth
     
     bool chordSource[NUM_SHORTCUT_SYNTHS];
@@ -103,7 +154,11 @@ private:
     
     AUDIO_OUTPUTS output[NUM_SHORTCUT_SYNTHS];
     
-    AudioBuffer<float> outputBuffer;
+    RealtimeRenderPool renderPool;
+    
+    int    oversamplingFactor   = 1;
+    double hostSampleRate       = 44100;
+    int    hostBlockSize        = 0;
     
     //=============================================================
     // Play Repeater
@@ -116,7 +171,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
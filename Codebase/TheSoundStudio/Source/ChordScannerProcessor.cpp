@@ -32,6 +32,7 @@ ChordScannerProcessor::ChordScannerProcessor(FrequencyManager * fm, SynthesisLib
     chordManager    = new ChordManager(frequencyManager);
         
     shouldMute      = false;
+    playState       = PLAY_STATE::OFF;
     waveformType    = SAMPLER; // Keep original - will redirect SAMPLER to use synthesis
     
     repeater        = new PlayRepeater(this, 44100);
@@ -73,13 +74,17 @@ ChordScannerProcessor::~ChordScannerProcessor()
 
 void ChordScannerProcessor::prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock)
 {
+    hostSampleRate  = sampleRate;
+    hostBlockSize   = maximumExpectedSamplesPerBlock;
 
-    synth       ->setCurrentPlaybackSampleRate(sampleRate);
+    synth       ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
     sampler     ->setCurrentPlaybackSampleRate(sampleRate);
     wavetableSynth   ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
     
     repeater    ->prepareToPlay(sampleRate);
     
+    oversampler.prepare(maximumExpectedSamplesPerBlock);
+    
     outputBuffer.clear();
     
     outputBuffer.setSize(1, maximumExpectedSamplesPerBlock);
@@ -195,13 +200,21 @@ void ChordScannerProcessor::setParameter(int index, var newValue)
 
 void ChordScannerProcessor::setOversamplingFactor(int newFactor)
 {
-    // ** NOT WORKING YET
+    if (!ShortcutOversampler::isValidFactor(newFactor) || newFactor == oversamplingFactor)
+        return;
+    
     suspendProcessing(true);
     
-    for (int i = 0; i < 1; i++)
+    oversamplingFactor = newFactor;
+    
+    synth           ->setOversamplingFactor(newFactor);
+    wavetableSynth  ->setOversamplingFactor(newFactor);
+    oversampler.setFactor(newFactor);
+    
+    if (hostBlockSize > 0)
     {
-//        synth->setOversamplingFactor(newFactor);
-        
+        synth           ->prepareToPlay(hostSampleRate, hostBlockSize);
+        wavetableSynth  ->prepareToPlay(hostSampleRate, hostBlockSize);
     }
     
     suspendProcessing(false);
@@ -210,33 +223,28 @@ void ChordScannerProcessor::setOversamplingFactor(int newFactor)
 void ChordScannerProcessor::processBlock (AudioBuffer<float>& buffer,
                                          MidiBuffer& midiMessages)
 {
+    const ScopedTryLock stl (getCallbackLock());
     
+    if (!stl.isLocked() || isSuspended())
+        return;
     
-    // process repeater first
-    if (playState == PLAY_STATE::PLAYING)
-    {
-        // run repeater looper..
-        repeater->tickBuffer(buffer.getNumSamples());
-    }
+    if (output != AUDIO_OUTPUTS::NO_OUTPUT)
+        outputBuffer.clear();
+    
+    // run the repeater and render the synth in the segments between its events,
+    // so every chord starts and stops on the sample it was scheduled for
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        renderSynth(midiMessages, startSample, numSamples);
+                                    });
     
     if (output != AUDIO_OUTPUTS::NO_OUTPUT)
     {
-        outputBuffer.clear();
-        
-        if (waveformType == SAMPLER)
-        {
-            // FIXED: Redirect playing instruments to use synthesis instead of samples
-            wavetableSynth->processBlock(outputBuffer, midiMessages);
-        }
-        else if (waveformType == WAVETABLE)
-        {
-            wavetableSynth->processBlock(outputBuffer, midiMessages);
-        }
-        else
-        {
-            synth->processBlock(outputBuffer, midiMessages);
-        }
-        
         if      (output == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
         else if (output == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
         else if (output == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
@@ -270,6 +278,30 @@ void ChordScannerProcessor::processBlock (AudioBuffer<float>& buffer,
 
 }
 
+void ChordScannerProcessor::renderSynth(MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    if (output == AUDIO_OUTPUTS::NO_OUTPUT)
+        return;
+    
+    oversampler.process(outputBuffer, startSample, numSamples,
+                        [this, &midiMessages] (AudioBuffer<float>& renderBuffer, int renderStart, int numRenderSamples)
+                        {
+                            if (waveformType == SAMPLER)
+                            {
+                                // FIXED: Redirect playing instruments to use synthesis instead of samples
+                                wavetableSynth->renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                            }
+                            else if (waveformType == WAVETABLE)
+                            {
+                                wavetableSynth->renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                            }
+                            else
+                            {
+                                synth->renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                            }
+                        });
+}
+
 // trigger commands
 // temp functions, called when shortcut keys are pressed
 // can be evolved to trigger the repeater later, or called by by repeater
@@ -282,9 +314,10 @@ void ChordScannerProcessor::triggerNoteOn(KEYNOTES keynote, CHORD_TYPES chordTyp
     chordManager->setKeyNote(keynote);
     
     // get chord notes from parameters
-    Array<int> notes(chordManager->getMIDIKeysForChord());
+    const Array<int>& notes = chordManager->getMIDIKeysInChord();
     
-    Array<float> noteFreqs;
+    // filled in place, so nothing is allocated on the audio thread
+    ProjectManager::LogFileWriter::SequencerEvent loggedChord;
     
     for (int i = 0; i < notes.size(); i++)
     {
@@ -295,8 +328,12 @@ void ChordScannerProcessor::triggerNoteOn(KEYNOTES keynote, CHORD_TYPES chordTyp
             double baseFreq = frequencyManager->scalesManager->getFrequencyForMIDINote(midiNote);
             double freq = baseFreq * pow(2.0, octave);
             
-            
-            noteFreqs.add(freq);
+            if (loggedChord.numNotes < ProjectManager::LogFileWriter::SequencerEvent::maxNotes)
+            {
+                loggedChord.notes[loggedChord.numNotes]     = midiNote;
+                loggedChord.noteFreqs[loggedChord.numNotes] = (float)freq;
+                loggedChord.numNotes++;
+            }
 
             if (freq) // check freq does not = 0hz
             {
@@ -317,7 +354,7 @@ void ChordScannerProcessor::triggerNoteOn(KEYNOTES keynote, CHORD_TYPES chordTyp
         }
     }
     
-    projectManager->logFileWriter->processLog_ChordScanner_Sequencer(false, notes, noteFreqs);
+    projectManager->logFileWriter->processLog_ChordScanner_Sequencer(false, loggedChord);
     
 }
 
@@ -846,38 +883,49 @@ void ChordScannerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void ChordScannerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int ChordScannerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    switch (scanMode)
     {
-        for (int i = 0; i < numSamples; i++)
-        {
-            processSecondsClock();
+        case SCAN_MAIN_CHORDS: {    process_MainChords(sampleCounter); }        break;
+        case SCAN_ALL_CHORDS: {     process_AllChords(sampleCounter); }         break;
+        case SCAN_SPECIFIC_RANGE: { process_SpecificRange(sampleCounter); }     break;
+        case SCAN_BY_FREQUENCY: {   process_ByFrequency(sampleCounter); }       break;
             
-            switch (scanMode)
-            {
-                case SCAN_MAIN_CHORDS: {    process_MainChords(sampleCounter); }        break;
-                case SCAN_ALL_CHORDS: {     process_AllChords(sampleCounter); }         break;
-                case SCAN_SPECIFIC_RANGE: { process_SpecificRange(sampleCounter); }     break;
-                case SCAN_BY_FREQUENCY: {   process_ByFrequency(sampleCounter); }       break;
-                    
-                default: break;
-            }
-            
-            sampleCounter++;
-            
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop))
-                    stop();
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop)
-                    resetTick();
-            }
-        }
+        default: break;
     }
+    
+    // the scan finished on this event
+    if (!shouldProcess)
+        return maxSamples;
+    
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent);
+    RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent);
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop))
+            stop();
+    }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop)
+            resetTick();
+    }
+    
+    return numSamples;
 }
 
 void ChordScannerProcessor::PlayRepeater::process_MainChords(int sampleRef)
@@ -971,20 +1019,22 @@ void ChordScannerProcessor::PlayRepeater::process_AllChords(int sampleRef)
     if (sampleRef == nextNoteOnEvent)
     {
         
-        Array<int> notes;
-        Array<float> noteFreqs;
+        // filled in place, so nothing is allocated on the audio thread
+        ProjectManager::LogFileWriter::SequencerEvent loggedChord;
         
         for (int numNotes = 0; numNotes < numNotesIterator; numNotes++)
         {
             proc->triggerNoteOnDirect((KEYNOTES) keynoteIteratorAllChords[numNotes], octaveIterator);
             
-            notes.add(keynoteIteratorAllChords[numNotes]);
-            
             double baseFreq = proc->frequencyManager->scalesManager->getFrequencyForMIDINote(keynoteIteratorAllChords[numNotes]);
             double freq = baseFreq * pow(2.0, octaveIterator);
             
-            
-            noteFreqs.add(freq);
+            if (loggedChord.numNotes < ProjectManager::LogFileWriter::SequencerEvent::maxNotes)
+            {
+                loggedChord.notes[loggedChord.numNotes]     = keynoteIteratorAllChords[numNotes];
+                loggedChord.noteFreqs[loggedChord.numNotes] = (float)freq;
+                loggedChord.numNotes++;
+            }
         }
         
         // get all notes above..
@@ -992,7 +1042,7 @@ void ChordScannerProcessor::PlayRepeater::process_AllChords(int sampleRef)
         // get frequencies..
         
         // call log writer
-        proc->projectManager->logFileWriter->processLog_ChordScanner_Sequencer(true, notes, noteFreqs);
+        proc->projectManager->logFileWriter->processLog_ChordScanner_Sequencer(true, loggedChord);
 
         nextNoteOffEvent = sampleRef + lengthInSamples;
         
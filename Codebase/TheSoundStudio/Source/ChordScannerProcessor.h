@@ -16,6 +16,8 @@
 #include "VotanSynthProcessor.h"
 #include "SamplerProcessor.h"
 #include "WavetableSynthProcessor.h"
+#include "RepeaterScheduler.h"
+#include "ShortcutOversampler.h"
 
 
 // All the mode wrappers
@@ -132,6 +134,13 @@ public:
     AudioBuffer<float> outputBuffer;
     
 private:
+    void renderSynth(MidiBuffer& midiMessages, int startSample, int numSamples);
+    
+    ShortcutOversampler oversampler;
+    int    oversamplingFactor   = 1;
+    double hostSampleRate       = 44100;
+    int    hostBlockSize        = 0;
+    
     bool samplerOrSynth; // switched between processing of Sampler of Synth
     
     FrequencyManager * frequencyManager;
@@ -158,7 +167,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
@@ -216,6 +225,7 @@ public:
         
         int getTotalMSOfLoop();
         int getCurrentMSInLoop();
+        uint64 getTotalNumSamplesOfLoop() const { return totalNumSamplesOfLoop; }
         float getProgressBarValue();
         String getTimeRemainingInSecondsString();
        
@@ -13,6 +13,40 @@
 
 #include "EnhancedLissajousEngine.h"
 
+namespace
+{
+    using Lanes = dsp::SIMDRegister<float>;
+
+    double wrapCycles (double cycles) noexcept
+    {
+        return cycles - std::floor (cycles);
+    }
+
+    Lanes fractionalPart (Lanes x) noexcept
+    {
+        // truncation rounds negative values up, take one off those
+        const Lanes truncated = Lanes::truncate (x);
+        const Lanes floored   = truncated - (Lanes::expand (1.0f) & Lanes::greaterThan (truncated, x));
+
+        return x - floored;
+    }
+
+    // sin (2 pi x), a parabola with one correction step; within 0.001, plenty for drawing
+    Lanes sinCycles (Lanes x) noexcept
+    {
+        const Lanes one = Lanes::expand (1.0f);
+        const Lanes u   = one - fractionalPart (x) * 2.0f;     // sin (2 pi x) = sin (pi u)
+        const Lanes s   = u * 4.0f * (one - Lanes::abs (u));
+
+        return s + (s * Lanes::abs (s) - s) * 0.225f;
+    }
+
+    Lanes modulationCycles (float rate, double batchStart, Lanes pointOffsets) noexcept
+    {
+        return Lanes::expand ((float) wrapCycles (rate * batchStart)) + pointOffsets * rate;
+    }
+}
+
 //==============================================================================
 EnhancedLissajousEngine::EnhancedLissajousEngine()
 {
@@ -29,6 +63,13 @@ EnhancedLissajousEngine::EnhancedLissajousEngine()
     {
         axes[i].phase = i * MathConstants<float>::pi / 4.0f; // Staggered phases
     }
+    
+    // everything the curves need, so generating them never allocates
+    ring = std::make_unique<CurveRing>();
+    
+    curve3D.reserve(MAX_CURVE_POINTS);
+    curveND.reserve(MAX_CURVE_POINTS);
+    velocities.reserve(MAX_CURVE_POINTS);
 }
 
 EnhancedLissajousEngine::~EnhancedLissajousEngine()
@@ -44,10 +85,6 @@ void EnhancedLissajousEngine::initialize(double newSampleRate, int updateRate)
     sampleRate = newSampleRate;
     updateRateHz = updateRate;
     
-    // Reserve memory for curve data
-    curve3D.reserve(MAX_CURVE_POINTS);
-    curveND.reserve(MAX_CURVE_POINTS);
-    
     generateCurve();
     
     // Start animation timer if needed
@@ -79,6 +116,7 @@ void EnhancedLissajousEngine::setNumberOfAxes(int numAxes)
 LissajousAxis& EnhancedLissajousEngine::getAxis(int axisIndex)
 {
     jassert(axisIndex >= 0 && axisIndex < MAX_LISSAJOUS_AXES);
+    needsRecalculation = true;
     return axes[axisIndex];
 }
 
@@ -344,114 +382,148 @@ EnhancedLissajousEngine::CurveAnalysis EnhancedLissajousEngine::analyzeCurve() c
 //==============================================================================
 // Internal Processing
 
-void EnhancedLissajousEngine::generateCurve()
+bool EnhancedLissajousEngine::generateCurve()
 {
     std::lock_guard<std::mutex> lock(curveMutex);
     
-    switch (curveMode)
+    // the window starts on a whole point, so the points kept stay on the same time grid
+    const double step = (double) timeSpan / curveResolution;
+    const int64 firstPoint = animationEnabled ? (int64) std::floor(animationTime / step) : 0;
+    const int64 advance = firstPoint - windowStart;
+    
+    bool pointsChanged = true;
+    
+    if (needsRecalculation.exchange(false) || advance < 0 || advance >= curveResolution)
     {
-        case CurveMode::CLASSIC_2D:
-            generate2DCurve();
-            break;
-        case CurveMode::CLASSIC_3D:
-            generate3DCurve();
-            break;
-        case CurveMode::MULTI_AXIS:
-        case CurveMode::PROJECTION_2D:
-        case CurveMode::PROJECTION_3D:
-            generateMultiAxisCurve();
-            break;
+        ringStart = 0;
+        windowStart = firstPoint;
+        
+        computePoints(0, curveResolution, firstPoint);
+        needsColorUpdate = true;
     }
+    else if (advance > 0)
+    {
+        // the new points take the place of the oldest ones
+        computePoints(ringStart, (int) advance, windowStart + curveResolution);
+        
+        ringStart = (int) ((ringStart + advance) % curveResolution);
+        windowStart = firstPoint;
+    }
+    else
+    {
+        pointsChanged = false;
+    }
+    
+    if (pointsChanged)
+        copyRingToCurves();
     
-    if (needsColorUpdate.exchange(false))
+    // time based colours go by position along the curve, the others follow the points
+    const bool coloursFollowPoints = colorScheme == ColorScheme::VELOCITY_BASED || colorScheme == ColorScheme::AXIS_BASED;
+    const bool coloursChanged = needsColorUpdate.exchange(false) || (pointsChanged && coloursFollowPoints);
+    
+    if (coloursChanged)
         updateColors();
     
-    needsRecalculation = false;
+    return pointsChanged || coloursChanged;
 }
 
-void EnhancedLissajousEngine::generate2DCurve()
+void EnhancedLissajousEngine::computePoints(int firstRingIndex, int numPoints, int64 firstPoint)
 {
-    curve3D.clear();
-    curve3D.reserve(curveResolution);
+    const double step = (double) timeSpan / curveResolution;
+    const int numAxes = getNumberOfComputedAxes();
+    
+    alignas(Lanes) float lanes[numLanes];
+    
+    for (int lane = 0; lane < numLanes; ++lane)
+        lanes[lane] = (float) (lane * step);
     
-    for (int i = 0; i < curveResolution; ++i)
+    const Lanes pointOffsets = Lanes::fromRawArray(lanes);
+    
+    // numLanes points at a time, every axis of a batch before the next batch
+    for (int batch = 0; batch < numPoints; batch += numLanes)
     {
-        float t = (float)i / curveResolution * timeSpan;
+        const int batchSize = jmin(numLanes, numPoints - batch);
+        const int batchRingIndex = (firstRingIndex + batch) % curveResolution;
+        const double batchStart = (double) (firstPoint + batch) * step;
         
-        Point3D point;
-        point.x = evaluateAxis(0, t);
-        point.y = evaluateAxis(1, t);
-        point.z = 0.0f;
-        point.time = t;
+        for (int axis = 0; axis < MAX_LISSAJOUS_AXES; ++axis)
+        {
+            if (axis < numAxes && axes[axis].isActive)
+                evaluateAxis(axis, batchStart, pointOffsets).copyToRawArray(lanes);
+            else
+                std::fill(lanes, lanes + numLanes, 0.0f);
+            
+            for (int lane = 0, r = batchRingIndex; lane < batchSize; ++lane, r = (r + 1 == curveResolution) ? 0 : r + 1)
+                ring->axisValues[axis][r] = lanes[lane];
+        }
         
-        curve3D.push_back(point);
+        for (int lane = 0, r = batchRingIndex; lane < batchSize; ++lane, r = (r + 1 == curveResolution) ? 0 : r + 1)
+        {
+            PointND point;
+            point.time = (float) (batchStart + lane * step);
+            
+            for (int axis = 0; axis < MAX_LISSAJOUS_AXES; ++axis)
+                point[axis] = ring->axisValues[axis][r];
+            
+            const Point3D projected = projectPoint(point);
+            
+            ring->projected[0][r] = projected.x;
+            ring->projected[1][r] = projected.y;
+            ring->projected[2][r] = projected.z;
+            ring->times[r] = point.time;
+        }
     }
 }
 
-void EnhancedLissajousEngine::generate3DCurve()
+void EnhancedLissajousEngine::copyRingToCurves()
 {
-    curve3D.clear();
-    curve3D.reserve(curveResolution);
+    // within the capacity reserved up front
+    curve3D.resize((size_t) curveResolution);
+    curveND.resize((size_t) curveResolution);
     
-    for (int i = 0; i < curveResolution; ++i)
+    for (int i = 0, r = ringStart; i < curveResolution; ++i, r = (r + 1 == curveResolution) ? 0 : r + 1)
     {
-        float t = (float)i / curveResolution * timeSpan;
+        auto& point3D = curve3D[(size_t) i];
+        point3D.x = ring->projected[0][r];
+        point3D.y = ring->projected[1][r];
+        point3D.z = ring->projected[2][r];
+        point3D.time = ring->times[r];
+        
+        auto& pointND = curveND[(size_t) i];
         
-        Point3D point;
-        point.x = evaluateAxis(0, t);
-        point.y = evaluateAxis(1, t);
-        point.z = evaluateAxis(2, t);
-        point.time = t;
+        for (int axis = 0; axis < MAX_LISSAJOUS_AXES; ++axis)
+            pointND[axis] = ring->axisValues[axis][r];
         
-        curve3D.push_back(point);
+        pointND.time = ring->times[r];
     }
 }
 
-void EnhancedLissajousEngine::generateMultiAxisCurve()
+int EnhancedLissajousEngine::getNumberOfComputedAxes() const
 {
-    curveND.clear();
-    curveND.reserve(curveResolution);
-    
-    curve3D.clear();
-    curve3D.reserve(curveResolution);
-    
-    for (int i = 0; i < curveResolution; ++i)
+    switch (curveMode)
     {
-        float t = (float)i / curveResolution * timeSpan;
-        
-        PointND pointND;
-        pointND.time = t;
-        
-        // Generate all active axes
-        for (int axis = 0; axis < numActiveAxes; ++axis)
-        {
-            if (axes[axis].isActive)
-                pointND[axis] = evaluateAxis(axis, t);
-        }
-        
-        curveND.push_back(pointND);
-        
-        // Create 3D projection for visualization
-        Point3D point3D;
-        if (curveMode == CurveMode::PROJECTION_3D)
-        {
-            // Project higher dimensions to 3D
-            if (numActiveAxes >= 6)
-                point3D = projectToSphericalCoords(pointND);
-            else
-                point3D = projectToCylindricalCoords(pointND);
-        }
-        else
-        {
-            // Use first 3 dimensions directly
-            point3D.x = (numActiveAxes > 0) ? pointND[0] : 0.0f;
-            point3D.y = (numActiveAxes > 1) ? pointND[1] : 0.0f;
-            point3D.z = (numActiveAxes > 2) ? pointND[2] : 0.0f;
-        }
+        case CurveMode::CLASSIC_2D: return 2;
+        case CurveMode::CLASSIC_3D: return 3;
+        default:                    return numActiveAxes;
+    }
+}
+
+Point3D EnhancedLissajousEngine::projectPoint(const PointND& point) const
+{
+    if (curveMode == CurveMode::PROJECTION_3D)
+    {
+        // Project higher dimensions to 3D
+        if (numActiveAxes >= 6)
+            return projectToSphericalCoords(point);
         
-        point3D.time = t;
-        curve3D.push_back(point3D);
+        return projectToCylindricalCoords(point);
     }
+    
+    // Use first 3 dimensions directly, the ones not computed are zero
+    Point3D result(point[0], point[1], point[2]);
+    result.time = point.time;
+    
+    return result;
 }
 
 void EnhancedLissajousEngine::updateColors()
@@ -518,8 +590,7 @@ void EnhancedLissajousEngine::calculateVelocityBasedColors()
     if (curve3D.size() < 2)
         return;
     
-    std::vector<float> velocities;
-    velocities.reserve(curve3D.size());
+    velocities.clear();
     
     // Calculate velocities
     for (size_t i = 1; i < curve3D.size(); ++i)
@@ -581,75 +652,83 @@ void EnhancedLissajousEngine::calculateAxisBasedColors()
     }
 }
 
-float EnhancedLissajousEngine::evaluateAxis(int axisIndex, float time) const
+EnhancedLissajousEngine::Lanes EnhancedLissajousEngine::evaluateAxis(int axisIndex, double batchStart, Lanes pointOffsets) const
 {
-    if (axisIndex < 0 || axisIndex >= MAX_LISSAJOUS_AXES || !axes[axisIndex].isActive)
-        return 0.0f;
-    
     const auto& axis = axes[axisIndex];
     
     // Apply global modulations
-    float effectiveFreq = axis.frequency * globalTimeScale;
-    float effectiveAmp = axis.amplitude * globalAmplitude;
-    float effectivePhase = axis.phase + globalPhaseShift;
+    const double effectiveFreq = axis.frequency * globalTimeScale;
+    const float effectiveAmp = axis.amplitude * globalAmplitude;
+    const double effectivePhase = (axis.phase + globalPhaseShift) / MathConstants<double>::twoPi;
+    
+    // Phase in cycles. The whole cycles up to the batch are dropped in double, so points
+    // keep their precision however long the animation has been running, and the frequency
+    // modulation below does the same
+    Lanes cycles = Lanes::expand((float) wrapCycles(effectiveFreq * batchStart + effectivePhase))
+                 + pointOffsets * (float) effectiveFreq;
+    
+    Lanes amplitude = Lanes::expand(effectiveAmp);
     
     // Apply frequency and amplitude modulation
     if (axis.freqModDepth > 0.0f)
     {
-        float freqMod = axis.freqModDepth * std::sin(2.0f * MathConstants<float>::pi * axis.freqModRate * time);
-        effectiveFreq *= (1.0f + freqMod);
+        // the modulated frequency applies to the whole elapsed time, as it always has. That
+        // term grows with the time, so it is worked out per point in double with an exact
+        // sine, and only its fraction of a cycle goes into the lanes
+        alignas(Lanes) float offsets[numLanes];
+        alignas(Lanes) float modulatedCycles[numLanes];
+        pointOffsets.copyToRawArray(offsets);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            const double time = batchStart + offsets[lane];
+            const double freqMod = axis.freqModDepth * std::sin(MathConstants<double>::twoPi * wrapCycles(axis.freqModRate * time));
+
+            modulatedCycles[lane] = (float) wrapCycles(freqMod * effectiveFreq * time);
+        }
+
+        cycles += Lanes::fromRawArray(modulatedCycles);
     }
     
     if (axis.ampModDepth > 0.0f)
     {
-        float ampMod = axis.ampModDepth * std::sin(2.0f * MathConstants<float>::pi * axis.ampModRate * time);
-        effectiveAmp *= (1.0f + ampMod);
+        const Lanes ampMod = sinCycles(modulationCycles(axis.ampModRate, batchStart, pointOffsets)) * axis.ampModDepth;
+        
+        amplitude *= ampMod + 1.0f;
     }
     
-    // Calculate phase
-    float phase = 2.0f * MathConstants<float>::pi * effectiveFreq * time + effectivePhase;
-    
-    // Evaluate waveform
-    float waveValue = evaluateWaveShape(axis.waveShape, phase);
-    
-    return effectiveAmp * waveValue + axis.offset;
+    return amplitude * evaluateWaveShape(axis.waveShape, cycles) + axis.offset;
 }
 
-float EnhancedLissajousEngine::evaluateWaveShape(LissajousAxis::WaveShape shape, float phase) const
+EnhancedLissajousEngine::Lanes EnhancedLissajousEngine::evaluateWaveShape(LissajousAxis::WaveShape shape, Lanes cycles)
 {
+    const Lanes position = fractionalPart(cycles);     // 0 - 1 through the cycle
+    const Lanes one = Lanes::expand(1.0f);
+    
     switch (shape)
     {
         case LissajousAxis::SINE:
-            return std::sin(phase);
+            return sinCycles(position);
             
         case LissajousAxis::TRIANGLE:
-            {
-                float normalizedPhase = std::fmod(phase, 2.0f * MathConstants<float>::pi);
-                if (normalizedPhase < 0) normalizedPhase += 2.0f * MathConstants<float>::pi;
-                
-                if (normalizedPhase < MathConstants<float>::pi)
-                    return -1.0f + 2.0f * normalizedPhase / MathConstants<float>::pi;
-                else
-                    return 3.0f - 2.0f * normalizedPhase / MathConstants<float>::pi;
-            }
+            return one - Lanes::abs(position - 0.5f) * 4.0f;
             
         case LissajousAxis::SQUARE:
-            return (std::sin(phase) >= 0) ? 1.0f : -1.0f;
+            return one - (Lanes::expand(2.0f) & Lanes::greaterThan(position, Lanes::expand(0.5f)));
             
         case LissajousAxis::SAWTOOTH:
-            {
-                float normalizedPhase = std::fmod(phase, 2.0f * MathConstants<float>::pi);
-                if (normalizedPhase < 0) normalizedPhase += 2.0f * MathConstants<float>::pi;
-                return -1.0f + normalizedPhase / MathConstants<float>::pi;
-            }
+            return position * 2.0f - 1.0f;
             
         case LissajousAxis::NOISE:
-            // Simple pseudo-random based on phase
-            return 2.0f * (std::sin(phase * 12.9898f + 78.233f) * 43758.5453f - std::floor(std::sin(phase * 12.9898f + 78.233f) * 43758.5453f)) - 1.0f;
+            {
+                // Simple pseudo-random based on phase
+                const Lanes hash = sinCycles(position * 12.9898f + (float) (78.233 / MathConstants<double>::twoPi)) * 43758.5453f;
+                return fractionalPart(hash) * 2.0f - 1.0f;
+            }
             
         case LissajousAxis::CUSTOM:
         default:
-            return std::sin(phase); // Default to sine
+            return sinCycles(position); // Default to sine
     }
 }
 
@@ -739,18 +818,8 @@ void EnhancedLissajousEngine::notifyListeners()
 void EnhancedLissajousEngine::timerCallback()
 {
     if (animationEnabled)
-    {
         animationTime += animationSpeed / updateRateHz;
-        
-        // Update global phase for animation
-        globalPhaseShift = animationTime * 0.5f;
-        
-        needsRecalculation = true;
-    }
     
-    if (needsRecalculation.exchange(false))
-    {
-        generateCurve();
+    if (generateCurve())
         notifyListeners();
-    }
 }
\ No newline at end of file
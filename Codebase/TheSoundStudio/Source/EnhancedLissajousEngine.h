@@ -132,6 +132,7 @@ public:
     int getNumberOfAxes() const { return numActiveAxes; }
     int getMaxAxes() const { return MAX_LISSAJOUS_AXES; }
     
+    // the caller may change the axis through the reference, so the curve is redrawn
     LissajousAxis& getAxis(int axisIndex);
     const LissajousAxis& getAxis(int axisIndex) const;
     
@@ -167,14 +168,17 @@ public:
     
     //==============================================================================
     // Real-time Control
-    void setGlobalTimeScale(float scale) { globalTimeScale = scale; }
-    void setGlobalAmplitude(float amp) { globalAmplitude = amp; }
-    void setGlobalPhaseShift(float phase) { globalPhaseShift = phase; }
+    void setGlobalTimeScale(float scale) { globalTimeScale = scale; needsRecalculation = true; }
+    void setGlobalAmplitude(float amp) { globalAmplitude = amp; needsRecalculation = true; }
+    void setGlobalPhaseShift(float phase) { globalPhaseShift = phase; needsRecalculation = true; }
     
     //==============================================================================
     // Animation
+    // The curve shows a window of timeSpan seconds that moves forward at animationSpeed
+    // seconds per second. Each frame only the points the window advanced onto are
+    // computed, the rest are kept from the frames before.
     void setAnimationSpeed(float speed) { animationSpeed = speed; }
-    void setAnimationMode(bool enabled) { animationEnabled = enabled; }
+    void setAnimationMode(bool enabled) { animationEnabled = enabled; needsRecalculation = true; }
     bool isAnimationEnabled() const { return animationEnabled; }
     
     //==============================================================================
@@ -236,6 +240,22 @@ private:
     std::vector<PointND> curveND;
     mutable std::mutex curveMutex;
     
+    // The points the curves are copied from, structure-of-arrays. A ring over the time
+    // window: ringStart is its oldest point, which is point number windowStart of the
+    // whole animation.
+    struct CurveRing
+    {
+        float axisValues[MAX_LISSAJOUS_AXES][MAX_CURVE_POINTS];
+        float projected[3][MAX_CURVE_POINTS];   // the Point3D the curve mode makes of them
+        float times[MAX_CURVE_POINTS];
+    };
+    
+    std::unique_ptr<CurveRing> ring;
+    int ringStart = 0;
+    int64 windowStart = 0;
+    
+    std::vector<float> velocities;              // velocity based colours
+    
     //==============================================================================
     // Visual settings
     ColorScheme colorScheme = ColorScheme::TIME_BASED;
@@ -252,7 +272,7 @@ private:
     // Animation
     bool animationEnabled = false;
     float animationSpeed = 1.0f;
-    float animationTime = 0.0f;
+    double animationTime = 0.0;
     int updateRateHz = 60;
     
     //==============================================================================
@@ -267,18 +287,23 @@ private:
     
     //==============================================================================
     // Internal processing
-    void generateCurve();
-    void generate2DCurve();
-    void generate3DCurve();
-    void generateMultiAxisCurve();
+    using Lanes = dsp::SIMDRegister<float>;
+    static constexpr int numLanes = (int) Lanes::SIMDNumElements;
+    
+    bool generateCurve();           // false if the curve didn't change
+    void computePoints(int firstRingIndex, int numPoints, int64 firstPoint);
+    void copyRingToCurves();
+    int getNumberOfComputedAxes() const;
+    Point3D projectPoint(const PointND& point) const;
     
     void updateColors();
     void calculateTimeBasedColors();
     void calculateVelocityBasedColors();
     void calculateAxisBasedColors();
     
-    float evaluateAxis(int axisIndex, float time) const;
-    float evaluateWaveShape(LissajousAxis::WaveShape shape, float phase) const;
+    // numLanes points starting at batchStart seconds, pointOffsets being their distance from it
+    Lanes evaluateAxis(int axisIndex, double batchStart, Lanes pointOffsets) const;
+    static Lanes evaluateWaveShape(LissajousAxis::WaveShape shape, Lanes cycles);
     
     Point3D projectToSphericalCoords(const PointND& point) const;
     Point3D projectToCylindricalCoords(const PointND& point) const;
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    FFTPlanCache.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <map>
+
+// One FFT plan per size and one window table per (size, window) pair, shared by every
+// AnalyserNew attached to the same AnalysisService. Plans are created lazily the first
+// time a size is selected and live until the cache is destroyed, so analysers can hold
+// plain pointers into it. dsp::FFT and dsp::WindowingFunction are only read through
+// const methods, which makes them safe to use from several analysis workers at once.
+class FFTPlanCache
+{
+public:
+    static constexpr int minOrder = 10;     // 1024
+    static constexpr int maxOrder = 16;     // 65536
+    static constexpr int maxSize  = 1 << maxOrder;
+
+    FFTPlanCache() = default;
+
+    // fftEnum uses the same values as the FFT_SIZE setting (0/1 = 1024 ... 7 = 65536)
+    static int orderForFFTSizeEnum (int fftEnum)
+    {
+        return jlimit (minOrder, maxOrder, minOrder + jmax (0, fftEnum - 1));
+    }
+
+    const dsp::FFT* getPlan (int order)
+    {
+        jassert (order >= minOrder && order <= maxOrder);
+
+        const ScopedLock sl (cacheLock);
+
+        auto& plan = plans[(size_t) (order - minOrder)];
+
+        if (plan == nullptr)
+            plan = std::make_unique<dsp::FFT> (order);
+
+        return plan.get();
+    }
+
+    const dsp::WindowingFunction<float>* getWindow (int order, int windowEnum)
+    {
+        jassert (order >= minOrder && order <= maxOrder);
+
+        const ScopedLock sl (cacheLock);
+
+        auto& window = windows[std::make_pair (order, windowEnum)];
+
+        if (window == nullptr)
+            window = std::make_unique<dsp::WindowingFunction<float>> ((size_t) (1 << order),
+                                                                      (dsp::WindowingFunction<float>::WindowingMethod) windowEnum,
+                                                                      true, 4);
+
+        return window.get();
+    }
+
+private:
+    CriticalSection cacheLock;
+
+    std::array<std::unique_ptr<dsp::FFT>, maxOrder - minOrder + 1> plans;
+    std::map<std::pair<int, int>, std::unique_ptr<dsp::WindowingFunction<float>>> windows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTPlanCache)
+};
@@ -15,20 +15,15 @@
 #include "ProjectManager.h"
 
 FrequencyPlayerProcessor::FrequencyPlayerProcessor(FrequencyManager * fm, ProjectManager * pm)
+    : enginePool([this] { return createShortcutEngine(); },
+                 [this] (int synthRef, ShortcutEngine& engine) { shortcutEngineAttached(synthRef, engine); },
+                 [this] (int synthRef, ShortcutEngine& engine) { shortcutEngineDetached(synthRef, engine); })
 {
     projectManager      = pm;
     frequencyManager    = fm;
     
     for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]            = new FrequencySynthProcessor(44100, frequencyManager);
-        synth[i]            ->setNoteStealingEnabled(true);
-        synth[i]            ->setCurrentPlaybackSampleRate(44100);
-
-        wavetableSynth[i]   = new FrequencyPlayerWavetableSynthProcessor(44100, frequencyManager);
-        wavetableSynth[i]   ->setNoteStealingEnabled(true);
-        wavetableSynth[i]   ->setCurrentPlaybackSampleRate(44100);
-        
         waveformType[i] = DEFAULT;
         
         shouldMute[i] = false;
@@ -40,29 +35,17 @@ FrequencyPlayerProcessor::FrequencyPlayerProcessor(FrequencyManager * fm, Projec
 
 FrequencyPlayerProcessor::~FrequencyPlayerProcessor()
 {
-    // Properly clean up allocated resources
-    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
-    {
-        if (synth[i])
-        {
-            delete synth[i];
-            synth[i] = nullptr;
-        }
-        
-        if (wavetableSynth[i])
-        {
-            delete wavetableSynth[i];
-            wavetableSynth[i] = nullptr;
-        }
-    }
 }
 
 void FrequencyPlayerProcessor::prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock)
 {
-    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]    ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
-        wavetableSynth[i]   ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
+        const ScopedLock sl (enginePool.getLock());
+        
+        hostSampleRate  = sampleRate;
+        hostBlockSize   = maximumExpectedSamplesPerBlock;
+        
+        enginePool.forEachEngine([this] (ShortcutEngine& engine) { prepareShortcutEngine(engine); });
     }
     
     repeater->prepareToPlay(sampleRate);
@@ -72,23 +55,136 @@ void FrequencyPlayerProcessor::prepareToPlay (double sampleRate, int maximumExpe
     outputBuffer.setSize(1, maximumExpectedSamplesPerBlock);
 }
 
-void FrequencyPlayerProcessor::setParameter(int synthRef, int index, var newValue)
+//=============================================================
+// Shortcut Engines
+//=============================================================
+FrequencyPlayerProcessor::ShortcutEngine::ShortcutEngine(FrequencyManager * fm)
+    : synth(44100, fm),
+      wavetableSynth(44100, fm)
+{
+    synth           .setNoteStealingEnabled(true);
+    synth           .setCurrentPlaybackSampleRate(44100);
+    
+    wavetableSynth  .setNoteStealingEnabled(true);
+    wavetableSynth  .setCurrentPlaybackSampleRate(44100);
+}
+
+// called with the pool's lock held
+std::unique_ptr<FrequencyPlayerProcessor::ShortcutEngine> FrequencyPlayerProcessor::createShortcutEngine()
+{
+    auto engine = std::make_unique<ShortcutEngine>(frequencyManager);
+    
+    prepareShortcutEngine(*engine);
+    
+    return engine;
+}
+
+void FrequencyPlayerProcessor::prepareShortcutEngine(ShortcutEngine& engine)
+{
+    engine.synth            .setOversamplingFactor(oversamplingFactor);
+    engine.wavetableSynth   .setOversamplingFactor(oversamplingFactor);
+    engine.oversampler      .setFactor(oversamplingFactor);
+    
+    if (hostBlockSize > 0)
+    {
+        engine.synth            .prepareToPlay(hostSampleRate, hostBlockSize);
+        engine.wavetableSynth   .prepareToPlay(hostSampleRate, hostBlockSize);
+        engine.oversampler      .prepare(hostBlockSize);
+    }
+}
+
+void FrequencyPlayerProcessor::shortcutEngineAttached(int synthRef, ShortcutEngine& engine)
+{
+    // engines come back once their tail is silent, unless it was cut short
+    engine.synth            .allNotesOff(0, false);
+    engine.wavetableSynth   .allNotesOff(0, false);
+    engine.oversampler      .reset();
+    
+    for (int i = 0; i < numEngineParameters; i++)
+    {
+        if (!engineParameters[synthRef][i].isVoid())
+            applyEngineParameter(engine, firstEngineParameter + i, engineParameters[synthRef][i]);
+    }
+}
+
+void FrequencyPlayerProcessor::shortcutEngineDetached(int synthRef, ShortcutEngine& engine)
+{
+    // the note releases into a tail, rendered until it is silent
+    engine.synth            .allNotesOff(0, true);
+    engine.wavetableSynth   .allNotesOff(0, true);
+    
+    tailSamplesLeft[synthRef] = (int)(hostSampleRate * maxTailSeconds);
+}
+
+bool FrequencyPlayerProcessor::isTailSilent(const ShortcutEngine& engine)
+{
+    return !ShortcutEnginePool<ShortcutEngine>::hasActiveVoices(engine.synth)
+        && !ShortcutEnginePool<ShortcutEngine>::hasActiveVoices(engine.wavetableSynth);
+}
+
+void FrequencyPlayerProcessor::applyEngineParameter(ShortcutEngine& engine, int index, const var& newValue)
 {
     if (index == FREQUENCY_PLAYER_WAVEFORM_TYPE)
     {
-        panic();
-        
-        waveformType[synthRef] = (WAVEFORM_TYPES)newValue.operator int();
-        
-        if (waveformType[synthRef] != WAVETABLE)
-        {
-            synth[synthRef]           ->setParameter(index, newValue);
-        }
+        if ((WAVEFORM_TYPES)newValue.operator int() != WAVETABLE)
+            engine.synth.setParameter(index, newValue);
+    }
+    else
+    {
+        engine.synth            .setParameter(index, newValue);
+        engine.wavetableSynth   .setParameter(index, newValue);
+    }
+}
+
+void FrequencyPlayerProcessor::setShortcutInUse(int synthRef, bool inUse)
+{
+    if (inUse)
+    {
+        enginePool.acquire(synthRef);
     }
-    else if (index >= FREQUENCY_PLAYER_FREQ_SOURCE && index <= FREQUENCY_PLAYER_RELEASE)
+    else if (auto * engine = enginePool.getEngine(synthRef))
     {
-        synth[synthRef]->setParameter(index, newValue);
-        wavetableSynth[synthRef]->setParameter(index, newValue);
+        if (!engine->hasEditedWavetable)
+            enginePool.release(synthRef);
+    }
+}
+
+double * FrequencyPlayerProcessor::getWavetableBuffer(int synthRef)
+{
+    return enginePool.acquire(synthRef)->wavetableSynth.getBaseWavetableBuffer();
+}
+
+void FrequencyPlayerProcessor::setWavetableBuffer(int synthRef, double * tableArray)
+{
+    auto * engine = enginePool.acquire(synthRef);
+    
+    engine->wavetableSynth.setWavetableBuffer(tableArray);
+    engine->hasEditedWavetable = true;
+}
+
+void FrequencyPlayerProcessor::initBaseWaveType(int synthRef, int newType)
+{
+    auto * engine = enginePool.acquire(synthRef);
+    
+    engine->wavetableSynth.initBaseWaveType(newType);
+    engine->hasEditedWavetable = newType != 0;
+}
+
+void FrequencyPlayerProcessor::setParameter(int synthRef, int index, var newValue)
+{
+    if (index >= firstEngineParameter && index < firstEngineParameter + numEngineParameters)
+    {
+        if (index == FREQUENCY_PLAYER_WAVEFORM_TYPE)
+        {
+            panic();
+            
+            waveformType[synthRef] = (WAVEFORM_TYPES)newValue.operator int();
+        }
+        
+        engineParameters[synthRef][index - firstEngineParameter] = newValue;
+        
+        if (auto * engine = enginePool.get(synthRef))
+            applyEngineParameter(*engine, index, newValue);
     }
     else if (index == FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)
     {
@@ -119,13 +215,17 @@ void FrequencyPlayerProcessor::setParameter(int synthRef, int index, var newValu
 
 void FrequencyPlayerProcessor::setOversamplingFactor(int newFactor)
 {
-    // ** NOT WORKING YET
+    if (!ShortcutOversampler::isValidFactor(newFactor) || newFactor == oversamplingFactor)
+        return;
+    
     suspendProcessing(true);
     
-    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-//        synth[i]->setOversamplingFactor(newFactor);
+        const ScopedLock sl (enginePool.getLock());
         
+        oversamplingFactor = newFactor;
+        
+        enginePool.forEachEngine([this] (ShortcutEngine& engine) { prepareShortcutEngine(engine); });
     }
     
     suspendProcessing(false);
@@ -134,59 +234,101 @@ void FrequencyPlayerProcessor::setOversamplingFactor(int newFactor)
 void FrequencyPlayerProcessor::processBlock (AudioBuffer<float>& buffer,
                                          MidiBuffer& midiMessages)
 {
-    // process repeater first
-    if (playState == PLAY_STATE::PLAYING)
+    const ScopedTryLock stl (getCallbackLock());
+    
+    if (!stl.isLocked() || isSuspended())
+        return;
+    
+    enginePool.update();
+    
+    // run the repeater and render the shortcuts in the segments between its events,
+    // so every repeat starts and stops on the sample it was scheduled for
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &buffer, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        for (int s = 0; s < NUM_SHORTCUT_SYNTHS; s++)
+                                        {
+                                            if (isActive[s] && !shouldMute[s] && enginePool.get(s) != nullptr)
+                                                renderShortcut(s, *enginePool.get(s), buffer, midiMessages, startSample, numSamples);
+                                            
+                                            renderTail(s, buffer, startSample, numSamples);
+                                        }
+                                    });
+}
+
+void FrequencyPlayerProcessor::renderTail(int s, AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    auto * tail = enginePool.getTail(s);
+    
+    if (tail == nullptr)
+        return;
+    
+    // a tail keeps playing after its shortcut is switched off, unless nobody would hear it
+    if (shouldMute[s] || output[s] == AUDIO_OUTPUTS::NO_OUTPUT)
     {
-        // run repeater looper..
-        repeater->tickBuffer(buffer.getNumSamples());
+        enginePool.finishTail(s);
+        return;
     }
     
-    for (int s = 0; s < NUM_SHORTCUT_SYNTHS; s++)
+    // it only plays out the note it has, new ones go to the shortcut's own engine
+    renderShortcut(s, *tail, buffer, tailMidi, startSample, numSamples);
+    
+    tailSamplesLeft[s] -= numSamples;
+    
+    if (isTailSilent(*tail) || tailSamplesLeft[s] <= 0)
+        enginePool.finishTail(s);
+}
+
+void FrequencyPlayerProcessor::renderShortcut(int s, ShortcutEngine& engine, AudioBuffer<float>& buffer, MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    outputBuffer.clear(startSample, numSamples);
+    
+    if (output[s] != AUDIO_OUTPUTS::NO_OUTPUT)
     {
-        if (isActive[s] && !shouldMute[s])
+        engine.oversampler.process(outputBuffer, startSample, numSamples,
+                                   [this, s, &engine, &midiMessages] (AudioBuffer<float>& renderBuffer, int renderStart, int numRenderSamples)
+                                   {
+                                       if (waveformType[s] == WAVETABLE)
+                                       {
+                                           engine.wavetableSynth.renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                                       }
+                                       else
+                                       {
+                                           engine.synth.renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                                       }
+                                   });
+        
+        if      (output[s] == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_4 && buffer.getNumChannels() > 3) { buffer.addFrom(3, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::STEREO_1_2 && buffer.getNumChannels() > 1)
         {
-            outputBuffer.clear();
-            
-            if (output[s] != AUDIO_OUTPUTS::NO_OUTPUT)
-            {
-                if (waveformType[s] == WAVETABLE)
-                {
-                    wavetableSynth[s]->processBlock(outputBuffer, midiMessages);
-                }
-                else
-                {
-                    synth[s]->processBlock(outputBuffer, midiMessages);
-                }
-                
-                if      (output[s] == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_4 && buffer.getNumChannels() > 3) { buffer.addFrom(3, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_1_2 && buffer.getNumChannels() > 1)
-                {
-                    buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_3_4 && buffer.getNumChannels() > 2)
-                {
-                    buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(3, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_5 && buffer.getNumChannels() > 4) { buffer.addFrom(4, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_6 && buffer.getNumChannels() > 5) { buffer.addFrom(5, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_7 && buffer.getNumChannels() > 6) { buffer.addFrom(6, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::MONO_8 && buffer.getNumChannels() > 7) { buffer.addFrom(7, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_5_6 && buffer.getNumChannels() > 5)
-                {
-                    buffer.addFrom(4, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(5, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-                else if (output[s] == AUDIO_OUTPUTS::STEREO_7_8 && buffer.getNumChannels() > 7)
-                {
-                    buffer.addFrom(6, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                    buffer.addFrom(7, 0, outputBuffer, 0, 0, buffer.getNumSamples());
-                }
-            }
+            buffer.addFrom(0, startSample, outputBuffer, 0, startSample, numSamples);
+            buffer.addFrom(1, startSample, outputBuffer, 0, startSample, numSamples);
+        }
+        else if (output[s] == AUDIO_OUTPUTS::STEREO_3_4 && buffer.getNumChannels() > 2)
+        {
+            buffer.addFrom(2, startSample, outputBuffer, 0, startSample, numSamples);
+            buffer.addFrom(3, startSample, outputBuffer, 0, startSample, numSamples);
+        }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_5 && buffer.getNumChannels() > 4) { buffer.addFrom(4, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_6 && buffer.getNumChannels() > 5) { buffer.addFrom(5, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_7 && buffer.getNumChannels() > 6) { buffer.addFrom(6, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::MONO_8 && buffer.getNumChannels() > 7) { buffer.addFrom(7, startSample, outputBuffer, 0, startSample, numSamples); }
+        else if (output[s] == AUDIO_OUTPUTS::STEREO_5_6 && buffer.getNumChannels() > 5)
+        {
+            buffer.addFrom(4, startSample, outputBuffer, 0, startSample, numSamples);
+            buffer.addFrom(5, startSample, outputBuffer, 0, startSample, numSamples);
+        }
+        else if (output[s] == AUDIO_OUTPUTS::STEREO_7_8 && buffer.getNumChannels() > 7)
+        {
+            buffer.addFrom(6, startSample, outputBuffer, 0, startSample, numSamples);
+            buffer.addFrom(7, startSample, outputBuffer, 0, startSample, numSamples);
         }
     }
 }
@@ -206,18 +348,23 @@ void FrequencyPlayerProcessor::triggerKeyUp(int shortcutRef)
 
 void FrequencyPlayerProcessor::triggerNoteOn(int shortcutRef)
 {
+    auto * engine = enginePool.get(shortcutRef);
+    
+    if (engine == nullptr)
+        return;
+    
     float freq = 0;
     if (waveformType[shortcutRef] == WAVETABLE)
     {
-        wavetableSynth[shortcutRef]->noteOn(0, 0, 1.0);
+        engine->wavetableSynth.noteOn(0, 0, 1.0);
         
-        freq = wavetableSynth[shortcutRef]->getChosenFrequency();
+        freq = engine->wavetableSynth.getChosenFrequency();
     }
     else
     {
-        synth[shortcutRef]->noteOn(0, 0, 1.0);
+        engine->synth.noteOn(0, 0, 1.0);
         
-        freq = synth[shortcutRef]->getChosenFrequency();
+        freq = engine->synth.getChosenFrequency();
     }
     
     
@@ -228,13 +375,18 @@ void FrequencyPlayerProcessor::triggerNoteOn(int shortcutRef)
 
 void FrequencyPlayerProcessor::triggerNoteOff(int shortcutRef)
 {
+    auto * engine = enginePool.get(shortcutRef);
+    
+    if (engine == nullptr)
+        return;
+    
     if (waveformType[shortcutRef] == WAVETABLE)
     {
-        wavetableSynth[shortcutRef]->noteOff(0, 0, 0.0, true);
+        engine->wavetableSynth.noteOff(0, 0, 0.0, true);
     }
     else
     {
-        synth[shortcutRef]->noteOff(0, 0, 0.0, true);
+        engine->synth.noteOff(0, 0, 0.0, true);
     }
     
 }
@@ -243,8 +395,11 @@ void FrequencyPlayerProcessor::panic()
 {
     for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
     {
-        synth[i]    ->allNotesOff(0, true);
-        wavetableSynth[i]    ->allNotesOff(0, true);
+        if (auto * engine = enginePool.get(i))
+        {
+            engine->synth           .allNotesOff(0, true);
+            engine->wavetableSynth  .allNotesOff(0, true);
+        }
     }
 }
 
@@ -592,39 +747,55 @@ void FrequencyPlayerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void FrequencyPlayerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int FrequencyPlayerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    if (playSimultaneous)
     {
-        for (int i = 0; i < numSamples; i++)
+        processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
+    }
+    else
+    {
+        // just sequence through active shortcuts
+        if (isActive[currentPlayingShortcut])
         {
-            processSecondsClock();
-            
-            if (playSimultaneous)
-            {
-                processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
-            }
-            else
-            {
-                // just sequence through active shortcuts
-                if (isActive[currentPlayingShortcut])
-                {
-                    processShortcut(currentPlayingShortcut, sampleCounter);
-                }
-            }
-            
-            sampleCounter++;
-            
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
-            }
+            processShortcut(currentPlayingShortcut, sampleCounter);
+        }
+    }
+    
+    // only the shortcuts the tick above would look at can produce the next event
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    for (int i = 0; i < NUM_SHORTCUT_SYNTHS; i++)
+    {
+        const bool isWatched = playSimultaneous ? isActive[i] : (i == currentPlayingShortcut && isActive[i]);
+        
+        if (isWatched)
+        {
+            RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent[i]);
+            RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent[i]);
         }
     }
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
+    }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
+    }
+    
+    return numSamples;
 }
 
 void FrequencyPlayerProcessor::PlayRepeater::processShortcut(int shortcutRef, int sampleRef)
@@ -16,6 +16,9 @@
 #include "VotanSynthProcessor.h"
 #include "SamplerProcessor.h"
 #include "WavetableSynthProcessor.h"
+#include "RepeaterScheduler.h"
+#include "ShortcutOversampler.h"
+#include "ShortcutEnginePool.h"
 
 class ProjectManager;
 
@@ -61,8 +64,12 @@ public:
     void setPlayerCommand(PLAYER_COMMANDS command);
     void setPlayerPlayMode(PLAY_MODE mode);
     
-    FrequencySynthProcessor *  synth[NUM_SHORTCUT_SYNTHS];
-    FrequencyPlayerWavetableSynthProcessor * wavetableSynth[NUM_SHORTCUT_SYNTHS];
+    // Message thread, see ChordPlayerProcessor
+    void setShortcutInUse(int synthRef, bool inUse);
+    
+    double * getWavetableBuffer(int synthRef);
+    void setWavetableBuffer(int synthRef, double * tableArray);
+    void initBaseWaveType(int synthRef, int newType);
     
     enum WAVEFORM_TYPES { DEFAULT = 0, SINE, TRI, SQR, SAW, WAVETABLE } waveformType[NUM_SHORTCUT_SYNTHS];
     
@@ -73,6 +80,43 @@ public:
     AudioBuffer<float> outputBuffer;
     
 private:
+    struct ShortcutEngine
+    {
+        explicit ShortcutEngine(FrequencyManager * fm);
+        
+        FrequencySynthProcessor                 synth;
+        FrequencyPlayerWavetableSynthProcessor  wavetableSynth;
+        ShortcutOversampler                     oversampler;
+        
+        bool hasEditedWavetable = false;    // message thread
+    };
+    
+    std::unique_ptr<ShortcutEngine> createShortcutEngine();
+    void prepareShortcutEngine(ShortcutEngine& engine);
+    void shortcutEngineAttached(int synthRef, ShortcutEngine& engine);
+    void shortcutEngineDetached(int synthRef, ShortcutEngine& engine);
+    static bool isTailSilent(const ShortcutEngine& engine);
+    void applyEngineParameter(ShortcutEngine& engine, int index, const var& newValue);
+    
+    static constexpr int firstEngineParameter   = FREQUENCY_PLAYER_FREQ_SOURCE;
+    static constexpr int numEngineParameters    = FREQUENCY_PLAYER_RELEASE - FREQUENCY_PLAYER_FREQ_SOURCE + 1;
+    
+    var engineParameters[NUM_SHORTCUT_SYNTHS][numEngineParameters];     // audio thread, void until set
+    
+    ShortcutEnginePool<ShortcutEngine> enginePool;
+    
+    // a tail longer than this is cut, so a stuck voice can't hold its engine forever
+    static constexpr double maxTailSeconds = 10.0;
+    int         tailSamplesLeft[NUM_SHORTCUT_SYNTHS] {};    // audio thread
+    MidiBuffer  tailMidi;                                   // always empty
+    
+    void renderShortcut(int s, ShortcutEngine& engine, AudioBuffer<float>& buffer, MidiBuffer& midiMessages, int startSample, int numSamples);
+    void renderTail(int s, AudioBuffer<float>& buffer, int startSample, int numSamples);
+    
+    int    oversamplingFactor   = 1;
+    double hostSampleRate       = 44100;
+    int    hostBlockSize        = 0;
+    
     bool samplerOrSynth; // switched between processing of Sampler of Synth
     
     FrequencyManager * frequencyManager;
@@ -95,7 +139,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
@@ -28,6 +28,7 @@ FrequencyScannerProcessor::FrequencyScannerProcessor(FrequencyManager * fm, Proj
     wavetableSynth  ->setCurrentPlaybackSampleRate(44100);
         
     shouldMute      = false;
+    playState       = PLAY_STATE::OFF;
     waveformType    = DEFAULT;
     
     repeater        = new PlayRepeater(this, 44100);
@@ -57,8 +58,14 @@ FrequencyScannerProcessor::~FrequencyScannerProcessor()
 
 void FrequencyScannerProcessor::prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock)
 {
-    synth       ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
-    repeater    ->prepareToPlay(sampleRate);
+    hostSampleRate  = sampleRate;
+    hostBlockSize   = maximumExpectedSamplesPerBlock;
+    
+    synth           ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
+    wavetableSynth  ->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
+    repeater        ->prepareToPlay(sampleRate);
+    
+    oversampler.prepare(maximumExpectedSamplesPerBlock);
     
     outputBuffer.clear();
     
@@ -132,13 +139,21 @@ void FrequencyScannerProcessor::setParameter(int index, var newValue)
 
 void FrequencyScannerProcessor::setOversamplingFactor(int newFactor)
 {
-    // ** NOT WORKING YET
+    if (!ShortcutOversampler::isValidFactor(newFactor) || newFactor == oversamplingFactor)
+        return;
+    
     suspendProcessing(true);
     
-    for (int i = 0; i < 1; i++)
+    oversamplingFactor = newFactor;
+    
+    synth           ->setOversamplingFactor(newFactor);
+    wavetableSynth  ->setOversamplingFactor(newFactor);
+    oversampler.setFactor(newFactor);
+    
+    if (hostBlockSize > 0)
     {
-        //        synth[i]->setOversamplingFactor(newFactor);
-        
+        synth           ->prepareToPlay(hostSampleRate, hostBlockSize);
+        wavetableSynth  ->prepareToPlay(hostSampleRate, hostBlockSize);
     }
     
     suspendProcessing(false);
@@ -147,26 +162,27 @@ void FrequencyScannerProcessor::setOversamplingFactor(int newFactor)
 void FrequencyScannerProcessor::processBlock (AudioBuffer<float>& buffer,
                                              MidiBuffer& midiMessages)
 {
-    // process repeater first
-    if (playState == PLAY_STATE::PLAYING)
-    {
-        // run repeater looper..
-        repeater->tickBuffer(buffer.getNumSamples());
-    }
+    const ScopedTryLock stl (getCallbackLock());
+    
+    if (!stl.isLocked() || isSuspended())
+        return;
     
     outputBuffer.clear();
+    
+    // run the repeater and render the synth in the segments between its events,
+    // so every frequency step lands on the sample it was scheduled for
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        renderSynth(midiMessages, startSample, numSamples);
+                                    });
 
     if (output != AUDIO_OUTPUTS::NO_OUTPUT)
     {
-        if (waveformType == WAVETABLE)
-        {
-            wavetableSynth->processBlock(outputBuffer, midiMessages);
-        }
-        else
-        {
-            synth->processBlock(outputBuffer, midiMessages);
-        }
-        
         if      (output == AUDIO_OUTPUTS::MONO_1) { buffer.addFrom(0, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
         else if (output == AUDIO_OUTPUTS::MONO_2 && buffer.getNumChannels() > 1) { buffer.addFrom(1, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
         else if (output == AUDIO_OUTPUTS::MONO_3 && buffer.getNumChannels() > 2) { buffer.addFrom(2, 0, outputBuffer, 0, 0, buffer.getNumSamples()); }
@@ -185,6 +201,25 @@ void FrequencyScannerProcessor::processBlock (AudioBuffer<float>& buffer,
 
 }
 
+void FrequencyScannerProcessor::renderSynth(MidiBuffer& midiMessages, int startSample, int numSamples)
+{
+    if (output == AUDIO_OUTPUTS::NO_OUTPUT)
+        return;
+    
+    oversampler.process(outputBuffer, startSample, numSamples,
+                        [this, &midiMessages] (AudioBuffer<float>& renderBuffer, int renderStart, int numRenderSamples)
+                        {
+                            if (waveformType == WAVETABLE)
+                            {
+                                wavetableSynth->renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                            }
+                            else
+                            {
+                                synth->renderNextBlock(renderBuffer, midiMessages, renderStart, numRenderSamples);
+                            }
+                        });
+}
+
 // trigger commands
 // temp functions, called when shortcut keys are pressed
 // can be evolved to trigger the repeater later, or called by by repeater
@@ -615,36 +650,42 @@ void FrequencyScannerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void FrequencyScannerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int FrequencyScannerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    if (logOrLinear == 0) // log
     {
-        for (int i = 0; i < numSamples; i++)
-        {
-            processSecondsClock();
-
-
-            if (logOrLinear == 0) // log
-            {
-                processLog(sampleCounter);
-            }
-            else
-            {
-                processLin(sampleCounter);
-            }
-
-            sampleCounter++;
-
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
-            }
-        }
+        processLog(sampleCounter);
     }
+    else
+    {
+        processLin(sampleCounter);
+    }
+    
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent);
+    RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent);
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
+    }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
+    }
+    
+    return numSamples;
 }
 
 void FrequencyScannerProcessor::PlayRepeater::processLog(int sampleRef)
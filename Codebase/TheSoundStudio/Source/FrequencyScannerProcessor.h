@@ -15,6 +15,8 @@
 
 #include "VotanSynthProcessor.h"
 #include "WavetableSynthProcessor.h"
+#include "RepeaterScheduler.h"
+#include "ShortcutOversampler.h"
 
 class ProjectManager;
 
@@ -74,6 +76,13 @@ public:
     
     
 private:
+    void renderSynth(MidiBuffer& midiMessages, int startSample, int numSamples);
+    
+    ShortcutOversampler oversampler;
+    int    oversamplingFactor   = 1;
+    double hostSampleRate       = 44100;
+    int    hostBlockSize        = 0;
+    
     bool samplerOrSynth; // switched between processing of Sampler of Synth
     
     FrequencyManager * frequencyManager;
@@ -97,7 +106,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
@@ -125,6 +134,7 @@ public:
         
         int getTotalMSOfLoop();
         int getCurrentMSInLoop();
+        uint64 getTotalNumSamplesOfLoop() const { return totalNumSamplesOfLoop; }
         float getProgressBarValue();
         String getTimeRemainingInSecondsString();
         
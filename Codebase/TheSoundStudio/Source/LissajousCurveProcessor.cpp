@@ -90,25 +90,26 @@ void LissajousFrequencyPlayerProcessor::setParameter(int synthRef, int index, va
 void LissajousFrequencyPlayerProcessor::processBlock (AudioBuffer<float>& buffer,
                                          MidiBuffer& midiMessages)
 {
-    // process repeater first
-    if (playState == PLAY_STATE::PLAYING)
-    {
-        // run repeater looper..
-        repeater->tickBuffer(buffer.getNumSamples());
-    }
-    
-
-    if (isActive && !shouldMute)
-    {
-        if (waveformType == WAVETABLE)
-        {
-            wavetableSynth->processBlock(buffer, midiMessages);
-        }
-        else
-        {
-            synth->processBlock(buffer, midiMessages);
-        }
-    }
+    // run the repeater and render the synth in the segments between its events
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &buffer, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        if (isActive && !shouldMute)
+                                        {
+                                            if (waveformType == WAVETABLE)
+                                            {
+                                                wavetableSynth->renderNextBlock(buffer, midiMessages, startSample, numSamples);
+                                            }
+                                            else
+                                            {
+                                                synth->renderNextBlock(buffer, midiMessages, startSample, numSamples);
+                                            }
+                                        }
+                                    });
 }
 
 // trigger commands
@@ -505,32 +506,41 @@ void LissajousFrequencyPlayerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void LissajousFrequencyPlayerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int LissajousFrequencyPlayerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    if (isActive)
     {
-        for (int i = 0; i < numSamples; i++)
-        {
-            processSecondsClock();
-            
-            // just sequence through active shortcuts
-            if (isActive)
-            {
-                processShortcut(0, sampleCounter);
-            }
-
-            sampleCounter++;
-            
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
-            }
-        }
+        processShortcut(0, sampleCounter);
+    }
+    
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    if (isActive)
+    {
+        RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent);
+        RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent);
+    }
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop)) stop();
     }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
+    }
+    
+    return numSamples;
 }
 
 void LissajousFrequencyPlayerProcessor::PlayRepeater::processShortcut(int shortcutRef, int sampleRef)
@@ -1360,29 +1370,31 @@ void LissajousChordPlayerProcessor::setOversamplingFactor(int newFactor)
 void LissajousChordPlayerProcessor::processBlock (AudioBuffer<float>& buffer,
                            MidiBuffer& midiMessages)
 {
-    if (playState == PLAY_STATE::PLAYING)
-    {
-        repeater->tickBuffer(buffer.getNumSamples());
-    }
-    
-
-    if (isActive && !shouldMute)
-    {
-        if (waveformType == SAMPLER)
-        {
-            // FIXED: Redirect playing instruments to use synthesis instead of samples
-            wavetableSynth->processBlock(buffer, midiMessages);
-        }
-        else if (waveformType == WAVETABLE)
-        {
-            wavetableSynth->processBlock(buffer, midiMessages);
-        }
-        else
-        {
-            synth->processBlock(buffer, midiMessages);
-        }
-    }
-
+    // run the repeater and render the synth in the segments between its events
+    RepeaterScheduler::processBlock(buffer.getNumSamples(),
+                                    [this] (int maxSamples)
+                                    {
+                                        return playState == PLAY_STATE::PLAYING ? repeater->tickUntilNextEvent(maxSamples) : maxSamples;
+                                    },
+                                    [this, &buffer, &midiMessages] (int startSample, int numSamples)
+                                    {
+                                        if (isActive && !shouldMute)
+                                        {
+                                            if (waveformType == SAMPLER)
+                                            {
+                                                // FIXED: Redirect playing instruments to use synthesis instead of samples
+                                                wavetableSynth->renderNextBlock(buffer, midiMessages, startSample, numSamples);
+                                            }
+                                            else if (waveformType == WAVETABLE)
+                                            {
+                                                wavetableSynth->renderNextBlock(buffer, midiMessages, startSample, numSamples);
+                                            }
+                                            else
+                                            {
+                                                synth->renderNextBlock(buffer, midiMessages, startSample, numSamples);
+                                            }
+                                        }
+                                    });
 }
 
 // trigger commands
@@ -1867,44 +1879,54 @@ void LissajousChordPlayerProcessor::PlayRepeater::processSecondsClock()
     currentMS = sampleCounter / ( sampleRate / 1000) ;
 }
 
-void LissajousChordPlayerProcessor::PlayRepeater::tickBuffer(int numSamples)
+int LissajousChordPlayerProcessor::PlayRepeater::tickUntilNextEvent(int maxSamples)
 {
-    if (shouldProcess)
+    if (!shouldProcess)
+        return maxSamples;
+    
+    // events due on this sample fire before it is rendered
+    if (playSimultaneous)
+    {
+        processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
+    }
+    else
     {
-        for (int i = 0; i < numSamples; i++)
+        // just sequence through active shortcuts
+        if (isActive)
         {
-            processSecondsClock();
-            
-            if (playSimultaneous)
-            {
-                processSimultaneousShortcuts(currentPlayingShortcut, sampleCounter);
-            }
-            else
-            {
-                // just sequence through active shortcuts
-                if (isActive)
-                {
-                    processShortcut(currentPlayingShortcut, sampleCounter);
-                }
-            }
-            
-            sampleCounter++;
+            processShortcut(currentPlayingShortcut, sampleCounter);
+        }
+    }
+    
+    int nextEvent = RepeaterScheduler::noEvent;
+    
+    if (isActive)
+    {
+        RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOnEvent);
+        RepeaterScheduler::considerEvent(nextEvent, sampleCounter, nextNoteOffEvent);
+    }
+    
+    const int numSamples = RepeaterScheduler::samplesUntil(sampleCounter, nextEvent, totalNumSamplesOfLoop, maxSamples);
+    
+    sampleCounter += numSamples;
+    
+    processSecondsClock();
+    
+    if (playMode == PLAY_MODE::NORMAL)
+    {
+        if (sampleCounter >= (totalNumSamplesOfLoop))
+        {
+            currentMS = totalMSOfLoop;
             
-            if (playMode == PLAY_MODE::NORMAL)
-            {
-                if (sampleCounter >= (totalNumSamplesOfLoop))
-                {
-                    currentMS = totalMSOfLoop;
-                    
-                    stop();
-                }
-            }
-            else if (playMode == PLAY_MODE::LOOP)
-            {
-                if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
-            }
+            stop();
         }
     }
+    else if (playMode == PLAY_MODE::LOOP)
+    {
+        if (sampleCounter >= totalNumSamplesOfLoop) resetTick();
+    }
+    
+    return numSamples;
 }
 
 void LissajousChordPlayerProcessor::PlayRepeater::processShortcut(int shortcutRef, int sampleRef)
@@ -25,6 +25,7 @@
 #include "SamplerProcessor.h"
 #include "VotanSynthProcessor.h"
 #include "WavetableSynthProcessor.h"
+#include "RepeaterScheduler.h"
 
 class LissajousFrequencyPlayerProcessor : public AudioProcessor
 {
@@ -101,7 +102,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
@@ -270,7 +271,7 @@ public:
         ~PlayRepeater();
         
         void prepareToPlay(double newSampleRate);
-        void tickBuffer(int numSamples);
+        int tickUntilNextEvent(int maxSamples);
         void play();
         void stop();
         
@@ -13,6 +13,7 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "MainComponent.h"
+#include "OfflineScanRenderer.h"
 
 //==============================================================================
 class TSSApplication  : public JUCEApplication
@@ -31,6 +32,18 @@ public:
         // Setup error logging to file ("1_Add Error Log")
         initialiseErrorLogging();
 
+        // --render-scan runs a scan to a file without opening a window
+        if (OfflineScanRenderer::isRenderCommand (commandLine))
+        {
+            Logger::writeToLog("TSSApplication::initialise - offline scan render");
+            offlineRenderer = std::make_unique<OfflineScanRenderer>(commandLine, [this] (int exitCode)
+            {
+                setApplicationReturnValue(exitCode);
+                quit();
+            });
+            return;
+        }
+
         Logger::writeToLog("TSSApplication::initialise - starting main window");
         try
         {
@@ -48,6 +61,7 @@ public:
     {
         Logger::writeToLog("TSSApplication::shutdown - destroying main window");
         mainWindow.reset(); // (deletes our window)
+        offlineRenderer.reset();
 
         Logger::writeToLog("TSSApplication::shutdown - clearing logger");
         Logger::setCurrentLogger(nullptr);
@@ -200,6 +214,7 @@ private:
     }
     
     std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<OfflineScanRenderer> offlineRenderer;
     
     
 };
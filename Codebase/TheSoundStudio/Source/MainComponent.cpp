@@ -35,6 +35,9 @@ MainComponent::MainComponent()
     mainViewComponent = std::make_unique<MainViewComponent>(projectManager.get());
     
     addAndMakeVisible(mainViewComponent.get());
+    
+    callbackProfilerOverlay = std::make_unique<CallbackProfilerOverlay>(projectManager->callbackProfiler);
+    addAndMakeVisible(callbackProfilerOverlay.get());
 
     projectManager->setMainComponent(this);
     
@@ -58,6 +61,7 @@ MainComponent::~MainComponent()
     //    because many UI components unregister from ProjectManager in their destructors.
     if (mainViewComponent)
         mainViewComponent.reset();
+    callbackProfilerOverlay.reset();
     // 3) Now it is safe to destroy the ProjectManager
     if (projectManager)
         projectManager.reset();
@@ -16,6 +16,7 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "MainViewComponent.h"
 #include "ProjectManager.h"
+#include "CallbackProfilerOverlay.h"
 #include "ResponsiveUIHelper.h"
 #include "UI/DesignSystem.h"
 
@@ -52,6 +53,12 @@ public:
             mainViewComponent->setBounds(bounds);
             mainViewComponent->setScale(scaleFactor);
         }
+        
+        if (callbackProfilerOverlay)
+        {
+            callbackProfilerOverlay->setTopLeftPosition(bounds.getRight() - callbackProfilerOverlay->getWidth() - TSS::Design::Spacing::xs,
+                                                        bounds.getBottom() - callbackProfilerOverlay->getHeight() - TSS::Design::Spacing::xs);
+        }
     }
     
     float scaleFactor = 1.0f;
@@ -74,6 +81,8 @@ public:
     std::unique_ptr<MainViewComponent> mainViewComponent;
     
     std::unique_ptr<ProjectManager> projectManager;
+    
+    std::unique_ptr<CallbackProfilerOverlay> callbackProfilerOverlay;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
@@ -0,0 +1,627 @@
+/*
+  ==============================================================================
+
+    OfflineScanRenderer.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "OfflineScanRenderer.h"
+#include "ProjectManager.h"
+#include <iostream>
+
+static std::unique_ptr<AudioFormatWriter> createWavWriter (const File& file, double sampleRate, int numChannels, int bitDepth)
+{
+    file.deleteFile();
+
+    auto stream = std::make_unique<FileOutputStream> (file);
+
+    if (! stream->openedOk())
+        return {};
+
+    WavAudioFormat wavFormat;
+    std::unique_ptr<AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), sampleRate, (unsigned int) numChannels, bitDepth, {}, 0));
+
+    // the writer owns the stream once it exists
+    if (writer != nullptr)
+        stream.release();
+
+    return writer;
+}
+
+static var parseParameterValue (const String& text)
+{
+    const auto value = text.trim();
+
+    if (value.equalsIgnoreCase ("true"))    return true;
+    if (value.equalsIgnoreCase ("false"))   return false;
+
+    if (value.isNotEmpty() && value.containsOnly ("-0123456789"))
+        return value.getIntValue();
+
+    if (value.isNotEmpty() && value.containsOnly ("-+0123456789.eE"))
+        return value.getDoubleValue();
+
+    return value;
+}
+
+//=============================================================
+// Part
+//=============================================================
+// One ProjectManager rendering its scan range into a file on its own thread
+class OfflineScanRenderer::Part : public Thread
+{
+public:
+    Part (std::unique_ptr<ProjectManager> pm, const File& fileToWrite, const Settings& settings, int bitDepthToWrite,
+          int64 scanSamples, int64 tailSamples)
+        : Thread ("Offline Scan Render"),
+          projectManager (std::move (pm)),
+          file (fileToWrite),
+          numScanSamples (scanSamples),
+          numTailSamples (tailSamples),
+          sampleRate (settings.sampleRate),
+          blockSize (settings.blockSize),
+          numChannels (settings.numChannels),
+          bitDepth (bitDepthToWrite)
+    {
+    }
+
+    ~Part() override
+    {
+        stopThread (10000);
+    }
+
+    void run() override
+    {
+        auto writer = createWavWriter (file, sampleRate, numChannels, bitDepth);
+
+        if (writer == nullptr)
+        {
+            error = "Cannot write " + file.getFullPathName();
+            return;
+        }
+
+        // a live run starts long after the synths built their first tables, the render
+        // would otherwise start with however much silence the builder thread took
+        if (! projectManager->chordScannerProcessor->wavetableSynth->waitForWaveTables (waveTableTimeoutMs)
+            || ! projectManager->frequencyScannerProcessor->wavetableSynth->waitForWaveTables (waveTableTimeoutMs))
+        {
+            error = "Timed out waiting for the wavetables to be built";
+            return;
+        }
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+
+        const int64 numSamplesToRender = getNumSamplesToRender();
+
+        for (int64 position = 0; position < numSamplesToRender;)
+        {
+            if (threadShouldExit())
+            {
+                error = "Render cancelled";
+                return;
+            }
+
+            const int numSamples = (int) jmin ((int64) blockSize, numSamplesToRender - position);
+
+            buffer.setSize (numChannels, numSamples, false, false, true);
+            buffer.clear();
+
+            projectManager->getNextAudioBlock (AudioSourceChannelInfo (&buffer, 0, numSamples));
+
+            if (! writer->writeFromAudioSampleBuffer (buffer, 0, numSamples))
+            {
+                error = "Failed writing " + file.getFullPathName();
+                return;
+            }
+
+            projectManager->logFileWriter->waitUntilEventsWritten();
+
+            position += numSamples;
+            numSamplesRendered.store (position);
+        }
+
+        succeeded = true;
+    }
+
+    int64 getNumSamplesToRender() const     { return numScanSamples + numTailSamples; }
+    int64 getNumSamplesRendered() const     { return numSamplesRendered.load(); }
+
+    // valid once the thread has finished
+    bool hasSucceeded() const               { return succeeded; }
+    const String& getError() const          { return error; }
+
+    std::unique_ptr<ProjectManager> projectManager;
+    const File  file;
+    const int64 numScanSamples;             // up to the start of the next part
+    const int64 numTailSamples;             // release of the last chord, overlaps the next part
+
+private:
+    static constexpr int waveTableTimeoutMs = 10000;
+
+    const double sampleRate;
+    const int    blockSize;
+    const int    numChannels;
+    const int    bitDepth;
+
+    std::atomic<int64> numSamplesRendered { 0 };
+    bool succeeded = false;
+    String error;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Part)
+};
+
+//=============================================================
+// Offline Scan Renderer
+//=============================================================
+bool OfflineScanRenderer::isRenderCommand (const String& commandLine)
+{
+    return ArgumentList ("TheSoundStudio", commandLine).containsOption ("--render-scan");
+}
+
+OfflineScanRenderer::OfflineScanRenderer (const String& commandLine, std::function<void (int)> finishedCallback)
+    : onFinished (std::move (finishedCallback))
+{
+    String error;
+
+    if (! parseCommandLine (commandLine, error))
+    {
+        printUsage();
+        finish (1, error);
+        return;
+    }
+
+    if (! createParts (error))
+    {
+        finish (1, error);
+        return;
+    }
+
+    std::cout << "Rendering " << (settings.mode == MODE_CHORD_SCANNER ? "chord" : "frequency") << " scan to "
+              << settings.outputFile.getFullPathName() << " in " << parts.size() << " part(s)" << std::endl;
+
+    for (auto* part : parts)
+        part->startThread();
+
+    startTimer (500);
+}
+
+OfflineScanRenderer::~OfflineScanRenderer()
+{
+    stopTimer();
+
+    // stops the render threads before their ProjectManagers go
+    parts.clear();
+}
+
+bool OfflineScanRenderer::parseCommandLine (const String& commandLine, String& error)
+{
+    ArgumentList args ("TheSoundStudio", commandLine);
+
+    const auto scanType = args.getValueForOption ("--render-scan");
+
+    if      (scanType == "chord")       settings.mode = MODE_CHORD_SCANNER;
+    else if (scanType == "frequency")   settings.mode = MODE_FREQUENCY_SCANNER;
+    else
+    {
+        error = "--render-scan takes chord or frequency";
+        return false;
+    }
+
+    const auto workingDirectory = File::getCurrentWorkingDirectory();
+    const auto outputPath       = args.getValueForOption ("--output").unquoted();
+
+    if (outputPath.isEmpty())
+    {
+        error = "--output is required";
+        return false;
+    }
+
+    settings.outputFile = workingDirectory.getChildFile (outputPath);
+
+    if (args.containsOption ("--profile"))
+    {
+        settings.profileFile = workingDirectory.getChildFile (args.getValueForOption ("--profile").unquoted());
+
+        if (! settings.profileFile.existsAsFile())
+        {
+            error = "Profile not found: " + settings.profileFile.getFullPathName();
+            return false;
+        }
+    }
+
+    if (args.containsOption ("--log-dir"))
+        settings.logDirectory = workingDirectory.getChildFile (args.getValueForOption ("--log-dir").unquoted());
+    else
+        settings.logDirectory = settings.outputFile.getSiblingFile (settings.outputFile.getFileNameWithoutExtension() + "-logs");
+
+    const auto readInt = [&args] (const char* option, int& value)
+    {
+        if (args.containsOption (option))
+            value = args.getValueForOption (option).getIntValue();
+    };
+
+    if (args.containsOption ("--sample-rate"))
+        settings.sampleRate = args.getValueForOption ("--sample-rate").getDoubleValue();
+
+    readInt ("--block-size",    settings.blockSize);
+    readInt ("--channels",      settings.numChannels);
+    readInt ("--bit-depth",     settings.bitDepth);
+    readInt ("--tail-ms",       settings.tailMs);
+    readInt ("--jobs",          settings.numJobs);
+
+    if (settings.sampleRate < 8000.0 || settings.sampleRate > 768000.0)     { error = "--sample-rate is out of range"; return false; }
+    if (settings.blockSize < 16 || settings.blockSize > 16384)              { error = "--block-size must be 16 to 16384"; return false; }
+    if (settings.numChannels < 1 || settings.numChannels > 8)               { error = "--channels must be 1 to 8"; return false; }
+    if (settings.bitDepth != 16 && settings.bitDepth != 24 && settings.bitDepth != 32) { error = "--bit-depth must be 16, 24 or 32"; return false; }
+    if (settings.tailMs < 0)                                                { error = "--tail-ms cannot be negative"; return false; }
+    if (settings.numJobs < 1 || settings.numJobs > 64)                      { error = "--jobs must be 1 to 64"; return false; }
+
+    // --set NAME=VALUE, any number of times
+    for (int i = 0; i < args.size(); ++i)
+    {
+        String assignment;
+
+        if (args[i].text == "--set" && i + 1 < args.size())
+            assignment = args[++i].text;
+        else if (args[i].text.startsWith ("--set="))
+            assignment = args[i].text.fromFirstOccurrenceOf ("=", false, false);
+        else
+            continue;
+
+        const auto name = assignment.upToFirstOccurrenceOf ("=", false, false).trim();
+
+        if (name.isEmpty() || ! assignment.contains ("="))
+        {
+            error = "--set takes PARAMETER_NAME=value, got " + assignment;
+            return false;
+        }
+
+        settings.parameters.set (name, assignment.fromFirstOccurrenceOf ("=", false, false).unquoted());
+    }
+
+    return true;
+}
+
+bool OfflineScanRenderer::createParts (String& error)
+{
+    const bool wantsSplit = settings.numJobs > 1;
+
+    const auto logDirectoryForPart = [this, wantsSplit] (int partIndex)
+    {
+        return wantsSplit ? settings.logDirectory.getChildFile ("part-" + String (partIndex + 1)) : settings.logDirectory;
+    };
+
+    auto first = createProjectManager (logDirectoryForPart (0), error);
+
+    if (first == nullptr)
+        return false;
+
+    // contiguous octave ranges, each as [from, to + 1) in parameter values
+    Array<Range<int>> octaveRanges;
+
+    if (wantsSplit && settings.mode == MODE_CHORD_SCANNER)
+    {
+        const int scanMode = getParameter (*first, CHORD_SCANNER_MODE);
+
+        if (scanMode == SCAN_ALL_CHORDS || scanMode == SCAN_SPECIFIC_RANGE)
+        {
+            const int octaveFrom    = getParameter (*first, CHORD_SCANNER_OCTAVE_FROM);
+            const int numOctaves    = (int) getParameter (*first, CHORD_SCANNER_OCTAVE_TO) - octaveFrom + 1;
+            const int numParts      = jmin (settings.numJobs, numOctaves);
+
+            for (int p = 0; p < numParts; ++p)
+                octaveRanges.add ({ octaveFrom + p * numOctaves / numParts, octaveFrom + (p + 1) * numOctaves / numParts });
+        }
+    }
+
+    if (wantsSplit && octaveRanges.size() < 2)
+        std::cout << "This scan cannot be split into octave ranges, rendering it as one part" << std::endl;
+
+    const int numParts          = jmax (1, octaveRanges.size());
+    const int64 numTailSamples  = (int64) (settings.sampleRate * settings.tailMs / 1000.0);
+
+    for (int p = 0; p < numParts; ++p)
+    {
+        auto projectManager = p == 0 ? std::move (first) : createProjectManager (logDirectoryForPart (p), error);
+
+        if (projectManager == nullptr)
+            return false;
+
+        if (numParts > 1)
+        {
+            setParameter (*projectManager, CHORD_SCANNER_OCTAVE_FROM,  octaveRanges[p].getStart());
+            setParameter (*projectManager, CHORD_SCANNER_OCTAVE_TO,    octaveRanges[p].getEnd() - 1);
+        }
+
+        // there is no device to drain them, and the loop length depends on them
+        projectManager->applyPendingParameterChanges();
+
+        projectManager->prepareToPlay (settings.blockSize, settings.sampleRate);
+        projectManager->setPlayerPlayMode (PLAY_MODE::NORMAL);
+        projectManager->setPlayerCommand (COMMAND_PLAYER_PLAYPAUSE);
+
+        const uint64 numScanSamples = settings.mode == MODE_CHORD_SCANNER
+                                    ? projectManager->chordScannerProcessor->repeater->getTotalNumSamplesOfLoop()
+                                    : projectManager->frequencyScannerProcessor->repeater->getTotalNumSamplesOfLoop();
+
+        if (numScanSamples == 0)
+        {
+            error = "The scan is empty, check its range, duration and number of repeats";
+            return false;
+        }
+
+        // parts are joined later, so they keep full float resolution until then
+        const auto file = numParts == 1 ? settings.outputFile
+                                        : settings.outputFile.getSiblingFile (settings.outputFile.getFileNameWithoutExtension()
+                                                                              + ".part" + String (p + 1) + ".wav");
+
+        parts.add (new Part (std::move (projectManager), file, settings, numParts == 1 ? settings.bitDepth : 32,
+                             (int64) numScanSamples, numTailSamples));
+    }
+
+    return true;
+}
+
+std::unique_ptr<ProjectManager> OfflineScanRenderer::createProjectManager (const File& logDirectory, String& error)
+{
+    std::unique_ptr<ProjectManager> projectManager;
+
+    try
+    {
+        projectManager = std::make_unique<ProjectManager>();
+    }
+    catch (const std::exception& e)
+    {
+        error = String ("Could not create the project: ") + e.what();
+        return {};
+    }
+
+    // the scan's log file is created when the mode is set
+    logDirectory.createDirectory();
+    projectManager->setDirectoryFileForSettingParameter (LOG_FILE_LOCATION, logDirectory);
+
+    // offline blocks have no device deadline to miss
+    projectManager->callbackProfiler.setEnabled (false);
+
+    projectManager->setMode (settings.mode);
+
+    if (! applyParameters (*projectManager, error))
+        return {};
+
+    return projectManager;
+}
+
+bool OfflineScanRenderer::applyParameters (ProjectManager& projectManager, String& error)
+{
+    const bool isChordScan  = settings.mode == MODE_CHORD_SCANNER;
+    const int numParameters = isChordScan ? TOTAL_NUM_CHORD_SCANNER_PARAMS : TOTAL_NUM_FREQUENCY_SCANNER_PARAMS;
+
+    const auto getIdentifier = [&projectManager, isChordScan] (int index)
+    {
+        return isChordScan ? projectManager.getIdentifierForChordScannerParameterIndex (index)
+                           : projectManager.getIdentifierForFrequencyScannerParameterIndex (index);
+    };
+
+    // the same checks as loading a profile in the app
+    if (settings.profileFile != File())
+    {
+        FileInputStream stream (settings.profileFile);
+        const auto profile = ValueTree::readFromStream (stream);
+
+        if (profile.getNumProperties() != numParameters)
+        {
+            error = settings.profileFile.getFileName() + " is not a " + (isChordScan ? "Chord" : "Frequency") + " Scanner profile";
+            return false;
+        }
+
+        for (int index = 0; index < numParameters; ++index)
+            setParameter (projectManager, index, profile.getProperty (getIdentifier (index)));
+    }
+
+    for (const auto& name : settings.parameters.getAllKeys())
+    {
+        int index = 0;
+
+        while (index < numParameters && getIdentifier (index) != name)
+            ++index;
+
+        if (index == numParameters)
+        {
+            error = "Unknown parameter " + name;
+            return false;
+        }
+
+        setParameter (projectManager, index, parseParameterValue (settings.parameters[name]));
+    }
+
+    return true;
+}
+
+void OfflineScanRenderer::setParameter (ProjectManager& projectManager, int index, const var& value)
+{
+    if (settings.mode == MODE_CHORD_SCANNER)
+        projectManager.setChordScannerParameter (index, value);
+    else
+        projectManager.setFrequencyScannerParameter (index, value);
+}
+
+var OfflineScanRenderer::getParameter (ProjectManager& projectManager, int index)
+{
+    return settings.mode == MODE_CHORD_SCANNER ? projectManager.getChordScannerParameter (index)
+                                               : projectManager.getFrequencyScannerParameter (index);
+}
+
+void OfflineScanRenderer::timerCallback()
+{
+    int64 numRendered   = 0;
+    int64 numToRender   = 0;
+    bool isRendering    = false;
+
+    for (auto* part : parts)
+    {
+        numRendered += part->getNumSamplesRendered();
+        numToRender += part->getNumSamplesToRender();
+        isRendering = isRendering || part->isThreadRunning();
+    }
+
+    const int percent = numToRender > 0 ? (int) (100 * numRendered / numToRender) : 100;
+
+    if (percent != lastReportedPercent)
+    {
+        std::cout << "\rRendering: " << percent << "%" << std::flush;
+        lastReportedPercent = percent;
+    }
+
+    if (isRendering)
+        return;
+
+    stopTimer();
+    std::cout << std::endl;
+
+    for (auto* part : parts)
+    {
+        if (! part->hasSucceeded())
+        {
+            finish (1, part->getError());
+            return;
+        }
+    }
+
+    String error;
+
+    if (parts.size() > 1 && ! joinParts (error))
+    {
+        finish (1, error);
+        return;
+    }
+
+    finish (0, "Rendered " + settings.outputFile.getFullPathName() + ", logs in " + settings.logDirectory.getFullPathName());
+}
+
+// Writes every part up to the start of the next one, mixing its tail into the next part
+bool OfflineScanRenderer::joinParts (String& error)
+{
+    auto writer = createWavWriter (settings.outputFile, settings.sampleRate, settings.numChannels, settings.bitDepth);
+
+    if (writer == nullptr)
+    {
+        error = "Cannot write " + settings.outputFile.getFullPathName();
+        return false;
+    }
+
+    const int numChannels   = settings.numChannels;
+    const int blockSize     = 1 << 16;
+    const int maxTail       = (int) parts.getFirst()->numTailSamples;
+
+    AudioBuffer<float> block (numChannels, blockSize);
+    AudioBuffer<float> tail (numChannels, jmax (1, maxTail));
+    AudioBuffer<float> nextTail (numChannels, jmax (1, maxTail));
+    int tailLength = 0;
+
+    WavAudioFormat wavFormat;
+
+    for (int p = 0; p < parts.size(); ++p)
+    {
+        auto* part = parts[p];
+
+        std::unique_ptr<AudioFormatReader> reader (wavFormat.createReaderFor (new FileInputStream (part->file), true));
+
+        if (reader == nullptr)
+        {
+            error = "Cannot read " + part->file.getFullPathName();
+            return false;
+        }
+
+        const int64 length  = reader->lengthInSamples;
+        const int64 keep    = p == parts.size() - 1 ? length : jmin (length, part->numScanSamples);
+
+        nextTail.clear();
+        int nextTailLength = 0;
+
+        // anything past keep carries over, at most maxTail samples
+        const auto carryOver = [&] (const AudioBuffer<float>& source, int sourceStart, int64 position, int numSamples)
+        {
+            const int destStart = (int) (position - keep);
+            const int num       = jmin (numSamples, maxTail - destStart);
+
+            if (num <= 0)
+                return;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                nextTail.addFrom (ch, destStart, source, ch, sourceStart, num);
+
+            nextTailLength = jmax (nextTailLength, destStart + num);
+        };
+
+        for (int64 position = 0; position < length;)
+        {
+            const int numSamples = (int) jmin ((int64) blockSize, length - position);
+
+            reader->read (&block, 0, numSamples, position, true, true);
+
+            if (position < tailLength)
+            {
+                const int numFromTail = (int) jmin ((int64) numSamples, tailLength - position);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    block.addFrom (ch, 0, tail, ch, (int) position, numFromTail);
+            }
+
+            const int numToWrite = (int) jlimit ((int64) 0, (int64) numSamples, keep - position);
+
+            if (! writer->writeFromAudioSampleBuffer (block, 0, numToWrite))
+            {
+                error = "Failed writing " + settings.outputFile.getFullPathName();
+                return false;
+            }
+
+            carryOver (block, numToWrite, position + numToWrite, numSamples - numToWrite);
+
+            position += numSamples;
+        }
+
+        // a previous tail longer than this whole part
+        if (tailLength > length)
+            carryOver (tail, (int) length, length, (int) (tailLength - length));
+
+        std::swap (tail, nextTail);
+        tailLength = nextTailLength;
+
+        reader.reset();
+        part->file.deleteFile();
+    }
+
+    if (tailLength > 0 && ! writer->writeFromAudioSampleBuffer (tail, 0, tailLength))
+    {
+        error = "Failed writing " + settings.outputFile.getFullPathName();
+        return false;
+    }
+
+    return true;
+}
+
+void OfflineScanRenderer::finish (int exitCode, const String& message)
+{
+    (exitCode == 0 ? std::cout : std::cerr) << message << std::endl;
+    Logger::writeToLog ("OfflineScanRenderer - " + message);
+
+    MessageManager::callAsync ([callback = onFinished, exitCode]
+    {
+        if (callback != nullptr)
+            callback (exitCode);
+    });
+}
+
+void OfflineScanRenderer::printUsage()
+{
+    std::cout << "Usage: TheSoundStudio --render-scan chord|frequency --output scan.wav" << std::endl
+              << "         [--profile saved.profile] [--set PARAMETER_NAME=value ...]" << std::endl
+              << "         [--sample-rate 44100] [--block-size 512] [--channels 2] [--bit-depth 16|24|32]" << std::endl
+              << "         [--tail-ms 2000] [--jobs 1] [--log-dir dir]" << std::endl;
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    OfflineScanRenderer.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Parameters.h"
+
+class ProjectManager;
+
+//=============================================================
+// Offline Scan Renderer
+//=============================================================
+// Headless mode for the Chord Scanner and Frequency Scanner. The scan is driven by the
+// same ProjectManager, processors and repeaters as the app, but the audio callback is
+// pulled in a loop instead of by a device, so it runs as fast as the machine allows. The
+// audio goes to a WAV file and the usual sequencer logs to a log directory.
+//
+//   TheSoundStudio --render-scan chord|frequency --output scan.wav
+//                  [--profile saved.profile] [--set PARAMETER_NAME=value ...]
+//                  [--sample-rate 44100] [--block-size 512] [--channels 2]
+//                  [--bit-depth 16|24|32] [--tail-ms 2000] [--jobs 1] [--log-dir dir]
+//
+// Parameters take the names of the mode's parameter identifiers, e.g.
+// --set CHORD_SCANNER_MODE=1 --set CHORD_SCANNER_OCTAVE_TO=6.
+//
+// With --jobs, chord scans that walk an octave range (all chords, specific range) are
+// split into contiguous octave ranges rendered by one ProjectManager each. Every part
+// renders the release tail of its last chord, and the tail is mixed into the start of the
+// next part when the parts are joined, so the file matches a single pass. Other scans
+// always render as one part.
+class OfflineScanRenderer : private Timer
+{
+public:
+    static bool isRenderCommand (const String& commandLine);
+
+    // Message thread. onFinished is called back on the message thread with the exit code.
+    OfflineScanRenderer (const String& commandLine, std::function<void (int)> onFinished);
+    ~OfflineScanRenderer() override;
+
+private:
+    struct Settings
+    {
+        AUDIO_MODE  mode            = MODE_CHORD_SCANNER;
+        File        outputFile;
+        File        profileFile;
+        File        logDirectory;
+        StringPairArray parameters;
+
+        double      sampleRate      = 44100.0;
+        int         blockSize       = 512;
+        int         numChannels     = 2;
+        int         bitDepth        = 24;
+        int         tailMs          = 2000;
+        int         numJobs         = 1;
+    };
+
+    class Part;
+
+    bool parseCommandLine (const String& commandLine, String& error);
+    bool createParts (String& error);
+    std::unique_ptr<ProjectManager> createProjectManager (const File& logDirectory, String& error);
+    bool applyParameters (ProjectManager& projectManager, String& error);
+    void setParameter (ProjectManager& projectManager, int index, const var& value);
+    var getParameter (ProjectManager& projectManager, int index);
+
+    void timerCallback() override;
+    bool joinParts (String& error);
+    void finish (int exitCode, const String& message);
+
+    static void printUsage();
+
+    Settings settings;
+    OwnedArray<Part> parts;
+    std::function<void (int)> onFinished;
+    int lastReportedPercent = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineScanRenderer)
+};
@@ -14,7 +14,7 @@
 #pragma once
 #include <cmath>
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "LUTs.h"
+#include "BLEPTables.h"
 
 
 // C++17: Replace macros with constexpr constants for better type safety
@@ -312,11 +312,11 @@ private:
         
         if (frequency <= sampleRate / 8.0)
         {
-            sawOut = trivialSaw + doBLEP(&dBLEPTable_8_BLKHAR[0], 4096, _modulo, fabs(_inc), 1.0, false, 4, false);
+            sawOut = trivialSaw + doBLEP(BLEPTables::get().getEightPointBlackmanHarrisTable(), BLEPTables::tableLength, _modulo, fabs(_inc), 1.0, false, 4, false);
         }
         else
         {
-            sawOut = trivialSaw + doBLEP(&dBLEPTable[0], 4096, _modulo, fabs(_inc), 1.0, false, 1, true);
+            sawOut = trivialSaw + doBLEP(BLEPTables::get().getTwoPointTable(), BLEPTables::tableLength, _modulo, fabs(_inc), 1.0, false, 1, true);
         }
         
         return sawOut;
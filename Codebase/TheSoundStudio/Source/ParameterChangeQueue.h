@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    ParameterChangeQueue.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Parameters.h"
+#include "utilities/spsc_queue.h"
+#include <atomic>
+#include <memory>
+
+// Parameter changes on their way from the message thread to the audio processors.
+// ProjectManager posts one per processor setParameter call it used to make directly,
+// and applies them all at the top of the next audio block, so a processor's state
+// only ever changes between its own processBlock calls.
+//
+// Every processor parameter is a number, a bool or an enum, so a change is carried as
+// a double and handed back to setParameter as a var of that double; nothing on either
+// side allocates.
+//
+// Changes are kept per parameter: posting to a parameter whose last change hasn't been
+// applied yet only replaces its value, and the parameter keeps its place in the order.
+// The queue therefore never holds more than one entry per parameter, and can't fill
+// up however many changes are posted before anything applies them.
+class ParameterChangeQueue
+{
+public:
+    enum Target : int
+    {
+        CHORD_PLAYER = 0,
+        CHORD_PLAYER_ACTIVE_SHORTCUT,       // setActiveShortcutSynth, index unused
+        CHORD_SCANNER,
+        FREQUENCY_PLAYER,
+        FREQUENCY_PLAYER_ACTIVE_SHORTCUT,
+        FREQUENCY_SCANNER,
+        LISSAJOUS,
+        NUM_TARGETS
+    };
+
+    struct Change
+    {
+        Target  target      = CHORD_PLAYER;
+        int     shortcut    = 0;
+        int     index       = 0;
+        double  value       = 0.0;
+    };
+
+    ParameterChangeQueue()
+    {
+        for (int target = 0; target < NUM_TARGETS; ++target)
+        {
+            firstSlots[target] = numSlots;
+            numSlots += getNumShortcuts ((Target) target) * getNumIndices ((Target) target);
+        }
+
+        slots.reset (new Slot[(size_t) numSlots]);
+
+        for (int target = 0; target < NUM_TARGETS; ++target)
+            for (int shortcut = 0; shortcut < getNumShortcuts ((Target) target); ++shortcut)
+                for (int index = 0; index < getNumIndices ((Target) target); ++index)
+                    slots[getSlotIndex ((Target) target, shortcut, index)].change = { (Target) target, shortcut, index, 0.0 };
+
+        pendingSlots = std::make_unique<audio_devs::spsc_queue<int>> ((size_t) numSlots);
+    }
+
+    // Message thread. False only for a parameter the queue has no slot for
+    bool post (Target target, int shortcut, int index, const var& value)
+    {
+        jassert (value.isVoid() || value.isBool() || value.isInt() || value.isInt64() || value.isDouble());
+
+        const int slotIndex = getSlotIndex (target, shortcut, index);
+
+        if (slotIndex < 0)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        auto& slot = slots[slotIndex];
+        slot.value.store ((double) value);
+
+        // queued once until the consumer takes it back out
+        if (! slot.pending.exchange (true))
+        {
+            const bool queued = pendingSlots->try_push (slotIndex);
+            jassert (queued);
+            ignoreUnused (queued);
+        }
+
+        return true;
+    }
+
+    // The audio thread, or whoever drives the processors while there is no device.
+    // Applies each changed parameter's latest value, in the order the parameters first
+    // changed.
+    template <typename Function>
+    int applyPending (Function&& apply)
+    {
+        int numApplied = 0;
+        int slotIndex = 0;
+
+        while (pendingSlots->try_pop (slotIndex))
+        {
+            auto& slot = slots[slotIndex];
+
+            // cleared before the value is read, so a post that comes in now queues the
+            // slot again rather than getting lost
+            slot.pending.store (false);
+
+            Change change = slot.change;
+            change.value = slot.value.load();
+
+            apply (change);
+            ++numApplied;
+        }
+
+        return numApplied;
+    }
+
+private:
+    struct Slot
+    {
+        Change                  change;         // the slot's parameter, set up front
+        std::atomic<double>     value   { 0.0 };
+        std::atomic<bool>       pending { false };
+    };
+
+    static int getNumShortcuts (Target target) noexcept
+    {
+        switch (target)
+        {
+            case CHORD_PLAYER:
+            case CHORD_PLAYER_ACTIVE_SHORTCUT:
+            case FREQUENCY_PLAYER:
+            case FREQUENCY_PLAYER_ACTIVE_SHORTCUT:  return NUM_SHORTCUT_SYNTHS;
+            default:                                return 1;
+        }
+    }
+
+    static int getNumIndices (Target target) noexcept
+    {
+        switch (target)
+        {
+            case CHORD_PLAYER:                      return TOTAL_NUM_CHORD_PLAYER_SHORTCUT_PARAMS;
+            case CHORD_SCANNER:                     return TOTAL_NUM_CHORD_SCANNER_PARAMS;
+            case FREQUENCY_PLAYER:                  return TOTAL_NUM_FREQUENCY_PLAYER_SHORTCUT_PARAMS;
+            case FREQUENCY_SCANNER:                 return TOTAL_NUM_FREQUENCY_SCANNER_PARAMS;
+            case LISSAJOUS:                         return TOTAL_NUM_LISSAJOUS_CURVE_PARAMS;
+            default:                                return 1;
+        }
+    }
+
+    int getSlotIndex (Target target, int shortcut, int index) const noexcept
+    {
+        if (! isPositiveAndBelow ((int) target, (int) NUM_TARGETS))
+            return -1;
+
+        if (target == CHORD_PLAYER_ACTIVE_SHORTCUT || target == FREQUENCY_PLAYER_ACTIVE_SHORTCUT)
+            index = 0;
+
+        const int numIndices = getNumIndices (target);
+
+        if (! isPositiveAndBelow (shortcut, getNumShortcuts (target)) || ! isPositiveAndBelow (index, numIndices))
+            return -1;
+
+        return firstSlots[target] + shortcut * numIndices + index;
+    }
+
+    int firstSlots[NUM_TARGETS] {};
+    int numSlots = 0;
+
+    std::unique_ptr<Slot[]> slots;
+    std::unique_ptr<audio_devs::spsc_queue<int>> pendingSlots;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterChangeQueue)
+};
@@ -97,6 +97,8 @@ enum TSS_SETTINGS
     LOG_FILE_LOCATION,
     RECORD_FILE_LOCATION,
     RECORD_FILE_FORMAT,     // int / enum
+    RECORD_CHANNELS,        // int, RecordingManager channel mask
+    RECORD_FILE_PER_CHANNEL,// bool
     
     // double
     BASE_FREQUENCY_A,       // double // central pitch
@@ -156,6 +158,11 @@ enum TSS_SETTINGS
     PLUGIN_SELECTED_3,
     PLUGIN_SELECTED_4,
     
+    PLUGIN_OUTPUT_1, // AUDIO_OUTPUTS the slot processes | NO_OUTPUT = bypassed
+    PLUGIN_OUTPUT_2,
+    PLUGIN_OUTPUT_3,
+    PLUGIN_OUTPUT_4,
+    
     FREQUENCY_TO_CHORD, // Radio button 3
     
     MIXER_INPUT_GAIN_1,
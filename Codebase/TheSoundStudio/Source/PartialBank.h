@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    PartialBank.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+
+//=============================================================
+// Partial Bank
+//=============================================================
+// Additive sine bank for the instrument models of the wavetable voices. Every partial is
+// a recursive quadrature oscillator: its (cos, sin) state is rotated by a precomputed
+// complex coefficient each sample, so rendering costs a handful of multiplies per partial
+// and no transcendental calls at all. Partials are stored structure-of-arrays in SIMD
+// registers and run 4 or 8 lanes at a time, depending on what the build targets.
+//
+// Usage: clear(), addPartial() for each partial, prepare() with the note frequency (on
+// note on, or again when the frequency changes), reset() at the start of a note, then
+// render() every block. Partials at or above the Nyquist limit are muted, not aliased.
+class PartialBank
+{
+public:
+    using Lanes = dsp::SIMDRegister<float>;
+
+    static constexpr int numLanes       = (int) Lanes::SIMDNumElements;
+    static constexpr int maxPartials    = 16;
+    static constexpr int maxGroups      = (maxPartials + numLanes - 1) / numLanes;
+
+    PartialBank()
+    {
+        clear();
+        reset();
+    }
+
+    // Removes all partials. Oscillator phases are kept so a retune does not click.
+    void clear() noexcept
+    {
+        numPartials = 0;
+
+        for (int i = 0; i < maxPartials; ++i)
+        {
+            ratios[i] = 0.f;
+            levels[i] = 0.f;
+            decays[i] = 1.f;
+        }
+    }
+
+    // ratio to the fundamental, linear level and per-sample exponential decay (1 = none)
+    void addPartial (float ratio, float level, float decayPerSample = 1.f) noexcept
+    {
+        jassert (numPartials < maxPartials);
+
+        if (numPartials >= maxPartials)
+            return;
+
+        ratios[numPartials] = ratio;
+        levels[numPartials] = level;
+        decays[numPartials] = decayPerSample;
+        ++numPartials;
+    }
+
+    int getNumPartials() const noexcept { return numPartials; }
+
+    // Computes the rotation coefficients for the current partials. Not realtime critical,
+    // but it does not allocate, so it is fine to call from startNote().
+    void prepare (double frequency, double sampleRate) noexcept
+    {
+        const double nyquist = sampleRate * 0.5;
+
+        numGroups = (numPartials + numLanes - 1) / numLanes;
+
+        for (int i = 0; i < maxGroups * numLanes; ++i)
+        {
+            const int group = i / numLanes;
+            const auto lane = (size_t) (i % numLanes);
+
+            const double partialFrequency = frequency * (i < numPartials ? ratios[i] : 0.f);
+            const bool audible = i < numPartials && partialFrequency > 0.0 && partialFrequency < nyquist;
+
+            const double increment = audible ? MathConstants<double>::twoPi * partialFrequency / sampleRate : 0.0;
+
+            cosIncrement[group].set (lane, (float) std::cos (increment));
+            sinIncrement[group].set (lane, (float) std::sin (increment));
+            level[group].set (lane, audible ? levels[i] : 0.f);
+            decay[group].set (lane, i < numPartials ? decays[i] : 1.f);
+        }
+    }
+
+    // Restarts every partial at phase 0 (sine start, so no click) with full envelope
+    void reset() noexcept
+    {
+        for (int g = 0; g < maxGroups; ++g)
+        {
+            cosState[g] = Lanes::expand (1.f);
+            sinState[g] = Lanes::expand (0.f);
+            envelope[g] = Lanes::expand (1.f);
+        }
+    }
+
+    // Overwrites output with the sum of all partials
+    void render (float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            Lanes mix = Lanes::expand (0.f);
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                mix += sinState[g] * level[g] * envelope[g];
+
+                const Lanes c = cosState[g] * cosIncrement[g] - sinState[g] * sinIncrement[g];
+                sinState[g]   = cosState[g] * sinIncrement[g] + sinState[g] * cosIncrement[g];
+                cosState[g]   = c;
+
+                envelope[g] *= decay[g];
+            }
+
+            output[i] = mix.sum();
+        }
+
+        // The rotation is not exactly unit length in float, so pull every oscillator
+        // back onto the unit circle once a block (first order Newton step).
+        const Lanes threeHalves = Lanes::expand (1.5f);
+        const Lanes half        = Lanes::expand (0.5f);
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const Lanes correction = threeHalves - half * (cosState[g] * cosState[g] + sinState[g] * sinState[g]);
+            cosState[g] *= correction;
+            sinState[g] *= correction;
+        }
+    }
+
+private:
+    // what was asked for, one entry per partial
+    float ratios[maxPartials];
+    float levels[maxPartials];
+    float decays[maxPartials];
+    int   numPartials = 0;
+
+    // what gets rendered, numLanes partials per register
+    Lanes cosState[maxGroups];
+    Lanes sinState[maxGroups];
+    Lanes cosIncrement[maxGroups];
+    Lanes sinIncrement[maxGroups];
+    Lanes level[maxGroups];
+    Lanes envelope[maxGroups];
+    Lanes decay[maxGroups];
+    int   numGroups = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartialBank)
+};
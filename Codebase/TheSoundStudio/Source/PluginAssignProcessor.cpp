@@ -15,10 +15,27 @@
 //#include "PluginProcessor.h"
 
 PluginAssignProcessor::PluginAssignProcessor(AudioPluginFormatManager & _formatManager, KnownPluginList * pluginList):
+Thread("Plugin Loader"),
 formatManager(_formatManager),
 pluginList(pluginList)
 {
     hasPlugin = false;
+    
+    startThread();
+}
+
+PluginAssignProcessor::~PluginAssignProcessor()
+{
+    // a plugin that is still loading gets the whole time to finish, it can't be cancelled;
+    // the loader never waits on the message thread (see loadNewPlugin), so it will finish
+    stopThread(-1);
+    
+    cancelPendingUpdate();
+    stopTimer();
+    
+    // the audio callback has been removed by now, so nothing else can be using these
+    const ScopedLock sl(instanceLock);
+    ownedInstances.clear();
 }
 
 const String PluginAssignProcessor::getName() const
@@ -90,10 +107,22 @@ void PluginAssignProcessor::prepareToPlay (double sampleRate, int samplesPerBloc
     
     this->setPlayConfigDetails(getNumInputChannels(), getNumOutputChannels(), sampleRate, samplesPerBlock);
 
-    if (hasPlugin) {
-        instance->prepareToPlay(sampleRate, samplesPerBlock);
+    {
+        // the device is stopped, so every instance it could play is prepared, including
+        // the one fading out and one that was published but not picked up yet
+        const ScopedLock sl(instanceLock);
+        
+        for (auto* pluginInstance : ownedInstances)
+        {
+            pluginInstance->prepareToPlay(sampleRate, samplesPerBlock);
+        }
     }
-
+    
+    crossfadeLength = jmax(1, roundToInt(sampleRate * crossfadeSeconds));
+    
+    crossfadeBuffer     .setSize(2, samplesPerBlock);
+    stereoAdapterBuffer .setSize(2, samplesPerBlock);
+    fadingOutMidi       .ensureSize(2048);
 }
 
 bool PluginAssignProcessor::pluginIsLoaded()
@@ -101,132 +130,411 @@ bool PluginAssignProcessor::pluginIsLoaded()
     return hasPlugin;
 }
 
+bool PluginAssignProcessor::isLoading() const
+{
+    const ScopedLock sl(loadLock);
+    return requestedDescription != nullptr || requestInProgress != 0 || messageThreadRequest != 0 || loadedRequest != 0;
+}
+
+AudioPluginInstance* PluginAssignProcessor::emptySlot() noexcept
+{
+    // stands for "no plugin" in pendingInstance, where nullptr means no change
+    static char emptySlotTag;
+    return reinterpret_cast<AudioPluginInstance*>(&emptySlotTag);
+}
+
+//=============================================================
+// Audio thread
+//=============================================================
 void PluginAssignProcessor::processBlock (AudioBuffer<float>&buffer, MidiBuffer&midiBuffer)
 {
-    int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    // an instance that couldn't be queued last time is still ours to hand back
+    if (fadingOutInstance != nullptr && crossfadeSamplesRemaining == 0)
+    {
+        if (retiredInstances.try_push(fadingOutInstance))
+            fadingOutInstance = nullptr;
+    }
+    
+    if (fadingOutInstance == nullptr)
+    {
+        if (auto* next = pendingInstance.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            fadingOutInstance = activeInstance;
+            activeInstance = (next == emptySlot()) ? nullptr : next;
+            
+            crossfadeSamplesRemaining = crossfadeLength;
+        }
+    }
+    
+    const bool isCrossfading = crossfadeSamplesRemaining > 0;
+    
+    if (isCrossfading)
+    {
+        // the outgoing plugin runs on a copy of the same input, or passes it through if
+        // the slot was empty
+        crossfadeBuffer.setSize(buffer.getNumChannels(), numSamples, false, false, true);
+        
+        for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+        {
+            crossfadeBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+        }
+        
+        fadingOutMidi.clear();
+        processWithInstance(fadingOutInstance, crossfadeBuffer, fadingOutMidi);
+    }
+    
+    processWithInstance(activeInstance, buffer, midiBuffer);
+    
+    if (isCrossfading)
     {
-        if (hasPlugin && instance)
+        const int numToFade   = jmin(numSamples, crossfadeSamplesRemaining);
+        const float startGain = 1.0f - (float)crossfadeSamplesRemaining / (float)crossfadeLength;
+        const float endGain   = 1.0f - (float)(crossfadeSamplesRemaining - numToFade) / (float)crossfadeLength;
+        
+        for (int channel = 0; channel < buffer.getNumChannels(); channel++)
+        {
+            buffer.applyGainRamp(channel, 0, numToFade, startGain, endGain);
+            buffer.addFromWithRamp(channel, 0, crossfadeBuffer.getReadPointer(channel), numToFade, 1.0f - startGain, 1.0f - endGain);
+        }
+        
+        crossfadeSamplesRemaining -= numToFade;
+        
+        if (crossfadeSamplesRemaining == 0 && fadingOutInstance != nullptr)
         {
-            int bufNumChan = buffer.getNumChannels();
-            if (bufNumChan == 1)
-            {
-                // check if is stereo plugin
-                int numChan = instance->getNumInputChannels();
-                if (numChan > 1)
-                {
-                    AudioBuffer<float> stereoBuffer;
-                    stereoBuffer.setSize(2, buffer.getNumSamples());
-                    stereoBuffer.clear();
-                    stereoBuffer.copyFrom(0, 0, buffer, 0, 0, buffer.getNumSamples());
-                    stereoBuffer.copyFrom(1, 0, buffer, 0, 0, buffer.getNumSamples());
-
-                    instance->processBlock(stereoBuffer, midiBuffer);
-                    
-                    // add single channel back to main buffer
-                    buffer.copyFrom(0, 0, stereoBuffer, 0, 0, buffer.getNumSamples());
-
-                }
-                else
-                {
-                    instance->processBlock(buffer, midiBuffer);
-                }
-            }
-            else
-            {
-                if (buffer.getNumChannels() == 2)
-                {
-                    // check stereo
-                    instance->processBlock(buffer, midiBuffer);
-                }
-                else
-                {
-
-                }
-                
-            }
+            if (retiredInstances.try_push(fadingOutInstance))
+                fadingOutInstance = nullptr;
         }
     }
 }
 
+void PluginAssignProcessor::processWithInstance (AudioPluginInstance* pluginInstance, AudioBuffer<float>& buffer, MidiBuffer& midiBuffer)
+{
+    if (pluginInstance == nullptr)
+        return;
+    
+    const int numSamples = buffer.getNumSamples();
+    
+    if (buffer.getNumChannels() == 1)
+    {
+        if (pluginInstance->getTotalNumInputChannels() > 1)
+        {
+            // stereo plugin on a mono buffer: feed it both sides, keep the left
+            stereoAdapterBuffer.setSize(2, numSamples, false, false, true);
+            stereoAdapterBuffer.copyFrom(0, 0, buffer, 0, 0, numSamples);
+            stereoAdapterBuffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+            
+            pluginInstance->processBlock(stereoAdapterBuffer, midiBuffer);
+            
+            buffer.copyFrom(0, 0, stereoAdapterBuffer, 0, 0, numSamples);
+        }
+        else
+        {
+            pluginInstance->processBlock(buffer, midiBuffer);
+        }
+    }
+    else if (buffer.getNumChannels() == 2)
+    {
+        pluginInstance->processBlock(buffer, midiBuffer);
+    }
+}
+
+//=============================================================
+// Message thread
+//=============================================================
 bool PluginAssignProcessor::clearPlugin()
 {
-    suspendProcessing(true);
+    {
+        // forget anything still loading
+        const ScopedLock sl(loadLock);
+        latestRequest++;
+        requestedDescription = nullptr;
+        messageThreadRequest = 0;
+        loadedInstance = nullptr;
+        loadedRequest = 0;
+    }
     
-//    delete instance;
-    instance = nullptr;
-    hasPlugin = false;
+    publishInstance(nullptr);
     
-    suspendProcessing(false);
+    return true;
+}
+
+bool PluginAssignProcessor::loadNewPlugin(const PluginDescription& desc)
+{
+    if (desc.numInputChannels > 2 || desc.numOutputChannels > 2)
+    {
+        DBG("Plugin rejected: too many channels (In:" << desc.numInputChannels << ", Out:" << desc.numOutputChannels << ")");
+        return false;
+    }
+    
+    // formats like AU create their instances on the message thread; the loader thread
+    // would have to wait for it, and the destructor waits for the loader there
+    const bool createOnMessageThread = mustCreateOnMessageThread(desc);
+    int request;
     
-    if (instance == nullptr)
     {
+        // a newer request replaces one the loader hasn't started yet
+        const ScopedLock sl(loadLock);
+        request = ++latestRequest;
+        
+        if (createOnMessageThread)
+        {
+            requestedDescription = nullptr;
+            messageThreadRequest = request;
+        }
+        else
+        {
+            requestedDescription = std::make_unique<PluginDescription>(desc);
+        }
+    }
+    
+    if (! createOnMessageThread)
+    {
+        notify();
         return true;
-    } else  return false;
+    }
+    
+    const double sampleRate = getSampleRate();
+    const int blockSize = getBlockSize();
+    
+    WeakReference<PluginAssignProcessor> safeThis(this);
+    
+    formatManager.createPluginInstanceAsync(desc, sampleRate, blockSize,
+                                            [safeThis, desc, request, sampleRate, blockSize] (std::unique_ptr<AudioPluginInstance> newInstance, const String& errorMessage)
+                                            {
+                                                if (safeThis != nullptr)
+                                                    safeThis->instanceCreatedOnMessageThread(std::move(newInstance), desc, errorMessage, request, sampleRate, blockSize);
+                                            });
+    
+    return true;
 }
 
+bool PluginAssignProcessor::mustCreateOnMessageThread(const PluginDescription& desc) const
+{
+    for (int i = 0; i < formatManager.getNumFormats(); i++)
+    {
+        auto* format = formatManager.getFormat(i);
+        
+        if (format->getName() == desc.pluginFormatName)
+            return format->requiresUnblockedMessageThreadDuringCreation(desc);
+    }
+    
+    return false;
+}
 
-bool PluginAssignProcessor::loadNewPlugin(const PluginDescription* desc)
+void PluginAssignProcessor::instanceCreatedOnMessageThread(std::unique_ptr<AudioPluginInstance> newInstance, const PluginDescription& desc,
+                                                           String errorMessage, int request, double sampleRate, int blockSize)
 {
-    // FIXED: Comprehensive error handling and input validation
-    if (desc == nullptr) {
-        DBG("PluginAssignProcessor::loadNewPlugin - null description provided");
-        return false;
+    if (newInstance == nullptr)
+    {
+        DBG("Failed to create plugin instance: " << errorMessage);
+    }
+    else if (! prepareInstance(*newInstance, desc, sampleRate, blockSize, errorMessage))
+    {
+        newInstance = nullptr;
     }
     
-    try {
-        suspendProcessing(true);
+    {
+        const ScopedLock sl(loadLock);
         
-        // Clear existing plugin safely
-        if (hasPlugin && instance != nullptr) {
-            instance = nullptr;
-            hasPlugin = false;
-        }
+        if (messageThreadRequest == request)
+            messageThreadRequest = 0;
+        
+        // loadNewPlugin or clearPlugin was called again meanwhile
+        if (request != latestRequest)
+            return;
         
-        // Validate channel configuration before creating plugin
-        int numInputChans = desc->numInputChannels;
-        int numOutputChans = desc->numOutputChannels;
+        loadedInstance      = std::move(newInstance);
+        loadedRequest       = request;
+        loadedSampleRate    = sampleRate;
+        loadedBlockSize     = blockSize;
+        loadError           = errorMessage;
+    }
+    
+    triggerAsyncUpdate();
+}
+
+void PluginAssignProcessor::handleAsyncUpdate()
+{
+    std::unique_ptr<AudioPluginInstance> newInstance;
+    String errorMessage;
+    double preparedSampleRate;
+    int preparedBlockSize;
+    
+    {
+        const ScopedLock sl(loadLock);
         
-        if (numInputChans > 2 || numOutputChans > 2) {
-            DBG("Plugin rejected: too many channels (In:" << numInputChans << ", Out:" << numOutputChans << ")");
-            suspendProcessing(false);
-            return false;
+        if (loadedRequest != latestRequest)
+        {
+            // superseded while the message was on its way
+            loadedInstance = nullptr;
+            loadedRequest = 0;
+            return;
         }
         
-        // Attempt to create plugin instance with error handling
-        String errorMessage;
-        instance = formatManager.createPluginInstance(*desc, getSampleRate(), getBlockSize(), errorMessage);
+        newInstance         = std::move(loadedInstance);
+        errorMessage        = loadError;
+        preparedSampleRate  = loadedSampleRate;
+        preparedBlockSize   = loadedBlockSize;
+        loadedRequest       = 0;
+    }
+    
+    if (newInstance != nullptr)
+    {
+        // the device may have been restarted at another rate while it loaded
+        if (preparedSampleRate != getSampleRate() || preparedBlockSize != getBlockSize())
+        {
+            newInstance->setPlayConfigDetails(newInstance->getTotalNumInputChannels(), newInstance->getTotalNumOutputChannels(), getSampleRate(), getBlockSize());
+            newInstance->prepareToPlay(getSampleRate(), getBlockSize());
+        }
         
-        if (instance == nullptr) {
-            DBG("Failed to create plugin instance: " << errorMessage);
-            hasPlugin = false;
-            suspendProcessing(false);
-            return false;
+        auto* published = newInstance.get();
+        
+        {
+            const ScopedLock sl(instanceLock);
+            ownedInstances.add(newInstance.release());
         }
         
-        // Configure and initialize plugin safely
-        try {
-            instance->setPlayConfigDetails(numInputChans, numOutputChans, getSampleRate(), getBlockSize());
-            instance->prepareToPlay(getSampleRate(), getBlockSize());
-            hasPlugin = true;
-            
-            DBG("Successfully loaded plugin: " << desc->name);
+        publishInstance(published);
+        
+        DBG("Successfully loaded plugin: " << published->getName());
+    }
+    else
+    {
+        // a failed load leaves the slot empty, like the setting it came from
+        publishInstance(nullptr);
+    }
+    
+    if (onLoadFinished != nullptr)
+        onLoadFinished(hasPlugin, errorMessage);
+}
+
+void PluginAssignProcessor::publishInstance (AudioPluginInstance* newInstance)
+{
+    instance = newInstance;
+    hasPlugin = newInstance != nullptr;
+    
+    auto* superseded = pendingInstance.exchange(newInstance != nullptr ? newInstance : emptySlot(), std::memory_order_acq_rel);
+    
+    // the audio thread never saw it
+    if (superseded != nullptr && superseded != emptySlot())
+    {
+        const ScopedLock sl(instanceLock);
+        ownedInstances.removeObject(superseded);
+    }
+    
+    startTimer(retireCheckMs);
+}
+
+void PluginAssignProcessor::timerCallback()
+{
+    deleteRetiredInstances();
+}
+
+void PluginAssignProcessor::deleteRetiredInstances()
+{
+    AudioPluginInstance* retired;
+    
+    while (retiredInstances.try_pop(retired))
+    {
+        const ScopedLock sl(instanceLock);
+        ownedInstances.removeObject(retired);
+    }
+    
+    // only the current plugin is left, or nothing at all
+    const ScopedLock sl(instanceLock);
+    
+    if (ownedInstances.size() <= (hasPlugin ? 1 : 0) && pendingInstance.load() == nullptr)
+        stopTimer();
+}
+
+//=============================================================
+// Loader thread
+//=============================================================
+void PluginAssignProcessor::run()
+{
+    while (! threadShouldExit())
+    {
+        std::unique_ptr<PluginDescription> desc;
+        int request;
+        
+        {
+            const ScopedLock sl(loadLock);
+            desc = std::move(requestedDescription);
+            request = latestRequest;
+            requestInProgress = desc != nullptr ? request : 0;
         }
-        catch (const std::exception& e) {
-            DBG("Failed to initialize plugin: " << e.what());
-            instance = nullptr;
-            hasPlugin = false;
-            suspendProcessing(false);
-            return false;
+        
+        if (desc == nullptr)
+        {
+            wait(-1);
+            continue;
         }
         
-        suspendProcessing(false);
+        const double sampleRate = getSampleRate();
+        const int blockSize = getBlockSize();
+        
+        String errorMessage;
+        auto newInstance = createPreparedInstance(*desc, sampleRate, blockSize, errorMessage);
+        
+        const ScopedLock sl(loadLock);
+        requestInProgress = 0;
+        
+        // loadNewPlugin or clearPlugin was called again meanwhile
+        if (request != latestRequest)
+            continue;
+        
+        loadedInstance      = std::move(newInstance);
+        loadedRequest       = request;
+        loadedSampleRate    = sampleRate;
+        loadedBlockSize     = blockSize;
+        loadError           = errorMessage;
+        
+        triggerAsyncUpdate();
+    }
+}
+
+std::unique_ptr<AudioPluginInstance> PluginAssignProcessor::createPreparedInstance (const PluginDescription& desc, double sampleRate, int blockSize, String& errorMessage)
+{
+    std::unique_ptr<AudioPluginInstance> newInstance;
+    
+    try
+    {
+        newInstance = formatManager.createPluginInstance(desc, sampleRate, blockSize, errorMessage);
+    }
+    catch (const std::exception& e)
+    {
+        DBG("Failed to initialize plugin: " << e.what());
+        errorMessage = e.what();
+        return nullptr;
+    }
+    
+    if (newInstance == nullptr)
+    {
+        DBG("Failed to create plugin instance: " << errorMessage);
+        return nullptr;
+    }
+    
+    if (! prepareInstance(*newInstance, desc, sampleRate, blockSize, errorMessage))
+        return nullptr;
+    
+    return newInstance;
+}
+
+bool PluginAssignProcessor::prepareInstance (AudioPluginInstance& newInstance, const PluginDescription& desc, double sampleRate, int blockSize, String& errorMessage)
+{
+    try
+    {
+        newInstance.setPlayConfigDetails(desc.numInputChannels, desc.numOutputChannels, sampleRate, blockSize);
+        newInstance.prepareToPlay(sampleRate, blockSize);
+        
         return true;
     }
-    catch (const std::exception& e) {
-        DBG("Exception in loadNewPlugin: " << e.what());
-        instance = nullptr;
-        hasPlugin = false;
-        suspendProcessing(false);
+    catch (const std::exception& e)
+    {
+        DBG("Failed to initialize plugin: " << e.what());
+        errorMessage = e.what();
         return false;
     }
 }
@@ -30,13 +30,26 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "Delay.h"
-
-class PluginAssignProcessor : public AudioProcessor //public AudioProcessorGraph
+#include "utilities/spsc_queue.h"
+#include <atomic>
+#include <functional>
+
+// Hosts the plugin in one of the output plugin slots.
+//
+// Plugins are created and prepared on the slot's loader thread, so a heavy plugin never
+// stalls the audio callback; formats that can only be created on the message thread are
+// created there asynchronously instead. A prepared instance is handed to the audio thread
+// through a single atomic slot and crossfaded in over a few milliseconds; the instance
+// it replaces comes back through a queue and is deleted on the message thread.
+class PluginAssignProcessor : public AudioProcessor, //public AudioProcessorGraph
+                              private Thread,
+                              private AsyncUpdater,
+                              private Timer
 {
 public:
     
     PluginAssignProcessor(AudioPluginFormatManager & _formatManager, KnownPluginList * pluginList);
-    ~PluginAssignProcessor(){ }
+    ~PluginAssignProcessor();
 
     const String getName() const;
     void processBlock (AudioBuffer<float>&, MidiBuffer&);
@@ -51,7 +64,7 @@ public:
             PluginDescription * plugResult = pluginList->getType((int)newValue);
             if (plugResult)
             {
-                didLoad = loadNewPlugin(plugResult);
+                didLoad = loadNewPlugin(*plugResult);
             }
         }
 
@@ -65,80 +78,21 @@ public:
         
         if (plugResult)
         {
-            didLoad = loadNewPluginNew(*plugResult);
-
+            didLoad = loadNewPlugin(*plugResult);
         }
         
         return didLoad;
     }
     
-    bool loadNewPluginNew(PluginDescription desc)
-    {
-        suspendProcessing(true);
-        
-        if (pluginIsLoaded())
-        {
-            instance = nullptr;
-            
-            //recreate it
-            String errorMessage;
-            instance = formatManager.createPluginInstance(desc, getSampleRate(), getBlockSize(), errorMessage);
-
-            int numInputChans = desc.numInputChannels;
-            int numOutputChans = desc.numOutputChannels;
-            
-            if (numInputChans > 2 || numOutputChans > 2)
-            {
-                return false;
-            }
-            else
-            {
-                instance->setPlayConfigDetails(numInputChans, numOutputChans, getSampleRate(), getBlockSize());
-            }
-
-            instance->prepareToPlay(getSampleRate(), getBlockSize());
-            hasPlugin = true;
-        }
-        else
-        {
-            //recreate it
-            String errorMessage;
-            instance = formatManager.createPluginInstance(desc, getSampleRate(), getBlockSize(), errorMessage);
-            
-            int numInputChans = desc.numInputChannels;
-            int numOutputChans = desc.numOutputChannels;
-            
-            if (numInputChans > 2 || numOutputChans > 2)
-            {
-                return false;
-            }
-            else
-            {
-                instance->setPlayConfigDetails(numInputChans, numOutputChans, getSampleRate(), getBlockSize());
-            }
-
-            if (instance != nullptr)
-            {
-                instance->setPlayConfigDetails(numInputChans, numOutputChans, getSampleRate(), getBlockSize());
-                instance->prepareToPlay(getSampleRate(), getBlockSize());
-                hasPlugin = true;
-            }
-            else
-            {
-              //  AlertWindow::showMessageBox (AlertWindow::WarningIcon, TRANS("Couldn't create filter"), errorMessage);
-                hasPlugin = false;
-            }
-        }
-        
-        suspendProcessing(false);
-        
-        if (hasPlugin) return true;
-        else return false;
-    }
-    
-    bool loadNewPlugin(const PluginDescription*desc);
+    // Message thread. Returns false if the plugin can't be hosted in a slot, otherwise the
+    // load carries on in the background and onLoadFinished reports how it went. The
+    // current plugin keeps playing until the new one is ready.
+    bool loadNewPlugin(const PluginDescription& desc);
     bool clearPlugin();
     
+    // called on the message thread when a load finishes, superseded loads are not reported
+    std::function<void (bool didLoad, const String& errorMessage)> onLoadFinished;
+    
     AudioProcessorEditor* createEditor() { return 0; };
     
     int getNumParameters();
@@ -163,13 +117,86 @@ public:
     void getStateInformation (MemoryBlock& destData);
     void setStateInformation (const void* data, int sizeInBytes);
     
+    // message thread view: the most recently loaded plugin, which the audio thread may
+    // still be fading in
     bool hasPlugin = false;
     bool pluginIsLoaded();
+    bool isLoading() const;
+    AudioPluginInstance* getInstance() const { return instance; }
+    
+    // audio thread: false when the slot is empty with nothing to fade out or pick up
+    bool needsProcessing() const noexcept
+    {
+        return activeInstance != nullptr || fadingOutInstance != nullptr
+            || pendingInstance.load(std::memory_order_relaxed) != nullptr;
+    }
     
     AudioPluginFormatManager & formatManager;
     KnownPluginList * pluginList;
-    std::unique_ptr<AudioPluginInstance> instance;
     
+private:
+    //=============================================================
+    // Loader thread
+    void run() override;
+    std::unique_ptr<AudioPluginInstance> createPreparedInstance (const PluginDescription& desc, double sampleRate, int blockSize, String& errorMessage);
+    
+    // Loader or message thread
+    static bool prepareInstance (AudioPluginInstance& newInstance, const PluginDescription& desc, double sampleRate, int blockSize, String& errorMessage);
+    
+    //=============================================================
+    // Message thread
+    bool mustCreateOnMessageThread (const PluginDescription& desc) const;
+    void instanceCreatedOnMessageThread (std::unique_ptr<AudioPluginInstance> newInstance, const PluginDescription& desc,
+                                         String errorMessage, int request, double sampleRate, int blockSize);
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+    void publishInstance (AudioPluginInstance* newInstance);
+    void deleteRetiredInstances();
+    
+    //=============================================================
+    // Audio thread
+    void processWithInstance (AudioPluginInstance* pluginInstance, AudioBuffer<float>& buffer, MidiBuffer& midiBuffer);
+    
+    static AudioPluginInstance* emptySlot() noexcept;
+    
+    static constexpr double crossfadeSeconds    = 0.01;
+    static constexpr int    retiredQueueSize    = 8;
+    static constexpr int    retireCheckMs       = 100;
+    
+    // requests, guarded by loadLock
+    CriticalSection loadLock;
+    std::unique_ptr<PluginDescription> requestedDescription;
+    int             latestRequest = 0;
+    int             requestInProgress = 0;
+    int             messageThreadRequest = 0;       // created by the format manager on the message thread
+    std::unique_ptr<AudioPluginInstance> loadedInstance;
+    int             loadedRequest = 0;
+    double          loadedSampleRate = 0;
+    int             loadedBlockSize = 0;
+    String          loadError;
+    
+    // every instance the audio thread might be using, guarded by instanceLock; the audio
+    // callback never takes it
+    CriticalSection instanceLock;
+    OwnedArray<AudioPluginInstance> ownedInstances;
+    AudioPluginInstance* instance = nullptr;
+    
+    // message thread -> audio thread, nullptr when nothing is waiting
+    std::atomic<AudioPluginInstance*> pendingInstance { nullptr };
+    
+    // audio thread -> message thread
+    audio_devs::spsc_queue<AudioPluginInstance*> retiredInstances { retiredQueueSize };
+    
+    // audio thread
+    AudioPluginInstance* activeInstance = nullptr;
+    AudioPluginInstance* fadingOutInstance = nullptr;
+    int                 crossfadeLength = 0;
+    int                 crossfadeSamplesRemaining = 0;
+    AudioBuffer<float>  crossfadeBuffer;
+    AudioBuffer<float>  stereoAdapterBuffer;
+    MidiBuffer          fadingOutMidi;
+    
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PluginAssignProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginAssignProcessor);
 };
 
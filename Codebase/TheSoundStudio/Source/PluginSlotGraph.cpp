@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    PluginSlotGraph.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "PluginSlotGraph.h"
+
+PluginSlotGraph::PluginSlotGraph (SlotArray& slotsToRun)
+    : slots (slotsToRun)
+{
+    // the slots used to run in series on the first two channels
+    for (auto& output : slotOutputs)
+        output.store (AUDIO_OUTPUTS::STEREO_1_2);
+}
+
+PluginSlotGraph::~PluginSlotGraph()
+{
+    branchPool.stop (1000);
+}
+
+void PluginSlotGraph::setSlotOutput (int slot, int output)
+{
+    jassert (slot >= 0 && slot < NUM_PLUGIN_SLOTS);
+
+    // settings from before the slots had outputs
+    if (output < AUDIO_OUTPUTS::NO_OUTPUT || output >= AUDIO_OUTPUTS::TOTAL_OUTPUT_TYPES)
+        output = AUDIO_OUTPUTS::STEREO_1_2;
+
+    slotOutputs[slot].store (output);
+}
+
+int PluginSlotGraph::getSlotOutput (int slot) const
+{
+    return slotOutputs[slot].load();
+}
+
+void PluginSlotGraph::prepareToPlay (double, int)
+{
+    for (auto& midi : slotMidi)
+        midi.ensureSize (2048);
+
+    branchPool.start();
+}
+
+uint32 PluginSlotGraph::getChannelMask (int output, int numChannels) noexcept
+{
+    uint32 mask = 0;
+
+    if (output >= AUDIO_OUTPUTS::MONO_1 && output <= AUDIO_OUTPUTS::MONO_8)
+    {
+        mask = 1u << (output - AUDIO_OUTPUTS::MONO_1);
+    }
+    else if (output >= AUDIO_OUTPUTS::STEREO_1_2 && output <= AUDIO_OUTPUTS::STEREO_7_8)
+    {
+        mask = 3u << (2 * (output - AUDIO_OUTPUTS::STEREO_1_2));
+    }
+
+    return numChannels < 32 ? mask & ((1u << numChannels) - 1) : mask;
+}
+
+//=============================================================
+// Audio thread
+//=============================================================
+int PluginSlotGraph::buildBranches (int numChannels) noexcept
+{
+    int numBranches = 0;
+
+    for (int slot = 0; slot < NUM_PLUGIN_SLOTS; ++slot)
+    {
+        const uint32 mask = getChannelMask (slotOutputs[slot].load (std::memory_order_relaxed), numChannels);
+
+        slotTicks[slot] = 0;
+        slotMasks[slot] = mask;
+
+        if (mask == 0 || slots[slot] == nullptr || ! slots[slot]->needsProcessing())
+            continue;
+
+        // join the first branch sharing a channel, and fold in any later one this slot
+        // bridges; the slots were added in order, so each branch stays in slot order
+        int target = -1;
+
+        for (int b = 0; b < numBranches; ++b)
+        {
+            if ((branches[b].channelMask & mask) == 0)
+                continue;
+
+            if (target < 0)
+            {
+                target = b;
+                continue;
+            }
+
+            auto& into = branches[target];
+            auto& from = branches[b];
+
+            int merged[NUM_PLUGIN_SLOTS];
+            int numMerged = 0, i = 0, j = 0;
+
+            while (i < into.numSlots || j < from.numSlots)
+            {
+                if (j >= from.numSlots || (i < into.numSlots && into.slots[i] < from.slots[j]))
+                    merged[numMerged++] = into.slots[i++];
+                else
+                    merged[numMerged++] = from.slots[j++];
+            }
+
+            std::copy (merged, merged + numMerged, into.slots);
+            into.numSlots       = numMerged;
+            into.channelMask   |= from.channelMask;
+
+            branches[b--] = branches[--numBranches];
+        }
+
+        if (target < 0)
+        {
+            target = numBranches++;
+            branches[target].numSlots       = 0;
+            branches[target].channelMask    = 0;
+        }
+
+        auto& branch = branches[target];
+        branch.slots[branch.numSlots++] = slot;
+        branch.channelMask |= mask;
+    }
+
+    return numBranches;
+}
+
+void PluginSlotGraph::process (AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const int numBranches = buildBranches (buffer.getNumChannels());
+
+    if (numBranches == 0)
+        return;
+
+    // taken here, so the branches never touch the device buffer itself
+    float* const* deviceChannels = buffer.getArrayOfWritePointers();
+    const int numDeviceChannels  = buffer.getNumChannels();
+
+    auto branchJob = [&] (int branchIndex)
+    {
+        const auto& branch = branches[branchIndex];
+
+        for (int i = 0; i < branch.numSlots; ++i)
+        {
+            const int slot = branch.slots[i];
+            const int64 start = Time::getHighResolutionTicks();
+
+            processSlot (slot, deviceChannels, numDeviceChannels, startSample, numSamples);
+
+            slotTicks[slot] = Time::getHighResolutionTicks() - start;
+        }
+    };
+
+    branchPool.parallelFor (numBranches, branchJob);
+}
+
+void PluginSlotGraph::processSlot (int slot, float* const* deviceChannels, int numDeviceChannels, int startSample, int numSamples)
+{
+    float* channels[2];
+    int numChannels = 0;
+
+    for (int channel = 0; channel < numDeviceChannels && numChannels < 2; ++channel)
+    {
+        if ((slotMasks[slot] & (1u << channel)) != 0)
+            channels[numChannels++] = deviceChannels[channel] + startSample;
+    }
+
+    // refers to the device buffer, a view this small uses the buffer's own channel table
+    AudioBuffer<float> slotBuffer (channels, numChannels, numSamples);
+
+    slotMidi[slot].clear();
+    slots[slot]->processBlock (slotBuffer, slotMidi[slot]);
+}
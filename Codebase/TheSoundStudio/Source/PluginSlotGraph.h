@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    PluginSlotGraph.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Parameters.h"
+#include "PluginAssignProcessor.h"
+#include "RealtimeRenderPool.h"
+#include <array>
+#include <atomic>
+
+//=============================================================
+// Plugin Slot Graph
+//=============================================================
+// Runs the output plugin slots on the channels each one is routed to. Slots whose
+// outputs share a channel form a branch and run in slot order, so plugins routed to the
+// same output are chained; branches on separate channels run in parallel on the render
+// pool. Empty slots and slots routed to NO_OUTPUT are skipped.
+//
+// A stereo route on a mono device uses its first channel, and channels the device
+// doesn't have are ignored.
+class PluginSlotGraph
+{
+public:
+    using SlotArray = std::array<std::unique_ptr<PluginAssignProcessor>, NUM_PLUGIN_SLOTS>;
+
+    explicit PluginSlotGraph (SlotArray& slotsToRun);
+    ~PluginSlotGraph();
+
+    // Message thread
+    void setSlotOutput (int slot, int output);
+    int getSlotOutput (int slot) const;
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+
+    // Audio thread
+    void process (AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // time each slot took in the last process call, zero for skipped slots
+    const int64* getSlotTicks() const noexcept     { return slotTicks; }
+
+private:
+    struct Branch
+    {
+        int     slots[NUM_PLUGIN_SLOTS];
+        int     numSlots    = 0;
+        uint32  channelMask = 0;
+    };
+
+    static uint32 getChannelMask (int output, int numChannels) noexcept;
+
+    int buildBranches (int numChannels) noexcept;
+    void processSlot (int slot, float* const* deviceChannels, int numDeviceChannels, int startSample, int numSamples);
+
+    SlotArray& slots;
+    std::atomic<int> slotOutputs[NUM_PLUGIN_SLOTS];
+
+    // audio thread
+    Branch      branches[NUM_PLUGIN_SLOTS];
+    uint32      slotMasks[NUM_PLUGIN_SLOTS] {};     // read once per block, routing can change under us
+    MidiBuffer  slotMidi[NUM_PLUGIN_SLOTS];
+    int64       slotTicks[NUM_PLUGIN_SLOTS] {};
+
+    RealtimeRenderPool branchPool { "Plugin Branch Worker" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginSlotGraph)
+};
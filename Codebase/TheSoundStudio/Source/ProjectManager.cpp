@@ -15,12 +15,12 @@
 #include "RealtimeAnalysisProcessor.h"
 #include "MainComponent.h"
 
-ProjectManager::ProjectManager() : backgroundThread("Audio Recorder Thread")
+ProjectManager::ProjectManager()
 {
     try 
     {
         // Initialize directories with proper error handling
-        logFileDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("TSS/Logs");
+        setDirectoryFileForSettingParameter(LOG_FILE_LOCATION, File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("TSS/Logs"));
         recordFileDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("TSS/Recordings");
         profileDirectory = File::getSpecialLocation(File::userDocumentsDirectory).getChildFile("TSS/Profiles");
         
@@ -79,6 +79,19 @@ ProjectManager::ProjectManager() : backgroundThread("Audio Recorder Thread")
     for (int i = 0; i < NUM_PLUGIN_SLOTS; i++)
     {
         pluginAssignProcessor[i] = std::make_unique<PluginAssignProcessor>(pluginFormatManager, knownPluginList.get());
+        
+        // plugins load in the background, a plugin that fails to load clears its setting
+        pluginAssignProcessor[i]->onLoadFinished = [this, i] (bool didLoad, const String& errorMessage)
+        {
+            if (! didLoad)
+            {
+                DBG("Plugin slot " << i + 1 << " failed to load: " << errorMessage);
+                
+                projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_SELECTED_1 + i), -1, nullptr);
+            }
+            
+            uiListeners.call(&::ProjectManager::UIListener::updateSettingsUIParameter, PLUGIN_SELECTED_1 + i);
+        };
     }
     
     formatManager.registerBasicFormats();
@@ -96,6 +109,8 @@ ProjectManager::ProjectManager() : backgroundThread("Audio Recorder Thread")
     frequencyToLightParameters = std::make_unique<ValueTree>("FrequencyToLight");
     lissajousParameters = std::make_unique<ValueTree>("LissajousCurve");
     
+    initParameterIdentifiers();
+    
     initDefaultChordPlayerParameters();
     initDefaultChordScannerParameters();
     initDefaultFrequencyPlayerParameters();
@@ -108,9 +123,6 @@ ProjectManager::ProjectManager() : backgroundThread("Audio Recorder Thread")
     
     noiseType = WHITE_NOISE;
     
-    
-    backgroundThread.startThread();
-
 }
 
 ProjectManager::~ProjectManager()
@@ -118,13 +130,8 @@ ProjectManager::~ProjectManager()
     // FIXED: Proper cleanup order and thread safety
     cleanup();
     
-    outputAnalyser.stopThread(1000);
-
     // Stop analyzers
-    for (int i = 0; i < 8; i++)
-    {
-        analyser[i].stopThread(1000);
-    }
+    analyzerPool.stopAllThreads(1000);
 }
 
 void ProjectManager::changeListenerCallback (ChangeBroadcaster*)
@@ -161,22 +168,29 @@ void ProjectManager::prepareToPlay (int samplesPerBlockExpected, double sampleRa
         pluginAssignProcessor[i]       ->prepareToPlay(sampleRate, samplesPerBlockExpected);
     }
     
+    pluginSlotGraph.prepareToPlay(sampleRate, samplesPerBlockExpected);
+    
     
 //    visualisersRingBuffer = new RingBuffer<GLfloat> (2, samplesPerBlockExpected * 10);
     
     // **** need to set to FFTs
 //    outputAnalyser.setupAnalyser (int (sampleRate), float (sampleRate));
 //    
-    for (int i = 0; i < 8; i++)
-    {
-        analyser[i].setupAnalyser(int (sampleRate), float (sampleRate));
-    }
+    analyzerPool.setupAll(int (sampleRate), float (sampleRate));
     
     setOscilloscopeRefreshRate(refreshRate);
+    
+    callbackProfiler.prepareToPlay(sampleRate);
 }
 
 void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
 {
+    callbackProfiler.beginBlock(bufferToFill.numSamples);
+    
+    applyPendingParameterChanges();
+    
+    callbackProfiler.endStage(CallbackProfiler::PARAMETER_CHANGES);
+    
     // process input gains
     
     for (int chan = 0; chan < 4 && chan < bufferToFill.buffer->getNumChannels(); chan++)
@@ -184,6 +198,11 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
         bufferToFill.buffer->applyGain(chan, 0, bufferToFill.buffer->getNumSamples(), inputGain[chan]);
     }
     
+    // the inputs as they come in, before the mode processor writes over them
+    recorder.captureInputs(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    
+    callbackProfiler.endStage(CallbackProfiler::INPUT_GAINS);
+    
     // process input FFTs...
     if (shouldProcessFFT)
     {
@@ -193,11 +212,13 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
             {
                 if (i < bufferToFill.buffer->getNumChannels())
                 {
-                    analyser[i].addAudioData(*bufferToFill.buffer, i, 1);
+                    analyzerPool.addAudioData(i, *bufferToFill.buffer, i, 1);
                 }
             }
         }
     }
+    
+    callbackProfiler.endStage(CallbackProfiler::INPUT_ANALYSERS);
 
     if (panicButtonIsDown)
     {
@@ -285,15 +306,17 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
             default: break;
         }
         
-        MidiBuffer midiBufTemp;
+        callbackProfiler.endStage(CallbackProfiler::MODE_PROCESSOR);
         
-        for (int i = 0; i < NUM_PLUGIN_SLOTS; i++)
-        {
-            pluginAssignProcessor[i]->processBlock(*bufferToFill.buffer, midiBufTemp);
-        }
+        pluginSlotGraph.process(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+        
+        callbackProfiler.endParallelStages(CallbackProfiler::PLUGIN_SLOT_1, pluginSlotGraph.getSlotTicks(), NUM_PLUGIN_SLOTS);
         
     }
     
+    // the panic noise has no stage of its own, it is counted as the mode processor
+    callbackProfiler.endStage(CallbackProfiler::MODE_PROCESSOR);
+    
     // process output gains
     
     for (int chan = 0; chan < 4 && chan < bufferToFill.buffer->getNumChannels(); chan++)
@@ -301,6 +324,8 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
         bufferToFill.buffer->applyGain(chan, 0, bufferToFill.buffer->getNumSamples(), outputGain[chan]);
     }
     
+    callbackProfiler.endStage(CallbackProfiler::OUTPUT_GAINS);
+    
     // grab FFT data here
     if (shouldProcessFFT)
     {
@@ -313,7 +338,7 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
                 {
                     if (i < bufferToFill.buffer->getNumChannels())
                     {
-                        analyser[i + 4].addAudioData(*bufferToFill.buffer, i, 1);
+                        analyzerPool.addAudioData(i + 4, *bufferToFill.buffer, i, 1);
                     }
                 }
             }
@@ -321,31 +346,24 @@ void ProjectManager::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFi
     }
     
 
-    for (int i = 0; i< bufferToFill.buffer->getNumSamples(); i++)
-    {
-        // Default stereo buffer (channels 0 and 1)
-        visualiserRingBuffer.setSample(0, visualiserBufferCounter, bufferToFill.buffer->getSample(0, i));
-        visualiserRingBuffer.setSample(1, visualiserBufferCounter, bufferToFill.buffer->getSample(1, i));
-
-        // Per-channel oscilloscope buffers for input selection support
-        int numChannels = bufferToFill.buffer->getNumChannels();
-        for (int ch = 0; ch < numOscilloscopeChannels && ch < numChannels; ++ch)
-        {
-            float sample = bufferToFill.buffer->getSample(ch, i);
-            oscilloscopeBuffers[ch].setSample(0, visualiserBufferCounter, sample);
-            oscilloscopeBuffers[ch].setSample(1, visualiserBufferCounter, sample);
-        }
-
-        visualiserBufferCounter++;
+    callbackProfiler.endStage(CallbackProfiler::OUTPUT_ANALYSERS);
 
-        if (visualiserBufferCounter >= visualiserBufferSize) visualiserBufferCounter = 0;
-    }
+    // oscilloscope capture, one block copy per channel
+    oscilloscopeCapture.writeSamples(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    
+    callbackProfiler.endStage(CallbackProfiler::OSCILLOSCOPE);
+    
+    recorder.captureOutputs(*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples);
+    
+    callbackProfiler.endStage(CallbackProfiler::RECORDER);
         
     if (mode == MODE_REALTIME_ANALYSIS)
     {
         // delete output buffer to avoid feedback loop
         bufferToFill.buffer->clear();
     }
+    
+    callbackProfiler.endBlock();
 //    }
  
 }
@@ -354,17 +372,6 @@ void ProjectManager::processChordPlayer(AudioBuffer<float>& buffer)
 {
     MidiBuffer tempMidiBuffer;
     chordPlayerProcessor->processBlock(buffer, tempMidiBuffer);
-    
-    // record here...
-    if (shouldRecord /*&& transportState == TRANSPORT_STATE::PLAYING*/)
-    {
-        if (activeWriter != nullptr)
-        {
-            activeWriter->write (buffer.getArrayOfReadPointers(), buffer.getNumSamples());
-            
-            recordCounterInSamples += buffer.getNumSamples();
-        }
-    }
 }
 
 void ProjectManager::processChordScanner(AudioBuffer<float>& buffer)
@@ -377,17 +384,6 @@ void ProjectManager::processFrequencyPlayer(AudioBuffer<float>& buffer)
 {
     MidiBuffer tempMidiBuffer;
     frequencyPlayerProcessor->processBlock(buffer, tempMidiBuffer);
-    
-    // record here...
-    if (shouldRecord /*&& transportState == TRANSPORT_STATE::PLAYING*/)
-    {
-        if (activeWriter != nullptr)
-        {
-            activeWriter->write (buffer.getArrayOfReadPointers(), buffer.getNumSamples());
-            
-            recordCounterInSamples += buffer.getNumSamples();
-        }
-    }
 }
 
 void ProjectManager::processFrequencyScanner(AudioBuffer<float>& buffer)
@@ -404,21 +400,6 @@ void ProjectManager::processLissajousCurve(AudioBuffer<float>& buffer)
 
 void ProjectManager::processRealtimeAnalysis(AudioBuffer<float>& buffer)
 {
-    //======================================================================================
-    // record here...
-    if (shouldRecord /*&& transportState == TRANSPORT_STATE::PLAYING*/) // check playstate in realtime analysis
-    {
-        if (activeWriter != nullptr)
-        {
-            if (buffer.getNumChannels() > 1)
-            {
-                activeWriter->write (buffer.getArrayOfReadPointers(), buffer.getNumSamples());
-                recordCounterInSamples += buffer.getNumSamples();
-            }
-        }
-    }
-    //======================================================================================
-
     // Check if analysis is active via the processor
     if (realtimeAnalysisProcessor && realtimeAnalysisProcessor->isPlaying())
     {
@@ -438,7 +419,7 @@ void ProjectManager::processRealtimeAnalysis(AudioBuffer<float>& buffer)
         {
             if (inputFFT[i])
             {
-                analyser[i].addAudioData(buffer, i, 1);
+                analyzerPool.addAudioData(i, buffer, i, 1);
             }
         }
     }
@@ -468,7 +449,10 @@ void ProjectManager::releaseResources()
 
 void ProjectManager::setOversampingFactor(int newFactor)
 {
-//    chordPlayerProcessor->setOversamplingFactor(newFactor);
+    chordPlayerProcessor        ->setOversamplingFactor(newFactor);
+    chordScannerProcessor       ->setOversamplingFactor(newFactor);
+    frequencyPlayerProcessor    ->setOversamplingFactor(newFactor);
+    frequencyScannerProcessor   ->setOversamplingFactor(newFactor);
 }
 
 void ProjectManager::setMode(AUDIO_MODE newMode)
@@ -718,6 +702,8 @@ String ProjectManager::getIdentifierForSettingIndex(int index)
         case LOG_FILE_LOCATION:                 return "LOG_FILE_LOCATION"; break;
         case RECORD_FILE_LOCATION:              return "RECORD_FILE_LOCATION"; break;
         case RECORD_FILE_FORMAT:                return "RECORD_FILE_FORMAT"; break;
+        case RECORD_CHANNELS:                   return "RECORD_CHANNELS"; break;
+        case RECORD_FILE_PER_CHANNEL:           return "RECORD_FILE_PER_CHANNEL"; break;
         case BASE_FREQUENCY_A:                  return "BASE_FREQUENCY_A"; break;
         case AMPLITUDE_MIN:                     return "AMPLITUDE_MIN"; break;
         case AMPLITUDE_MAX:                     return "AMPLITUDE_MAX"; break;
@@ -760,6 +746,10 @@ String ProjectManager::getIdentifierForSettingIndex(int index)
         case PLUGIN_SELECTED_2:                 return "PLUGIN_SELECTED_2"; break;
         case PLUGIN_SELECTED_3:                 return "PLUGIN_SELECTED_3"; break;
         case PLUGIN_SELECTED_4:                 return "PLUGIN_SELECTED_4"; break;
+        case PLUGIN_OUTPUT_1:                   return "PLUGIN_OUTPUT_1"; break;
+        case PLUGIN_OUTPUT_2:                   return "PLUGIN_OUTPUT_2"; break;
+        case PLUGIN_OUTPUT_3:                   return "PLUGIN_OUTPUT_3"; break;
+        case PLUGIN_OUTPUT_4:                   return "PLUGIN_OUTPUT_4"; break;
         case FREQUENCY_TO_CHORD:                return "FREQUENCY_TO_CHORD"; break;
             
         case MIXER_INPUT_GAIN_1:                return "MIXER_INPUT_GAIN_1"; break;
@@ -796,6 +786,8 @@ void ProjectManager::initDefaultProjectSettings()
     projectSettings->setProperty(getIdentifierForSettingIndex(LOG_FILE_LOCATION),    (String)"/location of file",            nullptr);
     projectSettings->setProperty(getIdentifierForSettingIndex(RECORD_FILE_LOCATION), (String)"/location of recorded file",   nullptr);
     projectSettings->setProperty(getIdentifierForSettingIndex(RECORD_FILE_FORMAT),   (int) 1,                         nullptr);
+    projectSettings->setProperty(getIdentifierForSettingIndex(RECORD_CHANNELS),      (int)(RecordingManager::getOutputBit(0) | RecordingManager::getOutputBit(1)), nullptr);
+    projectSettings->setProperty(getIdentifierForSettingIndex(RECORD_FILE_PER_CHANNEL), (int) 0,                      nullptr);
     
     projectSettings->setProperty(getIdentifierForSettingIndex(BASE_FREQUENCY_A),     (double)432.0,                          nullptr);
     projectSettings->setProperty(getIdentifierForSettingIndex(AMPLITUDE_MIN),        (double)0,                         nullptr);
@@ -846,6 +838,11 @@ void ProjectManager::initDefaultProjectSettings()
     projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_SELECTED_3),                                (int)-1,         nullptr);
     projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_SELECTED_4),                                (int)-1,         nullptr);
     
+    projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_OUTPUT_1),                                  (int)AUDIO_OUTPUTS::STEREO_1_2, nullptr);
+    projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_OUTPUT_2),                                  (int)AUDIO_OUTPUTS::STEREO_1_2, nullptr);
+    projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_OUTPUT_3),                                  (int)AUDIO_OUTPUTS::STEREO_1_2, nullptr);
+    projectSettings->setProperty(getIdentifierForSettingIndex(PLUGIN_OUTPUT_4),                                  (int)AUDIO_OUTPUTS::STEREO_1_2, nullptr);
+    
     projectSettings->setProperty(getIdentifierForSettingIndex(FREQUENCY_TO_CHORD),                               (int)0,          nullptr);
     
     projectSettings->setProperty(getIdentifierForSettingIndex(MIXER_INPUT_GAIN_1),                               (double)1.f,          nullptr);
@@ -940,6 +937,14 @@ void ProjectManager::setProjectSettingsParameter(int index, double newVal)
         }
             break;
             
+        case RECORD_CHANNELS:
+        case RECORD_FILE_PER_CHANNEL:
+        {
+            // read when the next recording is set up
+            uiListeners.call(&::ProjectManager::UIListener::updateSettingsUIParameter, index);
+        }
+            break;
+            
         case AMPLITUDE_MIN:
         {
             amplitude_min = newVal;
@@ -1076,6 +1081,15 @@ void ProjectManager::setProjectSettingsParameter(int index, double newVal)
         }
             break;
             
+        case OVERSAMPLE_FACTOR:
+        {
+            // 1, 2, 4 or 8 - synth voices render at this multiple of the device rate
+            setOversampingFactor((int)newVal);
+            
+            uiListeners.call(&::ProjectManager::UIListener::updateSettingsUIParameter, OVERSAMPLE_FACTOR);
+        }
+            break;
+            
         case PLUGIN_SELECTED_1:
         {
             bool didLoad = pluginAssignProcessor[0]->loadPluginRef((int)newVal);
@@ -1151,6 +1165,17 @@ void ProjectManager::setProjectSettingsParameter(int index, double newVal)
         }
             break;
             
+        case PLUGIN_OUTPUT_1:
+        case PLUGIN_OUTPUT_2:
+        case PLUGIN_OUTPUT_3:
+        case PLUGIN_OUTPUT_4:
+        {
+            pluginSlotGraph.setSlotOutput(index - PLUGIN_OUTPUT_1, (int)newVal);
+            
+            uiListeners.call(&::ProjectManager::UIListener::updateSettingsUIParameter, index);
+        }
+            break;
+            
         case FREQUENCY_TO_CHORD:
         {
             // do something here !!!!!
@@ -1278,7 +1303,13 @@ double ProjectManager::getProjectSettingsParameter(int index)
 
 void ProjectManager::setDirectoryFileForSettingParameter(int index, File newDirectory)
 {
-    if (index == LOG_FILE_LOCATION)         { logFileDirectory = newDirectory; }
+    if (index == LOG_FILE_LOCATION)
+    {
+        logFileDirectory = newDirectory;
+        
+        // the profiler thread keeps its own copy
+        callbackProfiler.setLogDirectory(newDirectory);
+    }
     else if (index == RECORD_FILE_LOCATION) { recordFileDirectory = newDirectory; }
 }
 
@@ -1454,7 +1485,7 @@ double * ProjectManager::getWavetableBufferForCurrentEditor(AUDIO_MODE mode, int
 {
     if (mode == AUDIO_MODE::MODE_CHORD_PLAYER)
     {
-        return chordPlayerProcessor->wavetableSynth[shortcut]->getBaseWavetableBuffer();
+        return chordPlayerProcessor->getWavetableBuffer(shortcut);
     }
     else if (mode == AUDIO_MODE::MODE_CHORD_SCANNER)
     {
@@ -1462,7 +1493,7 @@ double * ProjectManager::getWavetableBufferForCurrentEditor(AUDIO_MODE mode, int
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_PLAYER)
     {
-        return frequencyPlayerProcessor->wavetableSynth[shortcut]->getBaseWavetableBuffer();
+        return frequencyPlayerProcessor->getWavetableBuffer(shortcut);
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_SCANNER)
     {
@@ -1480,7 +1511,7 @@ void * ProjectManager::setWavetableBuffer(AUDIO_MODE mode, int shortcut, double
 {
     if (mode == AUDIO_MODE::MODE_CHORD_PLAYER)
     {
-        chordPlayerProcessor->wavetableSynth[shortcut]->setWavetableBuffer(tableArray);
+        chordPlayerProcessor->setWavetableBuffer(shortcut, tableArray);
     }
     else if (mode == AUDIO_MODE::MODE_CHORD_SCANNER)
     {
@@ -1488,7 +1519,7 @@ void * ProjectManager::setWavetableBuffer(AUDIO_MODE mode, int shortcut, double
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_PLAYER)
     {
-        frequencyPlayerProcessor->wavetableSynth[shortcut]->setWavetableBuffer(tableArray);
+        frequencyPlayerProcessor->setWavetableBuffer(shortcut, tableArray);
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_SCANNER)
     {
@@ -1504,7 +1535,7 @@ void ProjectManager::initBaseWavetable(AUDIO_MODE mode, int shortcutRef, int new
 {
     if (mode == AUDIO_MODE::MODE_CHORD_PLAYER)
     {
-        chordPlayerProcessor->wavetableSynth[shortcutRef]->initBaseWaveType(newType);
+        chordPlayerProcessor->initBaseWaveType(shortcutRef, newType);
     }
     else if (mode == AUDIO_MODE::MODE_CHORD_SCANNER)
     {
@@ -1512,7 +1543,7 @@ void ProjectManager::initBaseWavetable(AUDIO_MODE mode, int shortcutRef, int new
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_PLAYER)
     {
-        frequencyPlayerProcessor->wavetableSynth[shortcutRef]->initBaseWaveType(newType);
+        frequencyPlayerProcessor->initBaseWaveType(shortcutRef, newType);
     }
     else if (mode == AUDIO_MODE::MODE_FREQUENCY_SCANNER)
     {
@@ -1525,6 +1556,107 @@ void ProjectManager::initBaseWavetable(AUDIO_MODE mode, int shortcutRef, int new
 }
 
 
+//===============================================================================
+#pragma mark Processor Parameter Changes
+//===============================================================================
+
+void ProjectManager::initParameterIdentifiers()
+{
+    // the names are fixed, so look each one up once rather than on every parameter change
+    auto fill = [] (Array<Identifier>& identifiers, int numParameters, std::function<String (int)> getName)
+    {
+        identifiers.clearQuick();
+        
+        for (int i = 0; i < numParameters; i++)
+        {
+            const String name = getName(i);
+            identifiers.add(name.isEmpty() ? Identifier() : Identifier(name));
+        }
+    };
+    
+    fill(chordPlayerIdentifiers,        TOTAL_NUM_CHORD_PLAYER_SHORTCUT_PARAMS,     [this] (int i) { return getIdentifierForChordPlayerParameterIndex(i); });
+    fill(chordScannerIdentifiers,       TOTAL_NUM_CHORD_SCANNER_PARAMS,             [this] (int i) { return getIdentifierForChordScannerParameterIndex(i); });
+    fill(frequencyPlayerIdentifiers,    TOTAL_NUM_FREQUENCY_PLAYER_SHORTCUT_PARAMS, [this] (int i) { return getIdentifierForFrequencyPlayerParameterIndex(i); });
+    fill(frequencyScannerIdentifiers,   TOTAL_NUM_FREQUENCY_SCANNER_PARAMS,         [this] (int i) { return getIdentifierForFrequencyScannerParameterIndex(i); });
+    fill(lissajousIdentifiers,          TOTAL_NUM_LISSAJOUS_CURVE_PARAMS,           [this] (int i) { return getIdentifierForLissajousParameterIndex(i); });
+}
+
+const Identifier& ProjectManager::getParameterIdentifier(const Array<Identifier>& identifiers, int index)
+{
+    static const Identifier none;
+    
+    if (! isPositiveAndBelow(index, identifiers.size()))
+        return none;
+    
+    return identifiers.getReference(index);
+}
+
+void ProjectManager::postParameterChange(ParameterChangeQueue::Target target, int shortcut, int index, const var& value)
+{
+    // a shortcut being switched on needs its engine before the change reaches the audio thread
+    if ((target == ParameterChangeQueue::CHORD_PLAYER && index == SHORTCUT_IS_ACTIVE)
+        || target == ParameterChangeQueue::CHORD_PLAYER_ACTIVE_SHORTCUT)
+    {
+        chordPlayerProcessor->setShortcutInUse(shortcut, (bool) value);
+    }
+    else if ((target == ParameterChangeQueue::FREQUENCY_PLAYER && index == FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)
+             || target == ParameterChangeQueue::FREQUENCY_PLAYER_ACTIVE_SHORTCUT)
+    {
+        frequencyPlayerProcessor->setShortcutInUse(shortcut, (bool) value);
+    }
+    
+    // the queue keeps one entry per parameter, so it can't fill up, and changes only
+    // ever reach the processors through it
+    const bool posted = parameterChanges.post(target, shortcut, index, value);
+    jassert (posted);
+    ignoreUnused (posted);
+}
+
+void ProjectManager::applyPendingParameterChanges()
+{
+    parameterChanges.applyPending([this] (const ParameterChangeQueue::Change& change) { applyParameterChange(change); });
+}
+
+void ProjectManager::applyParameterChange(const ParameterChangeQueue::Change& change)
+{
+    const var value (change.value);
+    
+    switch (change.target)
+    {
+        case ParameterChangeQueue::CHORD_PLAYER:
+            chordPlayerProcessor->setParameter(change.shortcut, change.index, value);
+            break;
+            
+        case ParameterChangeQueue::CHORD_PLAYER_ACTIVE_SHORTCUT:
+            chordPlayerProcessor->setActiveShortcutSynth(change.shortcut, change.value != 0.0);
+            break;
+            
+        case ParameterChangeQueue::CHORD_SCANNER:
+            chordScannerProcessor->setParameter(change.index, value);
+            break;
+            
+        case ParameterChangeQueue::FREQUENCY_PLAYER:
+            frequencyPlayerProcessor->setParameter(change.shortcut, change.index, value);
+            break;
+            
+        case ParameterChangeQueue::FREQUENCY_PLAYER_ACTIVE_SHORTCUT:
+            frequencyPlayerProcessor->setActiveShortcutSynth(change.shortcut, change.value != 0.0);
+            break;
+            
+        case ParameterChangeQueue::FREQUENCY_SCANNER:
+            frequencyScannerProcessor->setParameter(change.index, value);
+            break;
+            
+        case ParameterChangeQueue::LISSAJOUS:
+            lissajousProcessor->setParameter(change.index, value);
+            break;
+            
+        default:
+            jassertfalse;
+            break;
+    }
+}
+
 //===============================================================================
 #pragma mark Lissajous / Chord Player Parameters
 //===============================================================================
@@ -2136,16 +2268,16 @@ void ProjectManager::initDefaultLissajousParameters()
 
     for (int index = 0; index < TOTAL_NUM_LISSAJOUS_CURVE_PARAMS; index++)
     {
-        lissajousProcessor->setParameter(index, lissajousParameters->getProperty(getIdentifierForLissajousParameterIndex(index)));
+        postParameterChange(ParameterChangeQueue::LISSAJOUS, 0, index, lissajousParameters->getProperty(getIdentifierForLissajousParameterIndex(index)));
     }
 }
 
 // called from UI to change individual parameters
 void ProjectManager::setLissajousParameter(int index, var newValue)
 {
-    lissajousParameters->setProperty(getIdentifierForLissajousParameterIndex(index), newValue, nullptr);
+    lissajousParameters->setProperty(getParameterIdentifier(lissajousIdentifiers, index), newValue, nullptr);
     
-    lissajousProcessor->setParameter(index, newValue);
+    postParameterChange(ParameterChangeQueue::LISSAJOUS, 0, index, newValue);
     // needs to call ui fuction
     uiListeners.call(&UIListener::updateLissajousCurveUIParameter, index);
 }
@@ -2153,7 +2285,7 @@ void ProjectManager::setLissajousParameter(int index, var newValue)
 // called from GUI to update controls when neccessary
 var ProjectManager::getLissajousParameter(int index)
 {
-    return lissajousParameters->getProperty(getIdentifierForLissajousParameterIndex(index));
+    return lissajousParameters->getProperty(getParameterIdentifier(lissajousIdentifiers, index));
 }
 
 //===============================================================================
@@ -2355,11 +2487,11 @@ void ProjectManager::initDefaultChordPlayerParameters()
 
             if (index == SHORTCUT_IS_ACTIVE)
             {
-                chordPlayerProcessor->setActiveShortcutSynth(i, (bool)chordPlayerParameters[i]->getProperty(identifier));
+                postParameterChange(ParameterChangeQueue::CHORD_PLAYER_ACTIVE_SHORTCUT, i, SHORTCUT_IS_ACTIVE, (bool)chordPlayerParameters[i]->getProperty(identifier));
             }
             else
             {
-                chordPlayerProcessor->setParameter(i, index, chordPlayerParameters[i]->getProperty(identifier));
+                postParameterChange(ParameterChangeQueue::CHORD_PLAYER, i, index, chordPlayerParameters[i]->getProperty(identifier));
             }
         }
     }
@@ -2444,11 +2576,11 @@ void ProjectManager::initDefaultChordPlayerParametersForShortcut(int shortcutRef
 
         if (index == SHORTCUT_IS_ACTIVE)
         {
-            chordPlayerProcessor->setActiveShortcutSynth(i, (bool)chordPlayerParameters[i]->getProperty(identifier));
+            postParameterChange(ParameterChangeQueue::CHORD_PLAYER_ACTIVE_SHORTCUT, i, SHORTCUT_IS_ACTIVE, (bool)chordPlayerParameters[i]->getProperty(identifier));
         }
         else
         {
-            chordPlayerProcessor->setParameter(i, index, chordPlayerParameters[i]->getProperty(identifier));
+            postParameterChange(ParameterChangeQueue::CHORD_PLAYER, i, index, chordPlayerParameters[i]->getProperty(identifier));
         }
     }
 }
@@ -2512,8 +2644,8 @@ void ProjectManager::copyShortcut(int sourceShortcut, int destShortcut)
 void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newValue)
 {
     // store new value in paramater valuetree
-    String identifier = getIdentifierForChordPlayerParameterIndex(index);
-    if (identifier.isEmpty())
+    const Identifier& identifier = getParameterIdentifier(chordPlayerIdentifiers, index);
+    if (identifier.isNull())
         return;  // Skip unhandled indices
     chordPlayerParameters[synthRef]->setProperty(identifier, newValue, nullptr);
 
@@ -2521,8 +2653,8 @@ void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newVal
     if (index == SHORTCUT_IS_ACTIVE)
     {
         // this basiclly deletes the shortcut,
-        chordPlayerProcessor->setActiveShortcutSynth(synthRef, (bool)chordPlayerParameters[synthRef]->getProperty(getIdentifierForChordPlayerParameterIndex(SHORTCUT_IS_ACTIVE)));
-        chordPlayerProcessor->setParameter(synthRef, index, newValue);
+        // setParameter activates the shortcut and its repeater
+        postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, index, newValue);
         
         // so shortcut params should prob be reset to default in this case..
 //        initDefaultChordPlayerParametersForShortcut(synthRef); // defaults all parameters EXCEPT SHORTCUT_ACTIVE, which is set above
@@ -2530,7 +2662,7 @@ void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newVal
     else if (index == CUSTOM_CHORD)
     {
         // set to all 12 chord active, note and octave
-        chordPlayerProcessor->setParameter(synthRef, index, newValue);
+        postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, index, newValue);
         
         bool should = newValue.operator bool();
         
@@ -2538,13 +2670,13 @@ void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newVal
         {
             for (int i = 0; i < 12; i++)
             {
-                chordPlayerParameters[synthRef]->setProperty(getIdentifierForChordPlayerParameterIndex(CUSTOM_CHORD_ACTIVE_1 + i), 0, nullptr);
-                chordPlayerParameters[synthRef]->setProperty(getIdentifierForChordPlayerParameterIndex(CUSTOM_CHORD_NOTE_1 + i), 1, nullptr);
-                chordPlayerParameters[synthRef]->setProperty(getIdentifierForChordPlayerParameterIndex(CUSTOM_CHORD_OCTAVE_1 + i), 1, nullptr);
+                chordPlayerParameters[synthRef]->setProperty(getParameterIdentifier(chordPlayerIdentifiers, CUSTOM_CHORD_ACTIVE_1 + i), 0, nullptr);
+                chordPlayerParameters[synthRef]->setProperty(getParameterIdentifier(chordPlayerIdentifiers, CUSTOM_CHORD_NOTE_1 + i), 1, nullptr);
+                chordPlayerParameters[synthRef]->setProperty(getParameterIdentifier(chordPlayerIdentifiers, CUSTOM_CHORD_OCTAVE_1 + i), 1, nullptr);
                 
-                chordPlayerProcessor->setParameter(synthRef, CUSTOM_CHORD_ACTIVE_1 + i, 0);
-                chordPlayerProcessor->setParameter(synthRef, CUSTOM_CHORD_NOTE_1 + i, 1);
-                chordPlayerProcessor->setParameter(synthRef, CUSTOM_CHORD_OCTAVE_1 + i, 1);
+                postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, CUSTOM_CHORD_ACTIVE_1 + i, 0);
+                postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, CUSTOM_CHORD_NOTE_1 + i, 1);
+                postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, CUSTOM_CHORD_OCTAVE_1 + i, 1);
             }
         }
     
@@ -2552,7 +2684,7 @@ void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newVal
     else if (index >= SHORTCUT_MUTE
              && index <= CHORD_PLAYER_OUTPUT_SELECTION)
     {
-        chordPlayerProcessor->setParameter(synthRef, index, newValue);
+        postParameterChange(ParameterChangeQueue::CHORD_PLAYER, synthRef, index, newValue);
     }
     
     // needs to call ui fuction
@@ -2562,8 +2694,8 @@ void ProjectManager::setChordPlayerParameter(int synthRef, int index, var newVal
 // called from GUI to update controls when neccessary
 var ProjectManager::getChordPlayerParameter(int synthRef, int index)
 {
-    String identifier = getIdentifierForChordPlayerParameterIndex(index);
-    if (identifier.isEmpty())
+    const Identifier& identifier = getParameterIdentifier(chordPlayerIdentifiers, index);
+    if (identifier.isNull())
         return var();  // Return undefined for unhandled indices
     return chordPlayerParameters[synthRef]->getProperty(identifier);
 }
@@ -2642,7 +2774,7 @@ void ProjectManager::initDefaultChordScannerParameters()
     
     for (int i = 0; i < TOTAL_NUM_CHORD_SCANNER_PARAMS; i++)
     {
-        chordScannerProcessor->setParameter(i, chordScannerParameters->getProperty(getIdentifierForChordScannerParameterIndex(i)));
+        postParameterChange(ParameterChangeQueue::CHORD_SCANNER, 0, i, chordScannerParameters->getProperty(getIdentifierForChordScannerParameterIndex(i)));
     }
 }
 
@@ -2657,29 +2789,29 @@ void ProjectManager::setChordScannerParameter(int index, var newValue)
         if (!ex)
         {
             // need to bounds check upper octave
-            int octaveTo = chordScannerParameters->getProperty(getIdentifierForChordScannerParameterIndex(CHORD_SCANNER_OCTAVE_TO));
+            int octaveTo = chordScannerParameters->getProperty(getParameterIdentifier(chordScannerIdentifiers, CHORD_SCANNER_OCTAVE_TO));
             
             if (octaveTo > 10)
             {
                 octaveTo = 10;
                 
-                chordScannerParameters->setProperty(getIdentifierForChordScannerParameterIndex(CHORD_SCANNER_OCTAVE_TO), octaveTo, nullptr);
+                chordScannerParameters->setProperty(getParameterIdentifier(chordScannerIdentifiers, CHORD_SCANNER_OCTAVE_TO), octaveTo, nullptr);
                 
-                chordScannerProcessor->setParameter(CHORD_SCANNER_OCTAVE_TO, octaveTo);
+                postParameterChange(ParameterChangeQueue::CHORD_SCANNER, 0, CHORD_SCANNER_OCTAVE_TO, octaveTo);
 
                 // needs to call ui fuction
                 uiListeners.call(&UIListener::updateChordScannerUIParameter, CHORD_SCANNER_OCTAVE_TO);
             }
             
-            int octaveFrom = chordScannerParameters->getProperty(getIdentifierForChordScannerParameterIndex(CHORD_SCANNER_OCTAVE_FROM));
+            int octaveFrom = chordScannerParameters->getProperty(getParameterIdentifier(chordScannerIdentifiers, CHORD_SCANNER_OCTAVE_FROM));
             
             if (octaveFrom > 10)
             {
                 octaveFrom = 10;
                 
-                chordScannerParameters->setProperty(getIdentifierForChordScannerParameterIndex(CHORD_SCANNER_OCTAVE_FROM), octaveFrom, nullptr);
+                chordScannerParameters->setProperty(getParameterIdentifier(chordScannerIdentifiers, CHORD_SCANNER_OCTAVE_FROM), octaveFrom, nullptr);
                 
-                chordScannerProcessor->setParameter(CHORD_SCANNER_OCTAVE_FROM, octaveFrom);
+                postParameterChange(ParameterChangeQueue::CHORD_SCANNER, 0, CHORD_SCANNER_OCTAVE_FROM, octaveFrom);
 
                 // needs to call ui fuction
                 uiListeners.call(&UIListener::updateChordScannerUIParameter, CHORD_SCANNER_OCTAVE_FROM);
@@ -2688,9 +2820,9 @@ void ProjectManager::setChordScannerParameter(int index, var newValue)
     }
     
     // store new value in paramater valuetree
-    chordScannerParameters->setProperty(getIdentifierForChordScannerParameterIndex(index), newValue, nullptr);
+    chordScannerParameters->setProperty(getParameterIdentifier(chordScannerIdentifiers, index), newValue, nullptr);
     
-    chordScannerProcessor->setParameter(index, newValue);
+    postParameterChange(ParameterChangeQueue::CHORD_SCANNER, 0, index, newValue);
 
     // needs to call ui fuction
     uiListeners.call(&UIListener::updateChordScannerUIParameter, index);
@@ -2699,7 +2831,7 @@ void ProjectManager::setChordScannerParameter(int index, var newValue)
 // called from GUI to update controls when neccessary
 var ProjectManager::getChordScannerParameter(int index)
 {
-    return chordScannerParameters->getProperty(getIdentifierForChordScannerParameterIndex(index));
+    return chordScannerParameters->getProperty(getParameterIdentifier(chordScannerIdentifiers, index));
 }
 
 //===============================================================================
@@ -2770,11 +2902,11 @@ void ProjectManager::initDefaultFrequencyPlayerParameters()
         {
             if (index == FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)
             {
-                frequencyPlayerProcessor->setActiveShortcutSynth(i, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)));
+                postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER_ACTIVE_SHORTCUT, i, FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)));
             }
             else
             {
-                frequencyPlayerProcessor->setParameter(i, index, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)) );
+                postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER, i, index, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)) );
             }
         }
     }
@@ -2813,11 +2945,11 @@ void ProjectManager::initDefaultFrequencyPlayerParametersForShortcut(int shortcu
         {
             if (index == FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)
             {
-                frequencyPlayerProcessor->setActiveShortcutSynth(i, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)));
+                postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER_ACTIVE_SHORTCUT, i, FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)));
             }
             else
             {
-                frequencyPlayerProcessor->setParameter(i, index, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)) );
+                postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER, i, index, frequencyPlayerParameters[i]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(index)) );
             }
         }
 }
@@ -2825,20 +2957,20 @@ void ProjectManager::initDefaultFrequencyPlayerParametersForShortcut(int shortcu
 // called from UI to change individual parameters
 void ProjectManager::setFrequencyPlayerParameter(int synthRef,int index, var newValue)
 {
-    frequencyPlayerParameters[synthRef]->setProperty(getIdentifierForFrequencyPlayerParameterIndex(index), newValue, nullptr);
+    frequencyPlayerParameters[synthRef]->setProperty(getParameterIdentifier(frequencyPlayerIdentifiers, index), newValue, nullptr);
     
     // check if active param // mmm
     if (index == FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)
     {
-        frequencyPlayerProcessor->setActiveShortcutSynth(synthRef, (bool) chordPlayerParameters[synthRef]->getProperty( getIdentifierForFrequencyPlayerParameterIndex(FREQUENCY_PLAYER_SHORTCUT_IS_ACTIVE)) );
-        frequencyPlayerProcessor->setParameter(synthRef, index, newValue);
+        // setParameter activates the shortcut and its repeater
+        postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER, synthRef, index, newValue);
         
         // init defaults
 //        initDefaultFrequencyPlayerParametersForShortcut(synthRef);
     }
     else //if (index >= FREQUENCY_PLAYER_SHORTCUT_MUTE && index <= FREQUENCY_PLAYER_NUM_DURATION)
     {
-        frequencyPlayerProcessor->setParameter(synthRef, index, newValue);
+        postParameterChange(ParameterChangeQueue::FREQUENCY_PLAYER, synthRef, index, newValue);
     }
     
     // needs to call ui fuction
@@ -2848,7 +2980,7 @@ void ProjectManager::setFrequencyPlayerParameter(int synthRef,int index, var new
 // called from GUI to update controls when neccessary
 var ProjectManager::getFrequencyPlayerParameter(int synthRef,int index)
 {
-    return frequencyPlayerParameters[synthRef]->getProperty(getIdentifierForFrequencyPlayerParameterIndex(index));
+    return frequencyPlayerParameters[synthRef]->getProperty(getParameterIdentifier(frequencyPlayerIdentifiers, index));
 }
 
 //===============================================================================
@@ -2906,16 +3038,16 @@ void ProjectManager::initDefaultFrequencyScannerParameters()
     
     for (int index = 0; index < TOTAL_NUM_FREQUENCY_SCANNER_PARAMS; index++)
     {
-        frequencyScannerProcessor->setParameter(index, frequencyScannerParameters->getProperty( getIdentifierForFrequencyScannerParameterIndex(index)) );
+        postParameterChange(ParameterChangeQueue::FREQUENCY_SCANNER, 0, index, frequencyScannerParameters->getProperty( getIdentifierForFrequencyScannerParameterIndex(index)) );
     }
 }
 
 // called from UI to change individual parameters
 void ProjectManager::setFrequencyScannerParameter(int index, var newValue)
 {
-    frequencyScannerParameters->setProperty(getIdentifierForFrequencyScannerParameterIndex(index), newValue, nullptr);
+    frequencyScannerParameters->setProperty(getParameterIdentifier(frequencyScannerIdentifiers, index), newValue, nullptr);
     
-    frequencyScannerProcessor->setParameter(index, newValue);
+    postParameterChange(ParameterChangeQueue::FREQUENCY_SCANNER, 0, index, newValue);
 
     // needs to call ui fuction
     uiListeners.call(&UIListener::updateFrequencyScannerUIParameter , index);
@@ -2924,7 +3056,7 @@ void ProjectManager::setFrequencyScannerParameter(int index, var newValue)
 // called from GUI to update controls when neccessary
 var ProjectManager::getFrequencyScannerParameter(int index)
 {
-    return frequencyScannerParameters->getProperty(getIdentifierForFrequencyScannerParameterIndex(index));
+    return frequencyScannerParameters->getProperty(getParameterIdentifier(frequencyScannerIdentifiers, index));
 }
 
 //===============================================================================
@@ -3052,10 +3184,7 @@ void ProjectManager::setNewFFTSize(int fftEnum)
 
     shouldProcessFFT    = false;
     
-    for (int i = 0; i < 8; i++)
-    {
-        analyser[i].setNewFFTSize(fftSizeEnumValue);
-    }
+    analyzerPool.setNewFFTSizeAll(fftSizeEnumValue);
 
     uiListeners.call(&UIListener::updateSettingsUIParameter, FFT_SIZE);
     
@@ -3067,22 +3196,14 @@ void ProjectManager::setNewFFTWindowFunction(int windowEnum)
 {
     shouldProcessFFT    = false;
     
-    for (int i = 0; i < 8; i++)
-    {
-        analyser[i].setNewFFTWindowFunction(windowEnum);
-    }
+    analyzerPool.setNewFFTWindowFunctionAll(windowEnum);
 
     shouldProcessFFT    = true;
 }
 
 void ProjectManager::initFFT()
 {
-    outputAnalyser.initFFT();
-    
-    for (int i = 0; i < 8; i++)
-    {
-        analyser[i].initFFT();
-    }
+    analyzerPool.initFFTAll();
 }
 
 
@@ -3107,7 +3228,7 @@ void ProjectManager::createAnalyserPlot (int fftChannel, Path& p, const Rectangl
 {
     if (fftChannel >= 0 && fftChannel < 8)
     {
-        analyser[fftChannel].createPath (p, bounds.toFloat(), minFreq, maxFreq);
+        analyzerPool.getAnalyzer(fftChannel).createPath (p, bounds.toFloat(), minFreq, maxFreq);
     }
 }
 
@@ -3120,7 +3241,7 @@ void ProjectManager::createAnalyserPlotOptimisedWithRange (int fftChannel, Path&
 {
     if (fftChannel >= 0 && fftChannel < 8)
     {
-        analyser[fftChannel].createPathOptimisedWithRange (p, bounds.toFloat(), minFreq, maxFreq, minDB, maxDB);
+        analyzerPool.getAnalyzer(fftChannel).createPathOptimisedWithRange (p, bounds.toFloat(), minFreq, maxFreq, minDB, maxDB);
     }
 }
 
@@ -3150,19 +3271,19 @@ void ProjectManager::createOctaveMagnitudes(int fftChannel, Array<float> & magni
         return;
     }
 
-    analyser[fftChannel].getMagnitudeDataForOctave(magnitude, numBands, minFreq, maxFreq, sampleRate, centralFreqs);
+    analyzerPool.getAnalyzer(fftChannel).getMagnitudeDataForOctave(magnitude, numBands, minFreq, maxFreq, sampleRate, centralFreqs);
 }
 
-void ProjectManager::createColourSpectrum(Image & imageToRenderTo, float minFreq, float maxFreq, float logScale)
+void ProjectManager::createColourSpectrum(Image & imageToRenderTo, int column, float minFreq, float maxFreq)
 {
-//    outputAnalyser.createColourSpectrum(imageToRenderTo, minFreq, maxFreq, logScale);
+//    outputAnalyser.createColourSpectrum(imageToRenderTo, column, minFreq, maxFreq);
 }
 
-void ProjectManager::createColourSpectrum(int fftChannel, Image & imageToRenderTo, float minFreq, float maxFreq, float logScale)
+void ProjectManager::createColourSpectrum(int fftChannel, Image & imageToRenderTo, int column, float minFreq, float maxFreq)
 {
     if (fftChannel >= 0 && fftChannel < 8)
     {
-        analyser[fftChannel].createColourSpectrum(imageToRenderTo, minFreq, maxFreq, logScale);
+        analyzerPool.getAnalyzer(fftChannel).createColourSpectrum(imageToRenderTo, column, minFreq, maxFreq);
     }
 }
 
@@ -3189,7 +3310,7 @@ void ProjectManager::createFrequencyData(int fftChannel, double & peakFrequency,
 {
     if (fftChannel >= 0 && fftChannel < 8)
     {
-        analyser[fftChannel].getFrequencyData(peakFrequency, peakDB, upperHarmonics, intervals, ema);
+        analyzerPool.getAnalyzer(fftChannel).getFrequencyData(peakFrequency, peakDB, upperHarmonics, intervals, ema);
         
         // if its recording, logging should be called from here..
         
@@ -3216,7 +3337,7 @@ void ProjectManager::getMovingAveragePeakData(int fftChannel, double & _peakFreq
 {
     if (fftChannel >= 0 && fftChannel < 8)
     {
-        analyser[fftChannel].getMovingAveragePeakData(_peakFreq, _peakDB, _movingAvgFreq);
+        analyzerPool.getAnalyzer(fftChannel).getMovingAveragePeakData(_peakFreq, _peakDB, _movingAvgFreq);
     }
 }
 
@@ -3226,7 +3347,7 @@ void ProjectManager::getMovingAveragePeakData(int fftChannel, double & _peakFreq
 
 uint64 ProjectManager::getRecordCounterInMilliseconds()
 {
-    recordCounterInMilliseconds = (int64)recordCounterInSamples / 44100.f * 1000.f;
+    recordCounterInMilliseconds = sample_rate > 0.0 ? (uint64)(recorder.getNumRecordedSamples() / sample_rate * 1000.0) : 0;
     
     return recordCounterInMilliseconds;
 }
@@ -3345,71 +3466,50 @@ void ProjectManager::createNewFileForRecordingFrequencyPlayer()
 //==============================================================================
 void ProjectManager::setupRecording (const File& file)
 {
-    stopRecording();
-
-    double sampleRate = getSampleRate();
+    uint32 channelMask = (uint32)(int)getProjectSettingsParameter(RECORD_CHANNELS);
     
-    auto currentDev             = deviceManager->getCurrentAudioDevice();
-    auto numInputChannels       = currentDev->getActiveInputChannels();
+    // leave out channels the device doesn't have, rather than writing silence for them
+    if (auto* currentDev = deviceManager->getCurrentAudioDevice())
     {
-        // Create an OutputStream to write to our destination file...
-        file.deleteFile();
-
-        // FIXED: Use smart pointer for FileOutputStream
-        auto fileStream = std::make_unique<FileOutputStream>(file);
+        const int numOutputs = currentDev->getActiveOutputChannels().countNumberOfSetBits();
+        const int numInputs  = currentDev->getActiveInputChannels().countNumberOfSetBits();
         
-        if (fileStream != nullptr)
-        {
-            // Now create a WAV writer object that writes to our output stream...
-            
-            // variable format test
-            AudioFormatWriter * writer = formatManager.getKnownFormat(recordFileFormatIndex)->createWriterFor (fileStream.release(), sampleRate, 2, 24, {}, 0);
-
-            if (writer != nullptr)
-            {
-                // Now we'll create one of these helper objects which will act as a FIFO buffer, and will
-                // write the data to disk on our background thread.
-                threadedWriter = std::make_unique<AudioFormatWriter::ThreadedWriter>(writer, backgroundThread, 32768);
-
-                // And now, swap over our active writer pointer so that the audio callback will start using it..
-                const ScopedLock sl (writerLock);
-                activeWriter = threadedWriter.get();
-                
-                recordCounterInSamples = 0;
-            }
-        }
+        for (int i = numOutputs; i < RecordingManager::numOutputs; i++)  channelMask &= ~RecordingManager::getOutputBit(i);
+        for (int i = numInputs;  i < RecordingManager::numInputs;  i++)  channelMask &= ~RecordingManager::getInputBit(i);
+    }
+    
+    const bool filePerChannel = (bool)getProjectSettingsParameter(RECORD_FILE_PER_CHANNEL);
+    
+    if (! recorder.open(file, *formatManager.getKnownFormat(recordFileFormatIndex), channelMask, filePerChannel, getSampleRate(), 24))
+    {
+        Logger::writeToLog("ProjectManager::setupRecording - could not create " + file.getFullPathName());
     }
 }
 
 void ProjectManager::startRecording ()
 {
-    shouldRecord    = true;
+    recorder.start();
     
 //    logFileWriter->startRecordingLog();
 }
 
 void ProjectManager::stopRecording()
 {
-    // First, clear this pointer to stop the audio callback from using our writer object..
-    {
-        const ScopedLock sl (writerLock);
-        activeWriter = nullptr;
-    }
-
-    // Now we can delete the writer object. It's done in this order because the deletion could
-    // take a little time while remaining data gets flushed to disk, so it's best to avoid blocking
-    // the audio callback while this happens.
-    threadedWriter.reset();
-    
-    shouldRecord    = false;
-    
+    // blocks the disk couldn't keep up with were left out of the recording
+    const int numOverruns = recorder.isOpen() ? recorder.getNumOverruns() : 0;
     
+    recorder.stop();
     
+    if (numOverruns > 0)
+    {
+        Logger::writeToLog("ProjectManager::stopRecording - " + String(numOverruns) + " blocks, "
+                           + String(recorder.getNumDroppedSamples() / jmax(1.0, sample_rate), 3) + " s dropped");
+    }
 }
 
 bool ProjectManager::isRecording() const
 {
-    return activeWriter != nullptr;
+    return recorder.isOpen();
 }
 
 
@@ -3598,6 +3698,8 @@ bool ProjectManager::LogFileWriter::isRecordingLog()
 // When audioMode changes, create a new log file timestamped...
 void ProjectManager::LogFileWriter::initNewLogFileForAudioMode(AUDIO_MODE newMode)
 {
+    const ScopedLock sl (fileLock);
+    
     // delete old file is it contains zero data
     if (logAudioMode != newMode)
     {
@@ -3864,84 +3966,18 @@ void ProjectManager::LogFileWriter::processLog_ChordPlayer_Parameters()
         }
     }
     
-    logFile[AUDIO_MODE::MODE_CHORD_PLAYER].appendText(outputString);
+    appendToLogFile(AUDIO_MODE::MODE_CHORD_PLAYER, outputString);
 }
 
-void ProjectManager::LogFileWriter::processLog_ChordPlayer_Sequencer(int shortcutRef, const Array<String>& noteStrings, const Array<float>& noteFreqs)
+void ProjectManager::LogFileWriter::processLog_ChordPlayer_Sequencer(int shortcutRef, SequencerEvent& event)
 {
     // pushes chord and note frequencis to the log....
-    jassert(noteStrings.size() == noteFreqs.size());
-    String outputString("\n\n");
-    
-    outputString.append(getDateAndTimeString(), 100); outputString.append(" | ", 3);
-
-    String chordString("CHORD PLAYER OUTPUT UNIT ");
-    String unitString(shortcutRef);
-    chordString.append(unitString, 2);
-    chordString.append(" | ", 3);
-    outputString.append(chordString, 30);
-    
-    Array<int> notes            = projectManager->chordPlayerProcessor->chordManager[shortcutRef]->getMIDIKeysForChord();
-
-
-    String stringNoteFrequencies;
-    for (int i = 0; i < notes.size(); i++)
-    {
-        String keyNote = noteStrings[i];
-        String keyFreqString(noteFreqs.getReference(i), 3, false); keyFreqString.append("hz", 2);
-
-        stringNoteFrequencies.append(keyNote, 4);
-        stringNoteFrequencies.append(" ", 4);
-        stringNoteFrequencies.append(keyFreqString, 10);
-        
-        if (i < notes.size() - 1)
-        {
-            stringNoteFrequencies.append(" - ", 4);
-        }
-    }
-    
-    outputString.append(stringNoteFrequencies, 200);
-
-    Array<float> upperHarmonics;
-    Array<float> intervals;
-
-    for (int i = 0; i < 6; i++) {
-        float c = 0.f; upperHarmonics.add(c); intervals.add(c);
-    }
-
-//    projectManager->outputAnalyser.getFrequencyData(peakFrequency, peakDB, upperHarmonics, intervals, ema);
-
-    String newEntry(" | ");
-
-    // add harmonics
-    String harmonicString1(upperHarmonics.getReference(1), 3, false); harmonicString1.append("hz", 2);
-    String harmonicString2(upperHarmonics.getReference(2), 3, false); harmonicString2.append("hz", 2);
-    String harmonicString3(upperHarmonics.getReference(3), 3, false); harmonicString3.append("hz", 2);
-    String harmonicString4(upperHarmonics.getReference(4), 3, false); harmonicString4.append("hz", 2);
-    String harmonicString5(upperHarmonics.getReference(5), 3, false); harmonicString5.append("hz", 2);
-
-    newEntry.append(harmonicString1, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString2, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString3, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString4, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString5, 20); newEntry.append(" | ", 3);
-
-    String intervalString1(intervals.getReference(1), 3, false); intervalString1.append("hz", 2);
-    String intervalString2(intervals.getReference(2), 3, false); intervalString2.append("hz", 2);
-    String intervalString3(intervals.getReference(3), 3, false); intervalString3.append("hz", 2);
-    String intervalString4(intervals.getReference(4), 3, false); intervalString4.append("hz", 2);
-    String intervalString5(intervals.getReference(5), 3, false); intervalString5.append("hz", 2);
-
-    newEntry.append(intervalString1, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString2, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString3, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString4, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString5, 20);
-
-    outputString.append(newEntry, 200);
+    jassert(isPositiveAndNotGreaterThan(event.numNotes, (int)SequencerEvent::maxNotes));
     
+    event.type          = SequencerEvent::CHORD_PLAYER;
+    event.shortcutRef   = shortcutRef;
     
-    logFile[AUDIO_MODE::MODE_CHORD_PLAYER].appendText(outputString);
+    postSequencerEvent(event);
 }
 
 // ChordScanner
@@ -4094,96 +4130,24 @@ void ProjectManager::LogFileWriter::processLog_ChordScanner_Parameters()
     newEntry.append(stringBaseA, 16); newEntry.append(" | ", 3);
     newEntry.append(stringScale, 30);
 
-    logFile[AUDIO_MODE::MODE_CHORD_SCANNER].appendText(newEntry);
+    appendToLogFile(AUDIO_MODE::MODE_CHORD_SCANNER, newEntry);
 }
 
-void ProjectManager::LogFileWriter::processLog_ChordScanner_Sequencer(bool isAllChords, Array<int> notes, Array<float> noteFreqs)
+void ProjectManager::LogFileWriter::processLog_ChordScanner_Sequencer(bool isAllChords, SequencerEvent& event)
 {
-    // only chord and note frequencies
-    String newEntry("\n\n");
-
-    newEntry.append(getDateAndTimeString(), 100);
-    
-    newEntry.append(" | ", 3); newEntry.append("CHORD SCANNER OUTPUT", 15); newEntry.append(" | ", 3);
+    // only chord and note frequencies, the scan position is taken now as the repeater moves on
+    jassert(isPositiveAndNotGreaterThan(event.numNotes, (int)SequencerEvent::maxNotes));
     
-    String stringNoteFrequencies;
+    event.type          = SequencerEvent::CHORD_SCANNER;
+    event.isAllChords   = isAllChords;
+    event.octave        = projectManager->chordScannerProcessor->repeater->octaveIterator;
+    event.chordType     = projectManager->chordScannerProcessor->repeater->chordTypeIterator - 1;
+    event.keynote       = projectManager->chordScannerProcessor->repeater->keynoteIterator - 1;
     
-    int octaveIterator          = projectManager->chordScannerProcessor->repeater->octaveIterator;
-    int chordType               = projectManager->chordScannerProcessor->repeater->chordTypeIterator - 1;
-    int keynote                 = projectManager->chordScannerProcessor->repeater->keynoteIterator - 1;
-   
-    for (int i = 0; i < notes.size(); i++)
-    {
-        // get the note
-        int key         = notes.getReference(i);
-        int octave      = octaveIterator;
- 
-        String keyNote(ProjectStrings::getKeynoteArray().getReference(key));
-        String oct(octave); keyNote.append(oct, 2);
-    
-        String keyFreqString(noteFreqs.getReference(i), 3, false); keyFreqString.append("hz", 2);
-      
-        stringNoteFrequencies.append(keyNote, 4);
-        stringNoteFrequencies.append(" ", 4);
-        stringNoteFrequencies.append(keyFreqString, 30);
-        
-        if (i < notes.size() - 1)
-        {
-            stringNoteFrequencies.append(" - ", 4);
-        }
-        
-    }
-    
-    String stringKeynote(ProjectStrings::getKeynoteArray().getReference(keynote));
-    String stringOctave(octaveIterator);
-    String stringChordtype(ProjectStrings::getChordTypeArray().getReference(chordType));
-    
-    if (!isAllChords)
-    {
-        newEntry.append(stringKeynote, 10);     newEntry.append(" ", 1);
-        newEntry.append(stringChordtype, 20);   newEntry.append(" | ", 3);
-    }
-
-    
-    // note frequencies
-    newEntry.append(stringNoteFrequencies, 300);
-    Array<float> upperHarmonics;
-    Array<float> intervals;
-
-    for (int i = 0; i < 6; i++)
-    {
-        float c = 0.f; upperHarmonics.add(c); intervals.add(c);
-    }
-
-    newEntry.append(" | ", 3);
-
-    // add harmonics
-    String harmonicString1(upperHarmonics.getReference(1), 3, false); harmonicString1.append("hz", 2);
-    String harmonicString2(upperHarmonics.getReference(2), 3, false); harmonicString2.append("hz", 2);
-    String harmonicString3(upperHarmonics.getReference(3), 3, false); harmonicString3.append("hz", 2);
-    String harmonicString4(upperHarmonics.getReference(4), 3, false); harmonicString4.append("hz", 2);
-    String harmonicString5(upperHarmonics.getReference(5), 3, false); harmonicString5.append("hz", 2);
-
-    newEntry.append(harmonicString1, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString2, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString3, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString4, 20); newEntry.append(" | ", 3);
-    newEntry.append(harmonicString5, 20); newEntry.append(" | ", 3);
-
-    String intervalString1(intervals.getReference(1), 3, false); intervalString1.append("hz", 2);
-    String intervalString2(intervals.getReference(2), 3, false); intervalString2.append("hz", 2);
-    String intervalString3(intervals.getReference(3), 3, false); intervalString3.append("hz", 2);
-    String intervalString4(intervals.getReference(4), 3, false); intervalString4.append("hz", 2);
-    String intervalString5(intervals.getReference(5), 3, false); intervalString5.append("hz", 2);
-
-    newEntry.append(intervalString1, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString2, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString3, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString4, 20); newEntry.append(" | ", 3);
-    newEntry.append(intervalString5, 20);
+    for (int i = 0; i < event.numNotes; i++)
+        event.noteOctaves[i] = event.octave;
     
-
-    logFile[AUDIO_MODE::MODE_CHORD_SCANNER].appendText(newEntry);
+    postSequencerEvent(event);
 }
 
 // FrequencyPlayer
@@ -4333,25 +4297,18 @@ void ProjectManager::LogFileWriter::processLog_FrequencyPlayer_Parameters()
         }
     }
     
-    logFile[AUDIO_MODE::MODE_FREQUENCY_PLAYER].appendText(outputString);
+    appendToLogFile(AUDIO_MODE::MODE_FREQUENCY_PLAYER, outputString);
     
 }
 
 void ProjectManager::LogFileWriter::processLog_FrequencyPlayer_Sequencer(int shortcutRef, float freq)
 {
-    // needs to get frequency from parameters
+    SequencerEvent event;
+    event.type          = SequencerEvent::FREQUENCY_PLAYER;
+    event.shortcutRef   = shortcutRef;
+    event.frequency     = freq;
     
-    // only chord and note frequencies
-       String newEntry("\n\n");
-       
-       newEntry.append(getDateAndTimeString(), 100); newEntry.append(" | ", 3);
-        newEntry.append("FREQUENCY PLAYER OUTPUT UNIT ", 50);   String unit(shortcutRef); newEntry.append(unit, 3);   newEntry.append(" | ", 3);
-       
-       String stringFrequency(freq, 3, false);
-       stringFrequency.append(" hz", 3);
-       newEntry.append(stringFrequency, 40);
-    
-       logFile[AUDIO_MODE::MODE_FREQUENCY_PLAYER].appendText(newEntry);
+    postSequencerEvent(event);
 }
 
 // FrequencyScanner
@@ -4466,22 +4423,16 @@ void ProjectManager::LogFileWriter::processLog_FrequencyScanner_Parameters()
     newEntry.append(lengthString, 10);  newEntry.append(" | ", 3);
     newEntry.append(pauseString, 10);   newEntry.append(" | ", 3);
 
-    logFile[AUDIO_MODE::MODE_FREQUENCY_SCANNER].appendText(newEntry);
+    appendToLogFile(AUDIO_MODE::MODE_FREQUENCY_SCANNER, newEntry);
 }
 
 void ProjectManager::LogFileWriter::processLog_FrequencyScanner_Sequencer(float freq)
 {
-    String newEntry("\n\n");
-    
-    newEntry.append(getDateAndTimeString(), 100); newEntry.append(" | ", 3);
-    newEntry.append("FREQUENCY SCANNER OUTPUT ", 40);      newEntry.append(" | ", 3);
-    
-    String stringFrequency(freq, 3, false);
-    stringFrequency.append(" hz", 3);
-    newEntry.append(stringFrequency, 40);
-    
-    logFile[AUDIO_MODE::MODE_FREQUENCY_SCANNER].appendText(newEntry);
+    SequencerEvent event;
+    event.type          = SequencerEvent::FREQUENCY_SCANNER;
+    event.frequency     = freq;
     
+    postSequencerEvent(event);
 }
 
 void ProjectManager::LogFileWriter::processLog_FundamentalFrequency_Sequencer(                                                                const String& fundamental, const juce::String &chord, const Array<String>& harmonics)
@@ -4502,7 +4453,7 @@ void ProjectManager::LogFileWriter::processLog_FundamentalFrequency_Sequencer(
         newEntry.append(harmonic, 15);
     }
     
-    logFile[AUDIO_MODE::MODE_FUNDAMENTAL_FREQUENCY].appendText(newEntry);
+    appendToLogFile(AUDIO_MODE::MODE_FUNDAMENTAL_FREQUENCY, newEntry);
 }
 
 void ProjectManager::LogFileWriter::processLog_FrequencyToLight(String conversionType, String base, String wavelength, String rgbHex, StringArray manipulationStrings)
@@ -4523,7 +4474,7 @@ void ProjectManager::LogFileWriter::processLog_FrequencyToLight(String conversio
         newEntry.append(manipulationStrings.getReference(i), 50);
     }
     
-    logFile[AUDIO_MODE::MODE_FREQUENCY_TO_LIGHT].appendText(newEntry);
+    appendToLogFile(AUDIO_MODE::MODE_FREQUENCY_TO_LIGHT, newEntry);
 }
 
 void ProjectManager::LogFileWriter::processLog_PanicButtonPressed(int noise_type)
@@ -4541,7 +4492,7 @@ void ProjectManager::LogFileWriter::processLog_PanicButtonPressed(int noise_type
         newEntry.append(" | PINK NOISE", 30);
     }
     
-    logFile[logAudioMode].appendText(newEntry);
+    appendToLogFile(logAudioMode, newEntry);
 }
 
 void ProjectManager::LogFileWriter::initNewSettingsLogFile()
@@ -4795,11 +4746,201 @@ void ProjectManager::LogFileWriter::checkForOldLoggingFile()
     // if dif > 7 days, delete file
 }
 
-String ProjectManager::LogFileWriter::getDateAndTimeString()
+//==============================================================================
+// Writer thread
+//==============================================================================
+void ProjectManager::LogFileWriter::run()
+{
+    while (!threadShouldExit())
+    {
+        flushPendingEvents();
+        eventsWritten.signal();
+        
+        wait(flushIntervalMs);
+    }
+}
+
+void ProjectManager::LogFileWriter::postSequencerEvent(SequencerEvent& event)
+{
+    event.timeMillis = Time::currentTimeMillis();
+    
+    auto* messageManager        = MessageManager::getInstanceWithoutCreating();
+    const bool isMessageThread  = messageManager != nullptr && messageManager->isThisTheMessageThread();
+    
+    auto& queue = isMessageThread ? messageThreadEvents : audioThreadEvents;
+    
+    // never block the caller, a full queue costs log entries rather than audio
+    if (!queue.try_push(event))
+        numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ProjectManager::LogFileWriter::flushPendingEvents()
+{
+    String batch[AUDIO_MODE::NUM_MODES];
+    
+    SequencerEvent event;
+    
+    // merge both producers back into time order
+    for (;;)
+    {
+        const auto* fromAudio   = audioThreadEvents.peek();
+        const auto* fromMessage = messageThreadEvents.peek();
+        
+        if (fromAudio == nullptr && fromMessage == nullptr)
+            break;
+        
+        if (fromMessage == nullptr || (fromAudio != nullptr && fromAudio->timeMillis <= fromMessage->timeMillis))
+            audioThreadEvents.try_pop(event);
+        else
+            messageThreadEvents.try_pop(event);
+        
+        switch (event.type)
+        {
+            case SequencerEvent::CHORD_PLAYER:      batch[AUDIO_MODE::MODE_CHORD_PLAYER]        += formatSequencerEvent(event); break;
+            case SequencerEvent::CHORD_SCANNER:     batch[AUDIO_MODE::MODE_CHORD_SCANNER]       += formatSequencerEvent(event); break;
+            case SequencerEvent::FREQUENCY_PLAYER:  batch[AUDIO_MODE::MODE_FREQUENCY_PLAYER]    += formatSequencerEvent(event); break;
+            case SequencerEvent::FREQUENCY_SCANNER: batch[AUDIO_MODE::MODE_FREQUENCY_SCANNER]   += formatSequencerEvent(event); break;
+                
+            default: break;
+        }
+    }
+    
+    const int numDropped = numDroppedEvents.exchange(0);
+    
+    const ScopedLock sl (fileLock);
+    
+    if (numDropped > 0)
+    {
+        batch[logAudioMode] << "\n\n" << getDateAndTimeString() << " | " << numDropped << " LOG ENTRIES DROPPED";
+    }
+    
+    // one write per file per pass
+    for (int mode = 0; mode < AUDIO_MODE::NUM_MODES; mode++)
+    {
+        if (batch[mode].isNotEmpty() && logFile[mode] != File())
+            logFile[mode].appendText(batch[mode]);
+    }
+}
+
+void ProjectManager::LogFileWriter::appendToLogFile(int audioMode, const String& text)
+{
+    const ScopedLock sl (fileLock);
+    
+    logFile[audioMode].appendText(text);
+}
+
+String ProjectManager::LogFileWriter::formatSequencerEvent(const SequencerEvent& event)
+{
+    String newEntry("\n\n");
+    
+    newEntry.append(getDateAndTimeString(Time(event.timeMillis)), 100); newEntry.append(" | ", 3);
+    
+    if (event.type == SequencerEvent::CHORD_PLAYER)
+    {
+        String chordString("CHORD PLAYER OUTPUT UNIT ");
+        String unitString(event.shortcutRef);
+        chordString.append(unitString, 2);
+        chordString.append(" | ", 3);
+        newEntry.append(chordString, 30);
+        
+        String stringNoteFrequencies;
+        for (int i = 0; i < event.numNotes; i++)
+        {
+            String keyNote(ProjectStrings::getKeynoteArray()[event.notes[i] % 12]);
+            keyNote.append(String(event.noteOctaves[i]), 2);
+            
+            String keyFreqString(event.noteFreqs[i], 3, false); keyFreqString.append("hz", 2);
+            
+            stringNoteFrequencies.append(keyNote, 4);
+            stringNoteFrequencies.append(" ", 4);
+            stringNoteFrequencies.append(keyFreqString, 10);
+            
+            if (i < event.numNotes - 1)
+            {
+                stringNoteFrequencies.append(" - ", 4);
+            }
+        }
+        
+        newEntry.append(stringNoteFrequencies, 200);
+        newEntry.append(" | ", 3);
+        newEntry.append(formatEmptyHarmonicsAndIntervals(), 200);
+    }
+    else if (event.type == SequencerEvent::CHORD_SCANNER)
+    {
+        newEntry.append("CHORD SCANNER OUTPUT", 15); newEntry.append(" | ", 3);
+        
+        String stringNoteFrequencies;
+        for (int i = 0; i < event.numNotes; i++)
+        {
+            String keyNote(ProjectStrings::getKeynoteArray()[event.notes[i] % 12]);
+            String oct(event.noteOctaves[i]); keyNote.append(oct, 2);
+            
+            String keyFreqString(event.noteFreqs[i], 3, false); keyFreqString.append("hz", 2);
+            
+            stringNoteFrequencies.append(keyNote, 4);
+            stringNoteFrequencies.append(" ", 4);
+            stringNoteFrequencies.append(keyFreqString, 30);
+            
+            if (i < event.numNotes - 1)
+            {
+                stringNoteFrequencies.append(" - ", 4);
+            }
+        }
+        
+        if (!event.isAllChords)
+        {
+            newEntry.append(ProjectStrings::getKeynoteArray()[event.keynote], 10);        newEntry.append(" ", 1);
+            newEntry.append(ProjectStrings::getChordTypeArray()[event.chordType], 20);    newEntry.append(" | ", 3);
+        }
+        
+        // note frequencies
+        newEntry.append(stringNoteFrequencies, 300);
+        newEntry.append(" | ", 3);
+        newEntry.append(formatEmptyHarmonicsAndIntervals(), 200);
+    }
+    else if (event.type == SequencerEvent::FREQUENCY_PLAYER)
+    {
+        newEntry.append("FREQUENCY PLAYER OUTPUT UNIT ", 50);   String unit(event.shortcutRef); newEntry.append(unit, 3);   newEntry.append(" | ", 3);
+        
+        String stringFrequency(event.frequency, 3, false);
+        stringFrequency.append(" hz", 3);
+        newEntry.append(stringFrequency, 40);
+    }
+    else if (event.type == SequencerEvent::FREQUENCY_SCANNER)
+    {
+        newEntry.append("FREQUENCY SCANNER OUTPUT ", 40);      newEntry.append(" | ", 3);
+        
+        String stringFrequency(event.frequency, 3, false);
+        stringFrequency.append(" hz", 3);
+        newEntry.append(stringFrequency, 40);
+    }
+    
+    return newEntry;
+}
+
+// harmonics and intervals are not analysed for the sequencer logs yet, the columns are kept so
+// every row has the same layout
+String ProjectManager::LogFileWriter::formatEmptyHarmonicsAndIntervals()
+{
+    String zeroString(0.f, 3, false); zeroString.append("hz", 2);
+    
+    String newEntry;
+    
+    for (int i = 0; i < 10; i++)
+    {
+        newEntry.append(zeroString, 20);
+        
+        if (i < 9)
+            newEntry.append(" | ", 3);
+    }
+    
+    return newEntry;
+}
+
+String ProjectManager::LogFileWriter::getDateAndTimeString(Time time)
 {
     String newEntry;
 
-    Time time = Time::getCurrentTime();
     String DD(time.getDayOfMonth());
     
     int months = time.getMonth() + 1; String mon(months); String MM;
@@ -5244,9 +5385,27 @@ void ProjectManager::loadSettingsFile()
        FileInputStream fileInputStream(res);
        ValueTree maintree = ValueTree::readFromStream(fileInputStream);
     
-       if (maintree.getNumProperties() == TOTAL_NUM_SETTINGS)
+       // files saved before a setting was added don't have it, so count the settings the
+       // file does have and let the defaults stand in for the rest
+       int numKnownSettings = 0;
+
+       for (int index = 0; index < TOTAL_NUM_SETTINGS; index++)
        {
-           projectSettings->copyPropertiesFrom(maintree, nullptr);
+           if (maintree.hasProperty(getIdentifierForSettingIndex(index)))
+               numKnownSettings++;
+       }
+
+       if (numKnownSettings > 0 && numKnownSettings == maintree.getNumProperties())
+       {
+           initDefaultProjectSettings();
+
+           for (int index = 0; index < TOTAL_NUM_SETTINGS; index++)
+           {
+               const Identifier identifier = getIdentifierForSettingIndex(index);
+
+               if (maintree.hasProperty(identifier))
+                   projectSettings->setProperty(identifier, maintree.getProperty(identifier), nullptr);
+           }
 
            for (int index = 0; index < TOTAL_NUM_SETTINGS; index++)
            {
@@ -5319,9 +5478,7 @@ void ProjectManager::cleanup() noexcept
     try 
     {
         // Stop background processing first
-        if (backgroundThread.isThreadRunning()) {
-            backgroundThread.stopThread(1000);
-        }
+        recorder.stop();
         
         // Clean up processors in reverse order
         lissajousProcessor.reset();
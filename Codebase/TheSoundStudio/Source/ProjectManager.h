@@ -27,12 +27,17 @@
 #include "FrequencyManager.h"
 #include "ChordManager.h"
 #include "PluginAssignProcessor.h"
+#include "PluginSlotGraph.h"
+#include "ParameterChangeQueue.h"
 #include "RingBuffer.h"
 #include "NoiseOscillator.h"
 #include "FundamentalFrequencyProcessor.h"
 #include "FeedbackModuleProcessor.h"
-#include "AnalyzerNew.h"
+#include "AnalyzerPool.h"
+#include "CallbackProfiler.h"
+#include "RecordingManager.h"
 #include "RealtimeAnalysisProcessor.h"
+#include "utilities/spsc_queue.h"
 #include <memory>
 #include <atomic>
 #include <mutex>
@@ -381,6 +386,9 @@ public:
     // FIXED: Smart pointer array for memory safety
     std::array<std::unique_ptr<PluginAssignProcessor>, NUM_PLUGIN_SLOTS> pluginAssignProcessor;
     
+    // runs the slots on their PLUGIN_OUTPUT routing
+    PluginSlotGraph pluginSlotGraph { pluginAssignProcessor };
+    
     // FIXED: Smart pointers for memory safety
     std::unique_ptr<ApplicationProperties> appProperties;
     std::unique_ptr<KnownPluginList> knownPluginList;
@@ -462,9 +470,8 @@ public:
     // new  FFT threader
     //=====================================================================================
     
-    AnalyserNew<float> outputAnalyser;
-    
-    AnalyserNew<float> analyser[8]; 
+    // 0-3 input channels, 4-7 output channels
+    AnalyzerPool analyzerPool;
 
     
     void createAnalyserPlot (Path& p, const Rectangle<int> bounds, float minFreq, float maxFreq, bool input);
@@ -476,8 +483,8 @@ public:
     void createOctaveMagnitudes(Array<float> & magnitude, int & numBands, float minFreq, float maxFreq, Array<float> & centralFreqs);
     void createOctaveMagnitudes(int fftChannel, Array<float> & magnitude, int & numBands, float minFreq, float maxFreq, Array<float> & centralFreqs);
     
-    void createColourSpectrum(Image & imageToRenderTo, float minFreq, float maxFreq, float logScale);
-    void createColourSpectrum(int fftChannel, Image & imageToRenderTo, float minFreq, float maxFreq, float logScale);
+    void createColourSpectrum(Image & imageToRenderTo, int column, float minFreq, float maxFreq);
+    void createColourSpectrum(int fftChannel, Image & imageToRenderTo, int column, float minFreq, float maxFreq);
     
     void createFrequencyData(double & peakFrequency, double & peakDB, Array<float> & upperHarmonics, Array<float> & lowerHarmonics, int & keynote, int & octave, double & ema);
     void createFrequencyData(int fftChannel, double & peakFrequency, double & peakDB, Array<float> & upperHarmonics, Array<float> & lowerHarmonics, int & keynote, int & octave, double & ema);
@@ -501,49 +508,44 @@ public:
     //=====================================================================================
 
     int refreshRate = 33;
-    int visualiserBufferSize = 44100 + 1;
-    int visualiserBufferCounter = 0;
+    std::atomic<int> visualiserBufferSize { 44100 / 33 + 1 };   // samples per oscilloscope window
 
-    // Per-channel oscilloscope buffers (4 input channels)
+    // Output channels 1-4, captured block by block from the audio thread and read back as
+    // trigger-locked windows by the visualisers. Sized for one window at 192kHz and 20fps,
+    // plus the trigger search span and the largest audio block.
     static constexpr int numOscilloscopeChannels = 4;
-    std::array<AudioBuffer<float>, numOscilloscopeChannels> oscilloscopeBuffers;
+    static constexpr int oscilloscopeCaptureSize = 1 << 15;
+    RingBuffer<float> oscilloscopeCapture { numOscilloscopeChannels, oscilloscopeCaptureSize };
 
     void setOscilloscopeRefreshRate(int newRate)
     {
         refreshRate = newRate;
 
         visualiserBufferSize = (int)(sample_rate / refreshRate) + 1;
-
-        visualiserRingBuffer.clear();
-        visualiserRingBuffer.setSize(2, visualiserBufferSize);
-
-        // Initialize per-channel oscilloscope buffers
-        for (int i = 0; i < numOscilloscopeChannels; ++i)
-        {
-            oscilloscopeBuffers[i].clear();
-            oscilloscopeBuffers[i].setSize(2, visualiserBufferSize);
-        }
-
-        visualiserBufferCounter = 0;
     }
 
-    AudioBuffer<float> visualiserRingBuffer;
+    // a window plus its trigger search span has to fit in the capture ring
+    int getOscilloscopeWindowSize() const { return jmin (visualiserBufferSize.load(), oscilloscopeCaptureSize / 3); }
+    
+    //=====================================================================================
+    // Callback profiler
+    //=====================================================================================
+    
+    // stage timings of getNextAudioBlock, deadline misses go to the log directory
+    CallbackProfiler callbackProfiler;
 
-    AudioBuffer<float> getOscillscopeBuffer()
+    // Fills destination (2 channels x getOscilloscopeWindowSize()) with the latest window of
+    // output channelIndex (0-based) in both channels, or of outputs 1 and 2 for channels past
+    // the captured ones. Message thread; keep passing the same buffer so nothing is allocated.
+    bool readOscilloscopeWindow(int channelIndex, AudioBuffer<float>& destination,
+                                RingBuffer<float>::TriggerMode trigger = RingBuffer<float>::TriggerMode::risingEdge)
     {
-        return AudioBuffer<float>(visualiserRingBuffer);
-    }
+        const bool isCaptured = channelIndex >= 0 && channelIndex < numOscilloscopeChannels;
 
-    // Get oscilloscope buffer for a specific channel (0-based index)
-    // channelIndex 0 = Input 1, 1 = Input 2, etc.
-    AudioBuffer<float> getOscilloscopeBufferForChannel(int channelIndex)
-    {
-        if (channelIndex >= 0 && channelIndex < numOscilloscopeChannels)
-        {
-            return AudioBuffer<float>(oscilloscopeBuffers[channelIndex]);
-        }
-        // Fallback to default buffer
-        return AudioBuffer<float>(visualiserRingBuffer);
+        const int sourceChannels[2] = { isCaptured ? channelIndex : 0, isCaptured ? channelIndex : 1 };
+
+        return oscilloscopeCapture.readTriggeredSamples(destination, sourceChannels, 2, sourceChannels[0],
+                                                        getOscilloscopeWindowSize(), trigger);
     }
     
     
@@ -555,16 +557,9 @@ public:
     
     #pragma mark Record Functions
 
-    bool shouldRecord = false;
     File temporaryRecordingFile;                                    // delete and recreate it.. keep it in hidden temp dir
-    TimeSliceThread backgroundThread; // the thread that will write our audio data to disk
-    std::unique_ptr<AudioFormatWriter::ThreadedWriter> threadedWriter; // the FIFO used to buffer the incoming data
-    int64 nextSampleNum;
-    uint64 recordCounterInSamples;
+    RecordingManager recorder;      // the RECORD_CHANNELS of the device, into one file or a file per channel
     uint64 recordCounterInMilliseconds;
-    
-    CriticalSection writerLock;
-    AudioFormatWriter::ThreadedWriter* volatile activeWriter;
 
     uint64 getRecordCounterInMilliseconds();
 
@@ -585,21 +580,54 @@ public:
     //==============================================================================
     // Log File Writer
     //==============================================================================
-    class LogFileWriter
+    class LogFileWriter : private Thread
     {
     public:
         
         AUDIO_MODE logAudioMode;
         
+        // One sequencer entry, captured by value on the thread that triggered the notes
+        // and formatted / written to disk later by the writer thread.
+        struct SequencerEvent
+        {
+            enum Type { CHORD_PLAYER = 0, CHORD_SCANNER, FREQUENCY_PLAYER, FREQUENCY_SCANNER };
+            
+            static constexpr int maxNotes = 16;
+            
+            Type    type        = CHORD_PLAYER;
+            int64   timeMillis  = 0;
+            int     shortcutRef = 0;
+            bool    isAllChords = false;
+            int     keynote     = 0;
+            int     chordType   = 0;
+            int     octave      = 0;
+            float   frequency   = 0.f;
+            int     numNotes    = 0;
+            int     notes[maxNotes];        // midi notes (chord player) or keynotes (chord scanner)
+            int     noteOctaves[maxNotes];
+            float   noteFreqs[maxNotes];
+        };
+        
         LogFileWriter(ProjectManager * pm)
+            : Thread("Log File Writer"),
+              audioThreadEvents(eventQueueSize),
+              messageThreadEvents(eventQueueSize)
         {
             projectManager      = pm;
             logFileDirectory    = &projectManager->logFileDirectory;
             frequencyManager    = projectManager->frequencyManager.get();
             logAudioMode        = AUDIO_MODE::MODE_CHORD_PLAYER;
+            
+            startThread(Thread::Priority::background);
         }
 
-        ~LogFileWriter() { }
+        ~LogFileWriter()
+        {
+            stopThread(2000);
+            
+            // anything posted after the last pass still makes it to disk
+            flushPendingEvents();
+        }
         
         void createNewFileForRealtimeAnalysisLogging();
 
@@ -615,10 +643,11 @@ public:
         void initNewLogFileForAudioMode(AUDIO_MODE newMode);
 
         void processLog_ChordPlayer_Parameters();
-        void processLog_ChordPlayer_Sequencer(int shortcutRef, const Array<String>& noteStrings, const Array<float>& noteFreqs);
+        // chord events come with their notes already filled in; the rest is set here
+        void processLog_ChordPlayer_Sequencer(int shortcutRef, SequencerEvent& event);
 
         void processLog_ChordScanner_Parameters();
-        void processLog_ChordScanner_Sequencer(bool isAllChords, Array<int> notes, Array<float> noteFreqs);
+        void processLog_ChordScanner_Sequencer(bool isAllChords, SequencerEvent& event);
         
         void processLog_FrequencyPlayer_Parameters();
         void processLog_FrequencyPlayer_Sequencer(int shortcutRef, float freq);
@@ -637,11 +666,44 @@ public:
         
         void checkForOldLoggingFile();
         
-        String getDateAndTimeString();
+        String getDateAndTimeString(Time time = Time::getCurrentTime());
         String getScaleString(int scaleRef);
         
+        // Offline renders post sequencer events much faster than real time; calling this
+        // between blocks lets the writer thread keep up instead of dropping entries
+        void waitUntilEventsWritten()
+        {
+            while (!audioThreadEvents.empty() && isThreadRunning())
+            {
+                notify();
+                eventsWritten.wait(flushIntervalMs);
+            }
+        }
+        
     private:
         
+        // the sequencer logs are called from the audio thread, so they only post an event;
+        // formatting and file writes happen here, batched once per flush interval
+        void run() override;
+        
+        void postSequencerEvent(SequencerEvent& event);
+        void flushPendingEvents();
+        String formatSequencerEvent(const SequencerEvent& event);
+        String formatEmptyHarmonicsAndIntervals();
+        
+        void appendToLogFile(int audioMode, const String& text);
+        
+        static constexpr int eventQueueSize     = 1024;
+        static constexpr int flushIntervalMs    = 100;
+        
+        // one queue per producer: the audio thread (repeaters) and the message thread (keyboard triggers)
+        audio_devs::spsc_queue<SequencerEvent> audioThreadEvents;
+        audio_devs::spsc_queue<SequencerEvent> messageThreadEvents;
+        std::atomic<int> numDroppedEvents { 0 };
+        WaitableEvent eventsWritten;    // signalled after every pass of the writer thread
+        
+        CriticalSection fileLock;       // guards logFile[] between the writer and message threads
+        
         bool shouldRecordLog = false;
         
         String logString;               // String where logs are set, to be written to file later
@@ -694,6 +756,10 @@ public:
         outputMenu.addItem(AUDIO_OUTPUTS::STEREO_7_8, "STEREO 7 & 8");
     }
     
+    // applies queued parameter changes on the calling thread, for driving the processors
+    // without an audio device (offline rendering) before the first block
+    void applyPendingParameterChanges();
+    
 private:
     // FIXED: Exception-safe helper methods
     void cleanup() noexcept;
@@ -709,6 +775,27 @@ private:
     void saveSettingsFile();
     void loadSettingsFile();
     
+    //===============================================================================
+    #pragma mark Processor parameter changes
+    //===============================================================================
+    
+    // every processor setParameter goes through here, see ParameterChangeQueue
+    void postParameterChange(ParameterChangeQueue::Target target, int shortcut, int index, const var& value);
+    void applyParameterChange(const ParameterChangeQueue::Change& change);
+    
+    ParameterChangeQueue parameterChanges;
+    
+    // the getIdentifierFor...ParameterIndex names, resolved once for the set / get calls
+    // the UI makes; null for indices without a name
+    void initParameterIdentifiers();
+    static const Identifier& getParameterIdentifier(const Array<Identifier>& identifiers, int index);
+    
+    Array<Identifier> chordPlayerIdentifiers;
+    Array<Identifier> chordScannerIdentifiers;
+    Array<Identifier> frequencyPlayerIdentifiers;
+    Array<Identifier> frequencyScannerIdentifiers;
+    Array<Identifier> lissajousIdentifiers;
+    
     //===============================================================================
     #pragma mark Multichannel audio
     //===============================================================================
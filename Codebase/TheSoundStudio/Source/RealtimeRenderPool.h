@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    RealtimeRenderPool.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+// Spreads independent render jobs (one per shortcut synth, or per plugin slot branch)
+// over a few worker threads from inside the audio callback. The audio thread publishes
+// a batch and then takes jobs itself alongside the workers, so a batch never waits on a
+// worker that has not woken up yet: the worst case is the audio thread rendering
+// everything, as before.
+//
+// Nothing here allocates or takes a lock on the audio thread. Jobs are claimed with a
+// CAS on a packed (generation | numJobs | nextJob) word, so a worker that is late from
+// one batch can never claim an index of the next. Workers spin for a few milliseconds
+// after their last job so back-to-back callbacks find them awake, then go to sleep.
+class RealtimeRenderPool
+{
+public:
+    using JobFunction = void (*) (void* context, int jobIndex);
+
+    static constexpr int maxJobs = 0xffff;
+
+    explicit RealtimeRenderPool (const String& workerName = "Shortcut Render Worker")
+        : workerThreadName (workerName)
+    {
+    }
+
+    ~RealtimeRenderPool()
+    {
+        stop (1000);
+    }
+
+    // Message thread
+    void start()
+    {
+        if (! workers.isEmpty())
+            return;
+
+        const int numWorkers = jlimit (0, maxWorkers, SystemStats::getNumCpus() - 2);
+
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add (new Worker (*this, i))->startThread (Thread::Priority::highest);
+    }
+
+    void stop (int timeoutMs)
+    {
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto* worker : workers)
+        {
+            worker->wakeUp.signal();
+            worker->stopThread (timeoutMs);
+        }
+
+        workers.clear();
+    }
+
+    int getNumWorkers() const { return workers.size(); }
+
+    // Audio thread only: runs job (context, i) for every i in [0, numJobs) and returns
+    // once all of them have finished. Jobs may run in any order on any thread.
+    void parallelFor (int numJobs, JobFunction job, void* context)
+    {
+        jassert (numJobs <= maxJobs);
+
+        if (numJobs <= 0)
+            return;
+
+        if (numJobs == 1 || workers.isEmpty())
+        {
+            for (int i = 0; i < numJobs; ++i)
+                job (context, i);
+
+            return;
+        }
+
+        jobFunction = job;
+        jobContext  = context;
+        jobsCompleted.store (0, std::memory_order_relaxed);
+
+        ++generation;
+        batchState.store (((uint64) generation << 32) | ((uint64) numJobs << 16), std::memory_order_release);
+
+        for (auto* worker : workers)
+            if (worker->isSleeping.load (std::memory_order_acquire))
+                worker->wakeUp.signal();
+
+        runAvailableJobs();
+
+        // only jobs already claimed by a running worker are left
+        while (jobsCompleted.load (std::memory_order_acquire) < numJobs)
+            Thread::yield();
+    }
+
+    template <typename Function>
+    void parallelFor (int numJobs, Function& function)
+    {
+        parallelFor (numJobs,
+                     [] (void* context, int jobIndex) { (*static_cast<Function*> (context)) (jobIndex); },
+                     &function);
+    }
+
+private:
+    static constexpr int maxWorkers         = 3;
+    static constexpr double spinTimeMs      = 5.0;
+    static constexpr int sleepTimeoutMs     = 50;
+
+    class Worker : public Thread
+    {
+    public:
+        Worker (RealtimeRenderPool& p, int index)
+            : Thread (p.workerThreadName + String (index)), pool (p)
+        {
+        }
+
+        void run() override
+        {
+            double lastJobTime = Time::getMillisecondCounterHiRes();
+
+            while (! threadShouldExit())
+            {
+                if (pool.runAvailableJobs())
+                {
+                    lastJobTime = Time::getMillisecondCounterHiRes();
+                }
+                else if (Time::getMillisecondCounterHiRes() - lastJobTime < spinTimeMs)
+                {
+                    Thread::yield();
+                }
+                else
+                {
+                    isSleeping.store (true, std::memory_order_release);
+
+                    // a batch published between the last check and the flag above is not missed
+                    if (! pool.runAvailableJobs())
+                        wakeUp.wait (sleepTimeoutMs);
+
+                    isSleeping.store (false, std::memory_order_release);
+
+                    lastJobTime = Time::getMillisecondCounterHiRes();
+                }
+            }
+        }
+
+        WaitableEvent wakeUp;
+        std::atomic<bool> isSleeping { false };
+
+    private:
+        RealtimeRenderPool& pool;
+    };
+
+    // Claims and runs jobs of the current batch until none are left, from any thread
+    bool runAvailableJobs()
+    {
+        bool didWork = false;
+
+        auto state = batchState.load (std::memory_order_acquire);
+
+        for (;;)
+        {
+            const int nextJob = (int) (state & 0xffff);
+            const int numJobs = (int) ((state >> 16) & 0xffff);
+
+            if (nextJob >= numJobs)
+                return didWork;
+
+            if (batchState.compare_exchange_weak (state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                const ScopedNoDenormals noDenormals;
+
+                jobFunction (jobContext, nextJob);
+
+                jobsCompleted.fetch_add (1, std::memory_order_release);
+
+                didWork = true;
+                state   = batchState.load (std::memory_order_acquire);
+            }
+        }
+    }
+
+    std::atomic<uint64> batchState { 0 };
+    std::atomic<int> jobsCompleted { 0 };
+    uint32 generation = 0;
+
+    // written by the audio thread before batchState is published, read after a claim
+    JobFunction jobFunction = nullptr;
+    void* jobContext        = nullptr;
+
+    const String workerThreadName;
+    OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeRenderPool)
+};
@@ -0,0 +1,498 @@
+/*
+  ==============================================================================
+
+    RecordingManager.cpp
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#include "RecordingManager.h"
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <fcntl.h>
+ #include <unistd.h>
+#endif
+
+//=============================================================
+// Preallocated File Stream
+//=============================================================
+// A file stream that keeps its file allocated some way ahead of the writer, and cuts off
+// whatever the recording didn't use when it is deleted. The file grows a slice at a time,
+// so no single step holds the recorder thread up for long.
+//
+// The space is reserved with fallocate on Linux and F_PREALLOCATE on macOS, which write
+// nothing. Elsewhere, or on a file system that won't reserve, the slice is written with
+// zeros in blocks.
+class RecordingManager::PreallocatedFileStream : public OutputStream
+{
+public:
+    PreallocatedFileStream (const File& file, int64 bytesPerSlice, int64 bytesToKeepAhead)
+        : stream (file, 65536),
+          sliceSize (jmax ((int64) zeroBlockSize, bytesPerSlice)),
+          keepAhead (jmax (sliceSize, bytesToKeepAhead))
+    {
+       #if JUCE_LINUX || JUCE_MAC
+        if (stream.openedOk())
+            fileDescriptor = ::open (file.getFullPathName().toRawUTF8(), O_WRONLY);
+       #endif
+    }
+
+    ~PreallocatedFileStream() override
+    {
+        if (stream.openedOk() && allocatedEnd > writtenEnd && stream.setPosition (writtenEnd))
+            stream.truncate();
+
+       #if JUCE_LINUX || JUCE_MAC
+        if (fileDescriptor >= 0)
+            ::close (fileDescriptor);
+       #endif
+    }
+
+    bool openedOk() const noexcept                  { return stream.openedOk(); }
+
+    void flush() override                           { stream.flush(); }
+    int64 getPosition() override                    { return stream.getPosition(); }
+    bool setPosition (int64 position) override      { return stream.setPosition (position); }
+
+    bool write (const void* data, size_t numBytes) override
+    {
+        const int64 end = stream.getPosition() + (int64) numBytes;
+
+        // only when the writer has caught up with the file, growAhead normally stays in front
+        if (end > allocatedEnd)
+            allocate (end + sliceSize);
+
+        if (! stream.write (data, numBytes))
+            return false;
+
+        writtenEnd = jmax (writtenEnd, end);
+        return true;
+    }
+
+    // Grows the file by one slice if it isn't far enough ahead of the writer yet.
+    // False once it is, or if the disk won't take any more
+    bool growAhead()
+    {
+        if (! stream.openedOk() || allocatedEnd - writtenEnd >= keepAhead)
+            return false;
+
+        return allocate (allocatedEnd + sliceSize);
+    }
+
+private:
+    bool allocate (int64 newEnd)
+    {
+        if (! reserve (newEnd) && ! fillWithZeros (newEnd))
+            return false;
+
+        allocatedEnd = newEnd;
+        return true;
+    }
+
+    // Extends the file to newEnd without writing to it. False where the platform or the
+    // file system can't
+    bool reserve (int64 newEnd)
+    {
+       #if JUCE_LINUX
+        return fileDescriptor >= 0
+            && fallocate (fileDescriptor, 0, (off_t) allocatedEnd, (off_t) (newEnd - allocatedEnd)) == 0;
+       #elif JUCE_MAC
+        if (fileDescriptor < 0)
+            return false;
+
+        // contiguous if possible, F_PREALLOCATE only reserves, ftruncate makes it the file's
+        fstore_t store { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, (off_t) (newEnd - allocatedEnd), 0 };
+
+        if (fcntl (fileDescriptor, F_PREALLOCATE, &store) == -1)
+        {
+            store.fst_flags = F_ALLOCATEALL;
+
+            if (fcntl (fileDescriptor, F_PREALLOCATE, &store) == -1)
+                return false;
+        }
+
+        return ftruncate (fileDescriptor, (off_t) newEnd) == 0;
+       #else
+        ignoreUnused (newEnd);
+        return false;
+       #endif
+    }
+
+    bool fillWithZeros (int64 newEnd)
+    {
+        static const char zeros[zeroBlockSize] {};
+
+        const int64 position = stream.getPosition();
+        bool filled = stream.setPosition (allocatedEnd);
+
+        for (int64 end = allocatedEnd; filled && end < newEnd; end += zeroBlockSize)
+            filled = stream.write (zeros, (size_t) jmin ((int64) zeroBlockSize, newEnd - end));
+
+        stream.setPosition (position);
+        return filled;
+    }
+
+    static constexpr int zeroBlockSize = 65536;
+
+    FileOutputStream stream;
+    const int64 sliceSize, keepAhead;
+
+    int64 allocatedEnd  = 0;
+    int64 writtenEnd    = 0;
+
+    int fileDescriptor  = -1;   // a second handle on the file, to reserve space through
+};
+
+//=============================================================
+// Session
+//=============================================================
+// One recording: its files and the ring between the audio thread and the recorder thread.
+struct RecordingManager::Session
+{
+    Session (int numChannelsToRecord, int ringSize)
+        : numChannels (numChannelsToRecord),
+          fifo (ringSize),
+          ring (numChannelsToRecord, ringSize),
+          ringData (ring.getArrayOfWritePointers())
+    {
+    }
+
+    // Audio thread. False if the ring has no room for the block
+    bool reserve (int numSamples) noexcept
+    {
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        blockReserved = size1 + size2 == numSamples;
+        return blockReserved;
+    }
+
+    void copy (int index, const AudioBuffer<float>& buffer, int sourceChannel, int startSample) noexcept
+    {
+        if (sourceChannel >= buffer.getNumChannels())
+        {
+            clear (index);
+            return;
+        }
+
+        const float* source = buffer.getReadPointer (sourceChannel, startSample);
+
+        FloatVectorOperations::copy (ringData[index] + start1, source, size1);
+
+        if (size2 > 0)
+            FloatVectorOperations::copy (ringData[index] + start2, source + size1, size2);
+    }
+
+    void clear (int index) noexcept
+    {
+        FloatVectorOperations::clear (ringData[index] + start1, size1);
+
+        if (size2 > 0)
+            FloatVectorOperations::clear (ringData[index] + start2, size2);
+    }
+
+    // Recorder thread, or the message thread once the audio thread has let go.
+    // False if there was nothing to write
+    bool writePending()
+    {
+        int readStart1, readSize1, readStart2, readSize2;
+        fifo.prepareToRead (fifo.getNumReady(), readStart1, readSize1, readStart2, readSize2);
+
+        if (readSize1 + readSize2 == 0)
+            return false;
+
+        write (readStart1, readSize1);
+        write (readStart2, readSize2);
+
+        fifo.finishedRead (readSize1 + readSize2);
+        return true;
+    }
+
+    void write (int startSample, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        const float* data[NUM_CHANNELS];
+
+        for (int index = 0; index < numChannels; ++index)
+            data[index] = ringData[index] + startSample;
+
+        if (filePerChannel)
+        {
+            for (int index = 0; index < numChannels; ++index)
+                writers[index]->writeFromFloatArrays (data + index, 1, numSamples);
+        }
+        else
+        {
+            writers[0]->writeFromFloatArrays (data, numChannels, numSamples);
+        }
+    }
+
+    // Recorder thread, between ring drains. False once no file needs to grow
+    bool growFiles()
+    {
+        bool grew = false;
+
+        for (auto* stream : streams)
+            grew = stream->growAhead() || grew;
+
+        return grew;
+    }
+
+    const int   numChannels;
+    int         channels[NUM_CHANNELS] {};      // the Channel each ring channel records
+    bool        filePerChannel = false;
+
+    OwnedArray<AudioFormatWriter>       writers;
+    Array<PreallocatedFileStream*>      streams;        // owned by the writers
+    Array<File>                         files;
+
+    AbstractFifo        fifo;
+    AudioBuffer<float>  ring;
+    float* const*       ringData;
+
+    // audio thread, the ring space of the block being captured
+    int     start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+    bool    blockReserved   = false;
+    bool    blockDropped    = false;
+    bool    blockHasInputs  = false;
+};
+
+//=============================================================
+// Recording Manager
+//=============================================================
+String RecordingManager::getChannelName (int channel)
+{
+    if (channel < INPUT_1)
+        return "Output " + String (channel - OUTPUT_1 + 1);
+
+    return "Input " + String (channel - INPUT_1 + 1);
+}
+
+RecordingManager::RecordingManager()
+{
+    recorderThread.addTimeSliceClient (this);
+    recorderThread.startThread();
+}
+
+RecordingManager::~RecordingManager()
+{
+    stop();
+
+    recorderThread.removeTimeSliceClient (this);
+    recorderThread.stopThread (1000);
+}
+
+bool RecordingManager::open (const File& file, AudioFormat& format, uint32 channelMask,
+                             bool filePerChannel, double sampleRate, int bitsPerSample)
+{
+    stop();
+
+    int numChannels = 0;
+
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+        if ((channelMask & (1u << channel)) != 0)
+            ++numChannels;
+
+    if (numChannels == 0 || sampleRate <= 0.0)
+        return false;
+
+    auto newSession = std::make_unique<Session> (numChannels, roundToInt (sampleRate * ringSeconds));
+    newSession->filePerChannel = filePerChannel;
+
+    for (int channel = 0, index = 0; channel < NUM_CHANNELS; ++channel)
+        if ((channelMask & (1u << channel)) != 0)
+            newSession->channels[index++] = channel;
+
+    const int numFiles          = filePerChannel ? numChannels : 1;
+    const int channelsPerFile   = filePerChannel ? 1 : numChannels;
+    const int64 bytesPerSecond  = (int64) sampleRate * channelsPerFile * (bitsPerSample / 8);
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        const File fileToWrite = filePerChannel
+            ? file.getSiblingFile (file.getFileNameWithoutExtension() + " - " + getChannelName (newSession->channels[i]) + file.getFileExtension())
+            : file;
+
+        fileToWrite.deleteFile();
+        newSession->files.add (fileToWrite);
+
+        auto stream = std::make_unique<PreallocatedFileStream> (fileToWrite,
+                                                                (int64) (bytesPerSecond * preallocateSliceSeconds),
+                                                                (int64) (bytesPerSecond * preallocateSeconds));
+
+        std::unique_ptr<AudioFormatWriter> writer;
+
+        if (stream->openedOk())
+            writer.reset (format.createWriterFor (stream.get(), sampleRate, (unsigned int) channelsPerFile, bitsPerSample, {}, 0));
+
+        if (writer == nullptr)
+        {
+            // the format may not take this many channels; leave nothing half made behind
+            const auto filesToDelete = newSession->files;
+
+            stream.reset();
+            newSession.reset();
+
+            for (auto& f : filesToDelete)
+                f.deleteFile();
+
+            return false;
+        }
+
+        newSession->streams.add (stream.release());
+        newSession->writers.add (writer.release());
+    }
+
+    numRecordedSamples.store (0);
+    numDroppedSamples.store (0);
+    numOverruns.store (0);
+
+    const ScopedLock sl (sessionLock);
+
+    session = std::move (newSession);
+    activeSession.store (session.get());
+
+    return true;
+}
+
+void RecordingManager::start()
+{
+    shouldRecord.store (true);
+}
+
+void RecordingManager::stop()
+{
+    shouldRecord.store (false);
+
+    std::unique_ptr<Session> finished;
+
+    {
+        const ScopedLock sl (sessionLock);
+
+        activeSession.store (nullptr);
+
+        // a block that picked the session up before it was withdrawn is one copy from done
+        while (audioThreadCapturing.load())
+            Thread::yield();
+
+        finished = std::move (session);
+    }
+
+    if (finished != nullptr)
+    {
+        while (finished->writePending())
+        {
+        }
+    }
+
+    // deleting the session's writers finishes the files
+}
+
+bool RecordingManager::isOpen() const
+{
+    return activeSession.load() != nullptr;
+}
+
+bool RecordingManager::isRecording() const
+{
+    return isOpen() && shouldRecord.load();
+}
+
+Array<File> RecordingManager::getFiles() const
+{
+    const ScopedLock sl (sessionLock);
+
+    return session != nullptr ? session->files : Array<File>();
+}
+
+int RecordingManager::useTimeSlice()
+{
+    const ScopedLock sl (sessionLock);
+
+    if (session == nullptr)
+        return 100;
+
+    // straight back for more while the audio thread is filling the ring, and grow the
+    // files a slice at a time while it isn't, so the ring never waits on a long grow
+    if (session->writePending() || session->growFiles())
+        return 0;
+
+    return 10;
+}
+
+//=============================================================
+// Audio thread
+//=============================================================
+void RecordingManager::captureInputs (const AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    capture (buffer, startSample, numSamples, false);
+}
+
+void RecordingManager::captureOutputs (const AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    capture (buffer, startSample, numSamples, true);
+}
+
+void RecordingManager::capture (const AudioBuffer<float>& buffer, int startSample, int numSamples, bool outputs) noexcept
+{
+    // stop() waits for this to clear before it lets go of the session; both sides use
+    // sequentially consistent operations, so at least one of them sees the other
+    audioThreadCapturing.store (true);
+
+    auto* s = activeSession.load();
+
+    if (s == nullptr || ! shouldRecord.load (std::memory_order_relaxed) || numSamples <= 0)
+    {
+        audioThreadCapturing.store (false);
+        return;
+    }
+
+    if (! s->blockReserved && ! s->blockDropped && ! s->reserve (numSamples))
+        s->blockDropped = true;
+
+    if (! s->blockDropped)
+    {
+        for (int index = 0; index < s->numChannels; ++index)
+        {
+            const int channel = s->channels[index];
+
+            if (outputs && channel < INPUT_1)
+                s->copy (index, buffer, channel - OUTPUT_1, startSample);
+            else if (! outputs && channel >= INPUT_1)
+                s->copy (index, buffer, channel - INPUT_1, startSample);
+        }
+
+        s->blockHasInputs = s->blockHasInputs || ! outputs;
+    }
+
+    if (outputs)
+    {
+        if (s->blockDropped)
+        {
+            numOverruns.fetch_add (1, std::memory_order_relaxed);
+            numDroppedSamples.fetch_add ((uint64) numSamples, std::memory_order_relaxed);
+        }
+        else
+        {
+            if (! s->blockHasInputs)
+                for (int index = 0; index < s->numChannels; ++index)
+                    if (s->channels[index] >= INPUT_1)
+                        s->clear (index);
+
+            s->fifo.finishedWrite (numSamples);
+            numRecordedSamples.fetch_add ((uint64) numSamples, std::memory_order_relaxed);
+        }
+
+        s->blockReserved    = false;
+        s->blockDropped     = false;
+        s->blockHasInputs   = false;
+    }
+
+    audioThreadCapturing.store (false);
+}
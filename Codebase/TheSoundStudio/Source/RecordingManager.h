@@ -14,122 +14,99 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
-#include "TSSPaths.h"
-#include "TSSConstants.h"
+#include <atomic>
 #include <memory>
 
-class RecordingManager
+//=============================================================
+// Recording Manager
+//=============================================================
+// Records any of the device's eight outputs and four inputs, either into one file holding
+// all of them or into a file per channel.
+//
+// The audio thread copies each block into a ring and never waits on anything. If the disk
+// falls so far behind that the ring is full, the block is dropped and counted as an overrun
+// instead. The recorder thread empties the ring into the files, and in between grows each
+// file ahead of its writer a second at a time rather than on every write.
+class RecordingManager : private juce::TimeSliceClient
 {
 public:
-    RecordingManager()
-        : backgroundThread("Audio Recorder Thread")
+    // bits of a channel mask, outputs first
+    enum Channel
     {
-        backgroundThread.startThread();
-    }
+        OUTPUT_1        = 0,
+        INPUT_1         = 8,
+        NUM_CHANNELS    = 12
+    };
+
+    static constexpr int numOutputs = INPUT_1 - OUTPUT_1;
+    static constexpr int numInputs  = NUM_CHANNELS - INPUT_1;
+
+    static juce::uint32 getOutputBit (int output) noexcept  { return 1u << (OUTPUT_1 + output); }
+    static juce::uint32 getInputBit (int input) noexcept    { return 1u << (INPUT_1 + input); }
+
+    static juce::String getChannelName (int channel);
+
+    RecordingManager();
+    ~RecordingManager() override;
+
+    //=============================================================
+    // Message thread
+    //=============================================================
+    // Creates the files, replacing any recording still open. With filePerChannel each
+    // channel gets a file named after this one, e.g. "Take - Output 1.wav".
+    // False if a file couldn't be created or the format can't take the channels.
+    bool open (const juce::File& file, juce::AudioFormat& format, juce::uint32 channelMask,
+               bool filePerChannel, double sampleRate, int bitsPerSample);
+
+    void start();       // records from the next block on
+    void stop();        // writes what is left and closes the files
+
+    bool isOpen() const;
+    bool isRecording() const;
+
+    juce::Array<juce::File> getFiles() const;
+
+    // since the recording was opened
+    juce::uint64 getNumRecordedSamples() const noexcept     { return numRecordedSamples.load(); }
+    int getNumOverruns() const noexcept                     { return numOverruns.load(); }
+    juce::uint64 getNumDroppedSamples() const noexcept      { return numDroppedSamples.load(); }
+
+    //=============================================================
+    // Audio thread
+    //=============================================================
+    // captureInputs before anything has processed the block, captureOutputs once the block
+    // is final. captureOutputs ends the block and has to be called for every block; without
+    // captureInputs the inputs are recorded as silence. Channels the device doesn't have
+    // are recorded as silence too.
+    void captureInputs (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+    void captureOutputs (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
 
-    ~RecordingManager()
-    {
-        stopRecording();
-        if (backgroundThread.isThreadRunning())
-            backgroundThread.stopThread(1000);
-    }
-
-    void setupRecording(const juce::File& file,
-                        juce::AudioFormatManager& formatManager,
-                        int formatIndex,
-                        double sampleRate)
-    {
-        stopRecording();
-
-        file.deleteFile();
-
-        auto fileStream = std::make_unique<juce::FileOutputStream>(file);
-
-        if (fileStream != nullptr && fileStream->openedOk())
-        {
-            auto* format = formatManager.getKnownFormat(formatIndex);
-            if (format != nullptr)
-            {
-                auto* writer = format->createWriterFor(
-                    fileStream.get(), sampleRate, 2, 24, {}, 0);
-
-                if (writer != nullptr)
-                {
-                    fileStream.release();
-
-                    threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
-                        writer, backgroundThread, TSS::Audio::kRecordingBufferSize);
-
-                    const juce::ScopedLock sl(writerLock);
-                    activeWriter = threadedWriter.get();
-                    recordCounterInSamples = 0;
-                }
-            }
-        }
-    }
-
-    void createAndStartRecording(const juce::String& prefix,
-                                  const juce::File& recordDirectory,
-                                  juce::AudioFormatManager& formatManager,
-                                  int formatIndex,
-                                  double sampleRate)
-    {
-        auto filename = TSS::TSSPaths::buildTimestampedFilename(prefix, ".wav");
-        juce::File newFile(recordDirectory.getChildFile(filename));
-        newFile.create();
-        setupRecording(newFile, formatManager, formatIndex, sampleRate);
-    }
-
-    void startRecording()
-    {
-        shouldRecord = true;
-    }
-
-    void stopRecording()
-    {
-        {
-            const juce::ScopedLock sl(writerLock);
-            activeWriter = nullptr;
-        }
-
-        threadedWriter.reset();
-        shouldRecord = false;
-    }
+private:
+    struct Session;
+    class PreallocatedFileStream;
 
-    bool isRecording() const
-    {
-        return activeWriter != nullptr;
-    }
+    void capture (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples, bool outputs) noexcept;
 
-    bool getShouldRecord() const { return shouldRecord; }
+    int useTimeSlice() override;
 
-    void writeBlock(const float* const* data, int numSamples)
-    {
-        const juce::ScopedLock sl(writerLock);
-        if (activeWriter != nullptr)
-        {
-            activeWriter->write(data, numSamples);
-            recordCounterInSamples += static_cast<uint64>(numSamples);
-        }
-    }
+    // seconds of audio the ring holds, how far ahead of the writer each file is grown, and
+    // how much it grows in one step; a step has to stay well inside the ring
+    static constexpr double ringSeconds             = 5.0;
+    static constexpr double preallocateSeconds      = 10.0;
+    static constexpr double preallocateSliceSeconds = 1.0;
 
-    uint64 getRecordCounterInSamples() const { return recordCounterInSamples; }
+    juce::TimeSliceThread recorderThread { "Audio Recorder Thread" };
 
-    uint64 getRecordCounterInMilliseconds(double sampleRate) const
-    {
-        if (sampleRate <= 0.0) return 0;
-        return static_cast<uint64>((recordCounterInSamples / sampleRate) * 1000.0);
-    }
-
-private:
-    juce::TimeSliceThread backgroundThread;
-    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+    juce::CriticalSection sessionLock;          // message and recorder threads
+    std::unique_ptr<Session> session;
 
-    juce::CriticalSection writerLock;
-    juce::AudioFormatWriter::ThreadedWriter* activeWriter = nullptr;
+    std::atomic<Session*>   activeSession       { nullptr };
+    std::atomic<bool>       audioThreadCapturing { false };
+    std::atomic<bool>       shouldRecord        { false };
 
-    bool shouldRecord = false;
-    uint64 recordCounterInSamples = 0;
+    std::atomic<juce::uint64>   numRecordedSamples  { 0 };
+    std::atomic<juce::uint64>   numDroppedSamples   { 0 };
+    std::atomic<int>            numOverruns         { 0 };
 
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RecordingManager)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RecordingManager)
 };
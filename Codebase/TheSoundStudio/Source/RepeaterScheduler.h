@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    RepeaterScheduler.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "../JuceLibraryCode/JuceHeader.h"
+#include <limits>
+
+//=============================================================
+// Repeater Scheduler
+//=============================================================
+// Shared event stepping for the PlayRepeater classes. A repeater only changes state on
+// the samples where a note on / note off is due or the loop ends, so rather than ticking
+// every sample it fires the events due on its current sample and jumps straight to the
+// next one. The processor renders its synths in the segments between those jumps, which
+// puts every note on the exact sample it was scheduled for instead of the top of a block.
+namespace RepeaterScheduler
+{
+    static constexpr int noEvent = std::numeric_limits<int>::max();
+
+    // Keeps the earliest event that is still ahead of the current sample
+    inline void considerEvent (int& nextEvent, int currentSample, int eventSample) noexcept
+    {
+        if (eventSample > currentSample && eventSample < nextEvent)
+            nextEvent = eventSample;
+    }
+
+    // Samples from the current one up to the next event or the end of the loop, clamped
+    // to what is left of the block. Never less than 1, so the caller always moves on.
+    inline int samplesUntil (int currentSample, int nextEvent, uint64 loopEnd, int maxSamples) noexcept
+    {
+        const int64 target = jmin ((int64) nextEvent, (int64) loopEnd);
+
+        return (int) jlimit ((int64) 1, (int64) maxSamples, target - (int64) currentSample);
+    }
+
+    // Splits a block at the repeater's events. tick (maxSamples) fires whatever is due on
+    // the repeater's current sample and returns how far it is safe to render before the
+    // next event; render (startSample, numSamples) then renders that segment.
+    template <typename TickFunction, typename RenderFunction>
+    void processBlock (int numSamples, TickFunction&& tick, RenderFunction&& render)
+    {
+        for (int position = 0; position < numSamples;)
+        {
+            const int segment = jlimit (1, numSamples - position, tick (numSamples - position));
+
+            render (position, segment);
+
+            position += segment;
+        }
+    }
+}
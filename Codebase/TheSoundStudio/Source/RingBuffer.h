@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include <atomic>
 
 /** A circular, lock-free buffer for multiple channels of audio.
  
@@ -65,14 +66,27 @@ public:
         @param numSamples       the number of samples from newAudioData to write
                                 into the RingBuffer
      */
-    void writeSamples (AudioBuffer<Type> & newAudioData, int startSample, int numSamples)
+    void writeSamples (const AudioBuffer<Type> & newAudioData, int startSample, int numSamples)
     {
+        jassert (numSamples < bufferSize);
+        
+        // raised before any sample is overwritten, readers use it to tell how far this write reaches
+        if (numSamples > largestWrite.load (std::memory_order_relaxed))
+            largestWrite.store (numSamples, std::memory_order_seq_cst);
+        
         // C++17: Traditional for loop is appropriate here due to index usage
         for (int i = 0; i < numChannels; ++i)
         {
             // C++17: Use auto for type deduction
             const auto curWritePosition = writePosition.get();
             
+            // Channels the source does not have are recorded as silence
+            if (i >= newAudioData.getNumChannels())
+            {
+                clearRange (i, curWritePosition, numSamples);
+                continue;
+            }
+            
             // If we need to loop around the ring
             if (curWritePosition + numSamples > bufferSize - 1)
             {
@@ -99,6 +113,10 @@ public:
         const auto newWritePos = (writePosition.get() + numSamples) % bufferSize;
         writePosition.set(newWritePos);  // Atomic write ensures thread safety
         
+        // published last, so a reader that sees the new count also sees the samples
+        numSamplesWritten.store (numSamplesWritten.load (std::memory_order_relaxed) + numSamples,
+                                 std::memory_order_release);
+        
         /*
             Although it would seem that the above two lines could cause a
             problem for the consumer calling readsSamples() since it uses the
@@ -177,7 +195,128 @@ public:
         }
     }
     
+    //==============================================================================
+    /** How readTriggeredSamples() lines the window up with the signal. */
+    enum class TriggerMode
+    {
+        freeRunning = 0,    // the most recent samples, like readSamples()
+        risingEdge,         // window starts where the signal rises through the level
+        fallingEdge         // window starts where the signal falls through the level
+    };
+    
+    /** Reads a window of readSize samples that starts on the most recent trigger
+        point of triggerChannel, so a periodic signal stands still from one read to
+        the next. If no trigger point is found within one window length the read
+        falls back to the most recent samples, like a scope on auto trigger.
+     
+        Channel sourceChannels[i] of the RingBuffer is copied into channel i of
+        bufferToFill, all from the same positions. bufferToFill is resized to
+        numDestChannels x readSize if needed, so pass the same buffer every time to
+        avoid allocating.
+     
+        Safe to call from one reader thread while the writer keeps writing: the
+        read is done again if the writer may have overwritten the samples under it,
+        and false is returned if no consistent window could be read.
+     
+        @param readSize     must be less than a third of the RingBuffer's size, as
+                            a window plus the trigger search span plus the largest
+                            write must fit in the ring.
+    */
+    bool readTriggeredSamples (AudioBuffer<Type> & bufferToFill,
+                               const int* sourceChannels, int numDestChannels,
+                               int triggerChannel, int readSize,
+                               TriggerMode mode, Type triggerLevel = Type())
+    {
+        jassert (readSize > 0 && readSize * 3 <= bufferSize);
+        jassert (isPositiveAndBelow (triggerChannel, numChannels));
+        
+        bufferToFill.setSize (numDestChannels, readSize, false, false, true);
+        
+        for (int attempt = 0; attempt < maxReadAttempts; ++attempt)
+        {
+            const int64 end = numSamplesWritten.load (std::memory_order_acquire);
+            
+            if (end < (int64) readSize)
+                return false;
+            
+            // the window may start anywhere in [end - 2 * readSize, end - readSize]
+            const int64 searchStart = jmax ((int64) 1, end - 2 * (int64) readSize);
+            int64 windowStart = end - readSize;
+            
+            if (mode != TriggerMode::freeRunning)
+            {
+                const Type* data = audioBuffer->getReadPointer (triggerChannel);
+                
+                for (int64 t = end - readSize; t >= searchStart; --t)
+                {
+                    const Type previous = data[wrap (t - 1)];
+                    const Type current  = data[wrap (t)];
+                    
+                    const bool triggered = mode == TriggerMode::risingEdge
+                                         ? (previous < triggerLevel && current >= triggerLevel)
+                                         : (previous > triggerLevel && current <= triggerLevel);
+                    
+                    if (triggered)
+                    {
+                        windowStart = t;
+                        break;
+                    }
+                }
+            }
+            
+            for (int i = 0; i < numDestChannels; ++i)
+                copyOut (bufferToFill, i, sourceChannels[i], windowStart, readSize);
+            
+            // The writer may be part way through its next block, which reaches up to
+            // largestWrite samples past the count it last published. Everything read
+            // from searchStart onwards must still be out of its reach.
+            const int64 writerReach = numSamplesWritten.load (std::memory_order_seq_cst)
+                                    + largestWrite.load (std::memory_order_seq_cst);
+            
+            if (writerReach - (searchStart - 1) <= (int64) bufferSize)
+                return true;
+        }
+        
+        return false;
+    }
+    
+    /** Total number of samples written since construction. */
+    int64 getNumSamplesWritten() const noexcept   { return numSamplesWritten.load (std::memory_order_acquire); }
+    
+    int getBufferSize() const noexcept            { return bufferSize; }
+    int getNumChannels() const noexcept           { return numChannels; }
+    
 private:
+    static constexpr int maxReadAttempts = 3;
+    
+    int wrap (int64 samplePosition) const noexcept
+    {
+        return (int) (samplePosition % bufferSize);
+    }
+    
+    void clearRange (int channel, int startPosition, int numSamples)
+    {
+        const auto samplesToEdgeOfBuffer = jmin (numSamples, bufferSize - startPosition);
+        
+        audioBuffer->clear (channel, startPosition, samplesToEdgeOfBuffer);
+        
+        if (numSamples > samplesToEdgeOfBuffer)
+            audioBuffer->clear (channel, 0, numSamples - samplesToEdgeOfBuffer);
+    }
+    
+    void copyOut (AudioBuffer<Type> & bufferToFill, int destChannel, int sourceChannel,
+                  int64 startSample, int numSamples) const
+    {
+        const auto readPosition = wrap (startSample);
+        const auto samplesToEdgeOfBuffer = jmin (numSamples, bufferSize - readPosition);
+        
+        bufferToFill.copyFrom (destChannel, 0, *audioBuffer, sourceChannel, readPosition, samplesToEdgeOfBuffer);
+        
+        if (numSamples > samplesToEdgeOfBuffer)
+            bufferToFill.copyFrom (destChannel, samplesToEdgeOfBuffer, *audioBuffer, sourceChannel, 0,
+                                   numSamples - samplesToEdgeOfBuffer);
+    }
+    
     int bufferSize;
     int numChannels;
     std::unique_ptr<AudioBuffer<Type>> audioBuffer;
@@ -185,5 +324,8 @@ private:
                                // not read it in a torn state as it is being
                                // changed.
     
+    std::atomic<int64> numSamplesWritten { 0 };   // monotonic, for trigger search and overrun checks
+    std::atomic<int> largestWrite { 0 };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RingBuffer)
 };
@@ -333,6 +333,12 @@ SettingsComponent::SettingsComponent(ProjectManager * pm)
     buttonMixer->setButtonText("Mixer");
     addAndMakeVisible(buttonMixer.get());
     
+    buttonRecordChannels = std::make_unique<TextButton>();
+    buttonRecordChannels->setTriggeredOnMouseDown(true);
+    buttonRecordChannels->addListener(this);
+    buttonRecordChannels->setButtonText("Record Channels");
+    addAndMakeVisible(buttonRecordChannels.get());
+    
     
     // audio setting stuff
     textButton_OpenAudioSettings = std::make_unique<ImageButton>();
@@ -420,6 +426,17 @@ SettingsComponent::SettingsComponent(ProjectManager * pm)
     noiseTypeMenu->addItem(2, "Pink");
     addAndMakeVisible(comboBox_NoiseType.get());
     
+    // item ids are the oversampling factors themselves
+    comboBox_Oversampling = std::make_unique<ComboBox>();
+    comboBox_Oversampling->addListener(this);
+    PopupMenu * oversamplingMenu =  comboBox_Oversampling->getRootMenu();
+    comboBox_Oversampling->setLookAndFeel(&lookAndFeel);
+    oversamplingMenu->addItem(1, "Oversampling Off");
+    oversamplingMenu->addItem(2, "Oversampling 2x");
+    oversamplingMenu->addItem(4, "Oversampling 4x");
+    oversamplingMenu->addItem(8, "Oversampling 8x");
+    addAndMakeVisible(comboBox_Oversampling.get());
+    
     imageAddPluginIcon      = ImageCache::getFromMemory(BinaryData::ShortcutAdd2x_png, BinaryData::ShortcutAdd2x_pngSize);
     removePluginIcon        = ImageCache::getFromMemory(BinaryData::CloseButton2x_png, BinaryData::CloseButton2x_pngSize);
     openWindowPluginIcon    = ImageCache::getFromMemory(BinaryData::Button_SpectrumOpen_png, BinaryData::Button_SpectrumOpen_pngSize);
@@ -503,6 +520,14 @@ SettingsComponent::SettingsComponent(ProjectManager * pm)
         pluginMenu->addSubMenu("VST3", vstMenu);
         
         addAndMakeVisible(comboBoxPluginSelector[i]);
+        
+        // slots on the same output are chained, NO OUTPUT bypasses the slot
+        comboBoxPluginOutput[i] = std::make_unique<ComboBox>();
+        comboBoxPluginOutput[i]->setLookAndFeel(&lookAndFeel);
+        comboBoxPluginOutput[i]->addListener(this);
+        projectManager->getOutputsPopupMenu(*comboBoxPluginOutput[i]->getRootMenu());
+        comboBoxPluginOutput[i]->setSelectedId((int)projectManager->getProjectSettingsParameter(PLUGIN_OUTPUT_1 + i), dontSendNotification);
+        addAndMakeVisible(comboBoxPluginOutput[i].get());
     }
     
     scanPluginsButton = std::make_unique<ImageButton>();
@@ -669,10 +694,12 @@ SettingsComponent::~SettingsComponent()
     comboBox_Scales->setLookAndFeel(nullptr);
     comboBox_RecordFormat->setLookAndFeel(nullptr);
     comboBox_NoiseType->setLookAndFeel(nullptr);
+    comboBox_Oversampling->setLookAndFeel(nullptr);
     fundamentalFrequencyAlgorithmChooser.setLookAndFeel(nullptr);
     for (int i = 0; i < NUM_PLUGIN_SLOTS; i++)
     {
         comboBoxPluginSelector[i]->setLookAndFeel(nullptr);
+        comboBoxPluginOutput[i]->setLookAndFeel(nullptr);
     }
 //    CustomLookAndFeel::setDefaultLookAndFeel(nullptr);
 }
@@ -758,7 +785,7 @@ void SettingsComponent::buttonClicked (Button*button)
 
         File newFolder = browser.getSelectedFile(0);
 
-        projectManager->logFileDirectory = newFolder;
+        projectManager->setDirectoryFileForSettingParameter(LOG_FILE_LOCATION, newFolder);
         
         // update label string
         String folderLocation(projectManager->logFileDirectory.getFullPathName());
@@ -797,6 +824,10 @@ void SettingsComponent::buttonClicked (Button*button)
     {
         spectrogramPopupComponent->setVisible(true);
     }
+    else if (button == buttonRecordChannels.get())
+    {
+        showRecordChannelsMenu();
+    }
     else if (button == buttonMixer.get())
     {
         PopupFFTWindow * mixerPopup;
@@ -873,9 +904,10 @@ void SettingsComponent::buttonClicked (Button*button)
             else if (button == buttonOpenPlugin[i])
             {
                 PluginAssignProcessor * f = projectManager->pluginAssignProcessor[i].get();
-                if (f->hasPlugin)
+                // the plugin being replaced is deleted once the new one is in
+                if (f->hasPlugin && ! f->isLoading())
                 {
-                    AudioPluginInstance * plugin = f->instance.get();
+                    AudioPluginInstance * plugin = f->getInstance();
                     PluginWindow* const w = PluginWindow::openWindowFor (plugin, false, i);
                     w->toFront (true);
                 }
@@ -933,10 +965,24 @@ void SettingsComponent::comboBoxChanged (ComboBox* comboBoxThatHasChanged)
     {
         projectManager->setProjectSettingsParameter(PANIC_NOISE_TYPE, comboBox_NoiseType->getSelectedId() - 1);
     }
+    else if (comboBoxThatHasChanged == comboBox_Oversampling.get())
+    {
+        projectManager->setProjectSettingsParameter(OVERSAMPLE_FACTOR, comboBox_Oversampling->getSelectedId());
+    }
     else if (comboBoxThatHasChanged == &fundamentalFrequencyAlgorithmChooser)
     {
         projectManager->setProjectSettingsParameter(FUNDAMENTAL_FREQUENCY_ALGORITHM, fundamentalFrequencyAlgorithmChooser.getSelectedItemIndex());
     }
+    else
+    {
+        for (int i = 0; i < NUM_PLUGIN_SLOTS; i++)
+        {
+            if (comboBoxThatHasChanged == comboBoxPluginOutput[i].get())
+            {
+                projectManager->setProjectSettingsParameter(PLUGIN_OUTPUT_1 + i, comboBoxPluginOutput[i]->getSelectedId());
+            }
+        }
+    }
     projectManager->logFileWriter->processLog_Settings_Parameters();
 }
 
@@ -1186,6 +1232,11 @@ void SettingsComponent::updateUI(int settingIndex)
         int type = (int)projectManager->getProjectSettingsParameter(PANIC_NOISE_TYPE);
         comboBox_NoiseType->setSelectedId(type + 1, dontSendNotification);
     }
+    else if (settingIndex == OVERSAMPLE_FACTOR)
+    {
+        int factor = (int)projectManager->getProjectSettingsParameter(OVERSAMPLE_FACTOR);
+        comboBox_Oversampling->setSelectedId(factor, dontSendNotification);
+    }
     else if (settingIndex == AMPLITUDE_MIN)
     {
         double val = projectManager->getProjectSettingsParameter(AMPLITUDE_MIN);
@@ -1265,6 +1316,12 @@ void SettingsComponent::updateUI(int settingIndex)
         
         comboBoxPluginSelector[3]->setSelectedId(val+1, dontSendNotification);
     }
+    else if (settingIndex >= PLUGIN_OUTPUT_1 && settingIndex <= PLUGIN_OUTPUT_4)
+    {
+        int val = projectManager->getProjectSettingsParameter(settingIndex);
+        
+        comboBoxPluginOutput[settingIndex - PLUGIN_OUTPUT_1]->setSelectedId(val, dontSendNotification);
+    }
     else if (settingIndex == FREQUENCY_TO_CHORD)
     {
         int val = projectManager->getProjectSettingsParameter(FREQUENCY_TO_CHORD);
@@ -1438,11 +1495,14 @@ void SettingsComponent::resized()
         buttonRemovePlugin[i]       ->setBounds((centreX + comboWidth + 90 ) * scaleFactor, (y + 11 + (i * ySpace)) * scaleFactor, 22 * scaleFactor, 22 * scaleFactor);
         
         buttonOpenPlugin[i]         ->setBounds((centreX ) * scaleFactor, (y + (i * ySpace) + 10 ) * scaleFactor, 66 * scaleFactor, 22 * scaleFactor);
+        
+        comboBoxPluginOutput[i]     ->setBounds((centreX + comboWidth + 130) * scaleFactor, (y + (i * ySpace)) * scaleFactor, 190 * scaleFactor, 41 * scaleFactor);
     }
     
 //    comboBox_RecordFormat->setBounds(1260 * scaleFactor, 1300 * scaleFactor, 250 * scaleFactor, 41 * scaleFactor);
     
     comboBox_NoiseType->setBounds(1350 * scaleFactor, 130 * scaleFactor, 150 * scaleFactor, 41 * scaleFactor);
+    comboBox_Oversampling->setBounds(1350 * scaleFactor, 190 * scaleFactor, 150 * scaleFactor, 41 * scaleFactor);
     
     button_Load->setBounds(1000 * scaleFactor, 1300 * scaleFactor, 257 * scaleFactor, 69 * scaleFactor);
     button_Save->setBounds(1280 * scaleFactor, 1300 * scaleFactor, 257 * scaleFactor, 69 * scaleFactor);
@@ -1465,10 +1525,44 @@ void SettingsComponent::resized()
     buttonScale100  ->setBounds((scaleButtonX + (sp * 3)) * scaleFactor, scY * scaleFactor, 70 * scaleFactor, 70 * scaleFactor);
     
     buttonMixer     ->setBounds((centreX - 120) * scaleFactor, (y + (6 * ySpace) + 10 ) * scaleFactor, 310 * scaleFactor, 41 * scaleFactor);
+    buttonRecordChannels->setBounds((centreX + 210) * scaleFactor, (y + (6 * ySpace) + 10 ) * scaleFactor, 310 * scaleFactor, 41 * scaleFactor);
 
     fundamentalFrequencyAlgorithmChooser.setBounds(1243 * scaleFactor, 889 * scaleFactor, 263 * scaleFactor, 45 * scaleFactor);
 }
 
+void SettingsComponent::showRecordChannelsMenu()
+{
+    const uint32 channelMask    = (uint32)(int)projectManager->getProjectSettingsParameter(RECORD_CHANNELS);
+    const bool filePerChannel   = (bool)projectManager->getProjectSettingsParameter(RECORD_FILE_PER_CHANNEL);
+    
+    // item ids are the channel's bit in the mask plus one
+    PopupMenu menu;
+    
+    for (int channel = 0; channel < RecordingManager::NUM_CHANNELS; channel++)
+    {
+        if (channel == RecordingManager::INPUT_1)
+            menu.addSeparator();
+        
+        menu.addItem(channel + 1, RecordingManager::getChannelName(channel), true, (channelMask & (1u << channel)) != 0);
+    }
+    
+    menu.addSeparator();
+    menu.addItem(recordFilePerChannelItem, "One File per Channel", true, filePerChannel);
+    
+    Component::SafePointer<SettingsComponent> safeThis (this);
+    
+    menu.showMenuAsync(PopupMenu::Options().withTargetComponent(buttonRecordChannels.get()), [safeThis, channelMask, filePerChannel] (int result)
+    {
+        if (safeThis == nullptr || result == 0)
+            return;
+        
+        if (result == recordFilePerChannelItem)
+            safeThis->projectManager->setProjectSettingsParameter(RECORD_FILE_PER_CHANNEL, ! filePerChannel);
+        else
+            safeThis->projectManager->setProjectSettingsParameter(RECORD_CHANNELS, (int)(channelMask ^ (1u << (result - 1))));
+    });
+}
+
 void SettingsComponent::rescanPlugins()
 {
     // only scan for audio units
@@ -1491,6 +1491,11 @@ private:
     std::unique_ptr<ImageButton> buttonScale100;
     
     std::unique_ptr<TextButton> buttonMixer;
+    std::unique_ptr<TextButton> buttonRecordChannels;
+    
+    // ticks the RECORD_CHANNELS and RECORD_FILE_PER_CHANNEL settings
+    void showRecordChannelsMenu();
+    static constexpr int recordFilePerChannelItem = 100;
     
     Image imageButtonScale25Normal;
     Image imageButtonScale25Selected;
@@ -1518,6 +1523,7 @@ private:
     std::unique_ptr<ComboBox> comboBox_RecordFormat;
     
     std::unique_ptr<ComboBox> comboBox_NoiseType;
+    std::unique_ptr<ComboBox> comboBox_Oversampling;
     
 //    Label * fftWindowLabel;
 //    Label * fftLabel;
@@ -1548,6 +1554,7 @@ private:
     ImageButton *   buttonRemovePlugin[NUM_PLUGIN_SLOTS];
     ImageButton *   buttonOpenPlugin[NUM_PLUGIN_SLOTS];
     ComboBox *      comboBoxPluginSelector[NUM_PLUGIN_SLOTS];
+    std::unique_ptr<ComboBox> comboBoxPluginOutput[NUM_PLUGIN_SLOTS];
     
     std::unique_ptr<ImageButton>   button_Save;
     std::unique_ptr<ImageButton>   button_Load;
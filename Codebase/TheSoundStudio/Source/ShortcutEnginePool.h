@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    ShortcutEnginePool.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "Parameters.h"
+#include "utilities/spsc_queue.h"
+#include <atomic>
+#include <functional>
+
+//=============================================================
+// Shortcut Engine Pool
+//=============================================================
+// The voice engines of a player's shortcuts. An engine is created the first time a
+// shortcut needs one, and a shortcut that no longer needs its engine hands it back for
+// the next one to reuse, so a player only ever holds as many engines as it had shortcuts
+// in use at once.
+//
+// The message thread decides which shortcut gets which engine. The audio thread picks
+// each decision up at the start of its next block. An engine a shortcut lets go of keeps
+// playing as that shortcut's tail until the player calls finishTail(), and only then
+// comes back for reuse, so no engine is handed on while it is still sounding or while
+// the audio thread may be rendering it. Engines are only deleted with the pool, so a
+// stale pointer still points at one.
+//
+// Each shortcut has at most one decision on its way to the audio thread. A newer one
+// waits on the message thread, replacing any older one still waiting, and is sent on
+// the next acquire(), release() or timer tick after the audio thread took the last.
+template <typename Engine>
+class ShortcutEnginePool : private Timer
+{
+public:
+    using CreateFunction    = std::function<std::unique_ptr<Engine>()>;
+    using AttachFunction    = std::function<void (int shortcut, Engine& engine)>;
+
+    // create runs on the message thread with getLock() held. attached runs on the audio
+    // thread when a shortcut gets an engine, to bring it up to date with the shortcut;
+    // detached when a shortcut lets go of one, to release its notes into a tail.
+    ShortcutEnginePool (CreateFunction create, AttachFunction attached, AttachFunction detached)
+        : createEngine (std::move (create)),
+          engineAttached (std::move (attached)),
+          engineDetached (std::move (detached))
+    {
+        for (auto& engine : audioEngines)
+            engine.store (nullptr);
+
+        for (auto& inFlight : bindingInFlight)
+            inFlight.store (false);
+    }
+
+    ~ShortcutEnginePool() override
+    {
+        stopTimer();
+    }
+
+    //=============================================================
+    // Message thread
+    //=============================================================
+    // The shortcut's engine, giving it a returned or a new one if it has none
+    Engine* acquire (int shortcut)
+    {
+        jassert (isPositiveAndBelow (shortcut, NUM_SHORTCUT_SYNTHS));
+
+        if (auto* engine = engines[shortcut])
+            return engine;
+
+        collectReleased();
+
+        Engine* engine = spareEngines.isEmpty() ? nullptr : spareEngines.removeAndReturn (spareEngines.size() - 1);
+
+        if (engine == nullptr)
+        {
+            const ScopedLock sl (lock);
+            engine = allEngines.add (createEngine().release());
+        }
+
+        engines[shortcut] = engine;
+        sendBindings();
+
+        return engine;
+    }
+
+    void release (int shortcut)
+    {
+        jassert (isPositiveAndBelow (shortcut, NUM_SHORTCUT_SYNTHS));
+
+        auto* engine = engines[shortcut];
+
+        if (engine == nullptr)
+            return;
+
+        // never sent, so the audio thread hasn't seen it
+        if (engine != sentEngines[shortcut])
+            spareEngines.add (engine);
+
+        engines[shortcut] = nullptr;
+        sendBindings();
+    }
+
+    Engine* getEngine (int shortcut) const     { return engines[shortcut]; }
+
+    int getNumEngines() const                   { const ScopedLock sl (lock); return allEngines.size(); }
+
+    // Any thread but the audio thread
+    const CriticalSection& getLock() const noexcept     { return lock; }
+
+    template <typename Function>
+    void forEachEngine (Function&& function)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto* engine : allEngines)
+            function (*engine);
+    }
+
+    //=============================================================
+    // Audio thread
+    //=============================================================
+    // At the start of each block, before rendering any shortcut
+    void update() noexcept
+    {
+        Binding binding;
+
+        while (bindings.try_pop (binding))
+        {
+            bind (binding);
+            bindingInFlight[binding.shortcut].store (false, std::memory_order_release);
+        }
+    }
+
+    // Also safe from other threads: the engine may have moved on, but it still exists
+    Engine* get (int shortcut) const noexcept
+    {
+        return audioEngines[shortcut].load (std::memory_order_acquire);
+    }
+
+    // The engine the shortcut let go of, still to be rendered until its notes have
+    // faded, or nullptr
+    Engine* getTail (int shortcut) const noexcept       { return tailEngines[shortcut]; }
+
+    // Once the tail is silent, or not worth waiting for any longer
+    void finishTail (int shortcut) noexcept
+    {
+        if (auto* tail = tailEngines[shortcut])
+        {
+            tailEngines[shortcut] = nullptr;
+            returnEngine (tail);
+        }
+    }
+
+    // For telling whether a tail has played out: a voice clears its note once its
+    // envelope has finished
+    static bool hasActiveVoices (const Synthesiser& synth) noexcept
+    {
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->isVoiceActive())
+                return true;
+
+        return false;
+    }
+
+private:
+    struct Binding
+    {
+        int     shortcut    = 0;
+        Engine* engine      = nullptr;     // nullptr to take the shortcut's engine away
+    };
+
+    void bind (const Binding& binding) noexcept
+    {
+        if (auto* previous = audioEngines[binding.shortcut].load (std::memory_order_relaxed))
+        {
+            // a shortcut plays out one tail at a time; one still going when the shortcut
+            // lets go of another engine is cut short
+            finishTail (binding.shortcut);
+
+            tailEngines[binding.shortcut] = previous;
+            engineDetached (binding.shortcut, *previous);
+        }
+
+        audioEngines[binding.shortcut].store (binding.engine, std::memory_order_release);
+
+        if (binding.engine != nullptr)
+            engineAttached (binding.shortcut, *binding.engine);
+    }
+
+    void returnEngine (Engine* engine) noexcept
+    {
+        // a shortcut accounts for at most four engines at once: one playing, one tail, one
+        // on its way and one waiting on the message thread. The queue holds that many for
+        // every shortcut, so it can't be full
+        const bool sent = releasedEngines.try_push (engine);
+        jassert (sent);
+        ignoreUnused (sent);
+    }
+
+    void sendBindings()
+    {
+        collectReleased();
+
+        bool anyWaiting = false;
+
+        for (int shortcut = 0; shortcut < NUM_SHORTCUT_SYNTHS; ++shortcut)
+        {
+            if (engines[shortcut] == sentEngines[shortcut])
+                continue;
+
+            if (bindingInFlight[shortcut].load (std::memory_order_acquire))
+            {
+                anyWaiting = true;
+                continue;
+            }
+
+            // one binding per shortcut in flight, so the queue can't be full
+            bindingInFlight[shortcut].store (true, std::memory_order_relaxed);
+
+            const bool sent = bindings.try_push ({ shortcut, engines[shortcut] });
+            jassert (sent);
+            ignoreUnused (sent);
+
+            sentEngines[shortcut] = engines[shortcut];
+        }
+
+        if (anyWaiting)
+        {
+            if (! isTimerRunning())
+                startTimer (retryIntervalMs);
+        }
+        else
+        {
+            stopTimer();
+        }
+    }
+
+    void timerCallback() override
+    {
+        sendBindings();
+    }
+
+    void collectReleased()
+    {
+        Engine* engine = nullptr;
+
+        while (releasedEngines.try_pop (engine))
+            spareEngines.add (engine);
+    }
+
+    static constexpr int retryIntervalMs    = 20;
+    static constexpr int releasedQueueSize  = 4 * NUM_SHORTCUT_SYNTHS;
+
+    CreateFunction  createEngine;
+    AttachFunction  engineAttached;
+    AttachFunction  engineDetached;
+
+    // message thread
+    Engine*         engines[NUM_SHORTCUT_SYNTHS] {};        // what each shortcut should have
+    Engine*         sentEngines[NUM_SHORTCUT_SYNTHS] {};    // what the audio thread has, or is about to
+    Array<Engine*>  spareEngines;
+
+    CriticalSection     lock;
+    OwnedArray<Engine>  allEngines;
+
+    audio_devs::spsc_queue<Binding> bindings        { NUM_SHORTCUT_SYNTHS };
+    audio_devs::spsc_queue<Engine*> releasedEngines { releasedQueueSize };
+    std::atomic<bool>               bindingInFlight[NUM_SHORTCUT_SYNTHS];
+
+    // audio thread
+    std::atomic<Engine*> audioEngines[NUM_SHORTCUT_SYNTHS];
+    Engine*              tailEngines[NUM_SHORTCUT_SYNTHS] {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShortcutEnginePool)
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ShortcutOversampler.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include "hiir/Downsampler2xSse.h"
+#else
+ #include "hiir/Downsampler2xFpu.h"
+#endif
+
+#include "hiir/PolyphaseIir2Designer.h"
+
+//=============================================================
+// Shortcut Oversampler
+//=============================================================
+// Oversampling stage for one shortcut synth. The synth's voices render at factor x the
+// host rate into a buffer owned by this class, then the summed signal is brought back down
+// by a cascade of 2x polyphase IIR halfband decimators (hiir), so the filtering cost is
+// paid once per shortcut however many voices are playing.
+//
+// The last stage carries the steep filter that guards the audible band (~100 dB of
+// rejection above 0.46 fs); the stages before it only have to clear the images that would
+// fold into that band, so they get away with far fewer coefficients.
+//
+// The oversampled buffer and the filter states are sized by prepare() and setFactor(),
+// both called from the message thread while the owning processor is suspended, so the
+// audio thread never allocates.
+class ShortcutOversampler
+{
+public:
+    static constexpr int maxFactor = 8;
+
+    ShortcutOversampler()
+    {
+        double finalCoefs[numFinalCoefs];
+        double earlyCoefs[numEarlyCoefs];
+
+        hiir::PolyphaseIir2Designer::compute_coefs_spec_order_tbw (finalCoefs, numFinalCoefs, finalTransition);
+        hiir::PolyphaseIir2Designer::compute_coefs_spec_order_tbw (earlyCoefs, numEarlyCoefs, earlyTransition);
+
+        finalStage.set_coefs (finalCoefs);
+
+        for (auto& stage : earlyStages)
+            stage.set_coefs (earlyCoefs);
+
+        reset();
+    }
+
+    // 1 (bypassed), 2, 4 or 8
+    static bool isValidFactor (int factor) noexcept
+    {
+        return factor == 1 || factor == 2 || factor == 4 || factor == 8;
+    }
+
+    void prepare (int maximumBlockSize)
+    {
+        maxBlockSize = maximumBlockSize;
+        updateBuffer();
+        reset();
+    }
+
+    void setFactor (int newFactor)
+    {
+        jassert (isValidFactor (newFactor));
+
+        if (! isValidFactor (newFactor) || newFactor == factor)
+            return;
+
+        factor = newFactor;
+        numStages = factor == 8 ? 3 : (factor == 4 ? 2 : (factor == 2 ? 1 : 0));
+
+        updateBuffer();
+        reset();
+    }
+
+    int getFactor() const noexcept { return factor; }
+
+    // Clears the filter memories, e.g. after a panic or a sample rate change
+    void reset() noexcept
+    {
+        finalStage.clear_buffers();
+
+        for (auto& stage : earlyStages)
+            stage.clear_buffers();
+    }
+
+    // Audio thread. Calls render (buffer, startSample, numSamples) to fill a section of a
+    // mono buffer, then writes the result to channel 0 of output at the host rate. With a
+    // factor of 1 the renderer writes straight into output, as if there was no stage here.
+    // Otherwise output[startSample, startSample + numSamples) is overwritten, not added to.
+    template <typename RenderFunction>
+    void process (AudioBuffer<float>& output, int startSample, int numSamples, RenderFunction&& render)
+    {
+        if (factor == 1)
+        {
+            render (output, startSample, numSamples);
+            return;
+        }
+
+        jassert (startSample + numSamples <= maxBlockSize);
+
+        const int oversampledStart      = startSample * factor;
+        const int numOversampledSamples = numSamples * factor;
+
+        oversampledBuffer.clear (oversampledStart, numOversampledSamples);
+
+        render (oversampledBuffer, oversampledStart, numOversampledSamples);
+
+        // every early stage halves the block in place, the final one writes the output
+        float* data = oversampledBuffer.getWritePointer (0, oversampledStart);
+        long numOut = numOversampledSamples;
+
+        for (int i = 0; i < numStages - 1; ++i)
+        {
+            numOut /= 2;
+            earlyStages[i].process_block (data, data, numOut);
+        }
+
+        finalStage.process_block (output.getWritePointer (0, startSample), data, numSamples);
+    }
+
+private:
+   #if JUCE_USE_SSE_INTRINSICS
+    template <int numCoefs> using Downsampler = hiir::Downsampler2xSse<numCoefs>;
+   #else
+    template <int numCoefs> using Downsampler = hiir::Downsampler2xFpu<numCoefs>;
+   #endif
+
+    static constexpr int    numFinalCoefs   = 8;
+    static constexpr double finalTransition = 0.04;
+    static constexpr int    numEarlyCoefs   = 4;
+    static constexpr double earlyTransition = 0.2;
+    static constexpr int    maxStages       = 3;
+
+    void updateBuffer()
+    {
+        oversampledBuffer.setSize (1, factor > 1 ? maxBlockSize * factor : 0);
+        oversampledBuffer.clear();
+    }
+
+    Downsampler<numFinalCoefs> finalStage;
+    Downsampler<numEarlyCoefs> earlyStages[maxStages - 1];
+
+    AudioBuffer<float> oversampledBuffer;
+
+    int factor       = 1;
+    int numStages    = 0;
+    int maxBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ShortcutOversampler)
+};
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    SpectralPeakPicker.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// A local maximum of a magnitude spectrum, refined by fitting a parabola through the
+// log magnitudes of the bin and its two neighbours
+struct SpectralPeak
+{
+    int   binIndex  = 0;    // the bin that is the local maximum
+    float bin       = 0;    // interpolated position, within half a bin of binIndex
+    float magnitude = 0;    // interpolated height, same units as the spectrum
+};
+
+// The maxPeaks loudest local maxima of one spectrum, loudest first, found in a single
+// pass over the bins. A bin is a local maximum when it is louder than the bin below and
+// no quieter than the bin above, which makes the first bin of a plateau the peak and
+// lets the edges of the scanned range count too. So peaks[0] is always the bin a plain
+// "first loudest bin" scan would have found.
+//
+// Fixed capacity and no allocation, so it can live in a published snapshot and be filled
+// on an analysis thread.
+template <int maxPeaks>
+class SpectralPeaks
+{
+public:
+    static_assert (maxPeaks > 0, "need room for at least one peak");
+
+    // Scans magnitudes[startBin, endBin)
+    void find (const float* magnitudes, int startBin, int endBin) noexcept
+    {
+        numPeaks = 0;
+
+        if (magnitudes == nullptr || endBin <= startBin)
+            return;
+
+        // min-heap on loudness: peaks[0] is the quietest one kept so far
+        for (int i = startBin; i < endBin; ++i)
+        {
+            const float m = magnitudes[i];
+
+            if ((i > startBin && ! (m > magnitudes[i - 1])) || (i + 1 < endBin && m < magnitudes[i + 1]))
+                continue;
+
+            const SpectralPeak candidate { i, (float) i, m };
+
+            if (numPeaks < maxPeaks)
+            {
+                peaks[(size_t) numPeaks++] = candidate;
+                std::push_heap (peaks.begin(), peaks.begin() + numPeaks, isLouder);
+            }
+            else if (isLouder (candidate, peaks[0]))
+            {
+                std::pop_heap (peaks.begin(), peaks.begin() + numPeaks, isLouder);
+                peaks[(size_t) numPeaks - 1] = candidate;
+                std::push_heap (peaks.begin(), peaks.begin() + numPeaks, isLouder);
+            }
+        }
+
+        std::sort_heap (peaks.begin(), peaks.begin() + numPeaks, isLouder);
+
+        for (int p = 0; p < numPeaks; ++p)
+            interpolate (peaks[(size_t) p], magnitudes, startBin, endBin);
+    }
+
+    void clear() noexcept                               { numPeaks = 0; }
+
+    int size() const noexcept                           { return numPeaks; }
+    bool isEmpty() const noexcept                       { return numPeaks == 0; }
+
+    const SpectralPeak& operator[] (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, numPeaks));
+        return peaks[(size_t) index];
+    }
+
+    // Loudest peak whose bin lies in [fromBin, toBin), or nullptr
+    const SpectralPeak* findLoudestInRange (int fromBin, int toBin) const noexcept
+    {
+        for (int p = 0; p < numPeaks; ++p)
+            if (peaks[(size_t) p].binIndex >= fromBin && peaks[(size_t) p].binIndex < toBin)
+                return &peaks[(size_t) p];
+
+        return nullptr;
+    }
+
+private:
+    // louder first, and the lower bin first between equals
+    static bool isLouder (const SpectralPeak& a, const SpectralPeak& b) noexcept
+    {
+        return a.magnitude > b.magnitude || (a.magnitude == b.magnitude && a.binIndex < b.binIndex);
+    }
+
+    static void interpolate (SpectralPeak& peak, const float* magnitudes, int startBin, int endBin) noexcept
+    {
+        const int i = peak.binIndex;
+
+        if (i <= startBin || i + 1 >= endBin || peak.magnitude <= 0.f)
+            return;
+
+        const float floor = 1.0e-30f;
+        const float a     = std::log (jmax (floor, magnitudes[i - 1]));
+        const float b     = std::log (peak.magnitude);
+        const float c     = std::log (jmax (floor, magnitudes[i + 1]));
+        const float curve = a - 2.f * b + c;
+
+        if (! (curve < 0.f))
+            return;
+
+        const float offset = jlimit (-0.5f, 0.5f, 0.5f * (a - c) / curve);
+
+        peak.bin        = (float) i + offset;
+        peak.magnitude  = std::exp (b - 0.25f * (a - c) * offset);
+    }
+
+    std::array<SpectralPeak, (size_t) maxPeaks> peaks;
+    int numPeaks = 0;
+};
@@ -1285,8 +1285,7 @@ void ColourSpectrumVisualiserComponent::paint (Graphics&g)
     
     g.setOpacity (1.0f);
     
-    if (newSpectrogramImage != nullptr)
-        g.drawImage (*newSpectrogramImage, getLocalBounds().toFloat());
+    drawSpectrogramRing(g, getLocalBounds());
     
     drawFrequencyLines(g);
     drawTimelineGrid(g);
@@ -1393,17 +1392,46 @@ void ColourSpectrumVisualiserComponent::drawTimelineGrid(Graphics &g)
 
 }
 
+// The image is a ring of columns: everything from writeColumn on is older than the
+// columns before it, so it goes on the left
+void ColourSpectrumVisualiserComponent::drawSpectrogramRing(Graphics &g, Rectangle<int> area)
+{
+    if (newSpectrogramImage == nullptr)
+        return;
+
+    const int imageWidth  = newSpectrogramImage->getWidth();
+    const int imageHeight = newSpectrogramImage->getHeight();
+    const int numOlder    = imageWidth - writeColumn;
+
+    auto older = area.removeFromLeft(roundToInt(area.getWidth() * (float)numOlder / (float)imageWidth));
+
+    g.drawImage(*newSpectrogramImage, older.getX(), older.getY(), older.getWidth(), older.getHeight(),
+                writeColumn, 0, numOlder, imageHeight);
+
+    if (writeColumn > 0)
+        g.drawImage(*newSpectrogramImage, area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                    0, 0, writeColumn, imageHeight);
+}
+
 void ColourSpectrumVisualiserComponent::resized()
 {
     if (newSpectrogramImage != nullptr)
     {
-        Image rescaledImage(newSpectrogramImage->createCopy());
-        newSpectrogramImage = std::make_unique<Image>(rescaledImage.rescaled(jmax(1, getWidth()), jmax(1, getHeight())));
+        // unroll the ring before rescaling, so the history stays in time order
+        Image unrolledImage(Image::RGB, newSpectrogramImage->getWidth(), newSpectrogramImage->getHeight(), false);
+        {
+            Graphics g(unrolledImage);
+            drawSpectrogramRing(g, unrolledImage.getBounds());
+        }
+
+        newSpectrogramImage = std::make_unique<Image>(unrolledImage.rescaled(jmax(1, getWidth()), jmax(1, getHeight())));
     }
     else
     {
         newSpectrogramImage = std::make_unique<Image>(Image::RGB, jmax(1, getWidth()), jmax(1, getHeight()), true);
     }
+
+    writeColumn = 0;
 }
 
 void ColourSpectrumVisualiserComponent::pushUpdate()
@@ -1432,5 +1460,10 @@ void ColourSpectrumVisualiserComponent::drawNextLineOfSpectrogram()
     if (fftRef < 0 || fftRef >= 8)
         return;
 
-    projectManager->createColourSpectrum(fftRef, *newSpectrogramImage, zoomRange_FreqLow, zoomRange_FreqHigh, 0.2);
+    if (writeColumn >= newSpectrogramImage->getWidth())
+        writeColumn = 0;
+
+    projectManager->createColourSpectrum(fftRef, *newSpectrogramImage, writeColumn, (float)zoomRange_FreqLow, (float)zoomRange_FreqHigh);
+
+    writeColumn = (writeColumn + 1) % newSpectrogramImage->getWidth();
 }
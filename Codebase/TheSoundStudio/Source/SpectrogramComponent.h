@@ -197,7 +197,8 @@ public:
         if (channelIndex < 0 || channelIndex >= 8)
             return;
 
-        AudioBuffer<float> oscilloscopeBuffer(projectManager->getOscilloscopeBufferForChannel(channelIndex));
+        if (!projectManager->readOscilloscopeWindow(channelIndex, oscilloscopeBuffer))
+            return;
 
         const int numSamples = oscilloscopeBuffer.getNumSamples();
         if (numSamples < 3)
@@ -259,6 +260,7 @@ private:
     Image *imageOscilloscope;
     bool shouldDrawOscilloscope = true;
     Path oscilloscopePath;
+    AudioBuffer<float> oscilloscopeBuffer;  // reused for every frame
 
 };
 
@@ -465,7 +467,11 @@ public:
             if (channelIndex < 0 || channelIndex >= 8)
                 return;
 
-            AudioBuffer<float> lissajousBuffer(projectManager->getOscilloscopeBufferForChannel(channelIndex));
+            // free running: an x/y plot has no time axis to lock
+            if (!projectManager->readOscilloscopeWindow(channelIndex, outputWindow, RingBuffer<float>::TriggerMode::freeRunning))
+                return;
+
+            const AudioBuffer<float>& lissajousBuffer = outputWindow;
 
             const int numSamples = lissajousBuffer.getNumSamples();
             if (numSamples < 1 || lissajousBuffer.getNumChannels() < 2)
@@ -505,6 +511,7 @@ private:
     Image *imageLissajous;
     bool shouldDrawLissajous = true;
     Path lissajousPath;
+    AudioBuffer<float> outputWindow;        // reused for every frame
     
     bool isForLissajous;
 };
@@ -1035,6 +1042,7 @@ public:
     void drawFrequencyLines(Graphics &g);
     void drawTimelineGrid(Graphics &g);
     void drawNextLineOfSpectrogram();
+    void drawSpectrogramRing(Graphics &g, Rectangle<int> area);
     
     void resized() override;
 
@@ -1067,6 +1075,7 @@ private:
     float sampleRate;
     Image spectrogramImage;
     std::unique_ptr<Image> newSpectrogramImage;
+    int writeColumn = 0;    // next column of newSpectrogramImage to draw, the oldest one on screen
     
     
     
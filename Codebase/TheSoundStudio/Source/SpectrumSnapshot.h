@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    SpectrumSnapshot.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "SpectralPeakPicker.h"
+
+// One averaged magnitude spectrum as published by AnalyserNew. Readers treat it as
+// immutable: every field describes the same analysis frame, so the bin count, FFT size
+// and sample rate can never disagree with the data even while the FFT size is changing.
+struct SpectrumSnapshot
+{
+    uint64 version      = 0;        // 0 = nothing published yet
+    int    fftSize      = 0;
+    int    numBins      = 0;        // fftSize / 2
+    float  sampleRate   = 0.f;
+
+    std::vector<float> magnitudes;  // capacity preallocated, only numBins are valid
+    SpectralPeaks<32>  peaks;       // loudest local maxima of magnitudes, found when published
+
+    bool isValid() const noexcept { return version != 0 && numBins > 0; }
+
+    float binToFrequency (float bin) const noexcept
+    {
+        return fftSize > 0 ? (sampleRate * bin) / (float) fftSize : 0.f;
+    }
+};
@@ -349,8 +349,8 @@ public:
 		// --- NOTE: Fs/8 = Nyquist/4
 		if(m_dFo <= m_dSampleRate/8.0)
 		{
-			dOut = dTrivialSaw + doBLEP_N(&dBLEPTable_8_BLKHAR[0], /* BLEP table */
-										4096,			/* BLEP table length */
+			dOut = dTrivialSaw + doBLEP_N(BLEPTables::get().getEightPointBlackmanHarrisTable(), /* BLEP table */
+										BLEPTables::tableLength,	/* BLEP table length */
 										dModulo,		/* current phase value */
 										fabs(dInc),	/* abs(dInc) is for FM synthesis with negative frequencies */
 										1.0,			/* sawtooth edge height = 1.0 */
@@ -360,8 +360,8 @@ public:
 		}
 		else // to prevent overlapping BLEPs, default back to 2-point for f > Nyquist/4
 		{
-			dOut = dTrivialSaw + doBLEP_N(&dBLEPTable[0], /* BLEP table */
-										4096,			/* BLEP table length */
+			dOut = dTrivialSaw + doBLEP_N(BLEPTables::get().getTwoPointTable(), /* BLEP table */
+										BLEPTables::tableLength,	/* BLEP table length */
 										dModulo,		/* current phase value */
 										fabs(dInc),	/* abs(dInc) is for FM synthesis with negative frequencies */
 										1.0,			/* sawtooth edge height = 1.0 */
@@ -78,7 +78,7 @@ void ChordSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int sta
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -92,8 +92,8 @@ void ChordSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int sta
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -346,7 +346,7 @@ void FrequencySynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -360,8 +360,8 @@ void FrequencySynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -713,7 +713,7 @@ void FrequencyScannerSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuff
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -727,8 +727,8 @@ void FrequencyScannerSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuff
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
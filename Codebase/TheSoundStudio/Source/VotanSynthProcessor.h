@@ -125,7 +125,7 @@ class ChordSynthProcessor : public Synthesiser
 public:
     ChordSynthProcessor(float hwsamplerate, FrequencyManager * fm)
     {
-        internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+        internal_sample_rate    = hwsamplerate;
         frequencyManager        = fm;
         
         clearVoices();
@@ -148,11 +148,21 @@ public:
     void prepareToPlay(float hwSampleRate, int blockSize)
     {
 //        printf("Processor Prepare to Play, SR = %f, Blocksize = %i", hwSampleRate, blockSize);
-        internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+        internal_sample_rate = hwSampleRate * oversamplingFactor;
         
         setCurrentPlaybackSampleRate(internal_sample_rate);
     }
     
+    // voices render at hwSampleRate * newFactor from the next prepareToPlay()
+    void setOversamplingFactor(int newFactor)
+    {
+        oversamplingFactor = newFactor;
+        
+        for (int i = 0; i < MAX_NUM_VOICES; i++) {
+            cVoices[i]->set_oversample_factor(newFactor);
+        }
+    }
+    
     void processBlock(AudioBuffer<float>& buffer,
                       MidiBuffer& midiMessages)
     {
@@ -205,6 +215,7 @@ public:
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
 
     ChordSynthVoice * cVoices[MAX_NUM_VOICES];
 
@@ -326,12 +337,12 @@ public:
     // Mono synth...
     FrequencySynthProcessor(float hwsamplerate, FrequencyManager * fm)
     {
-        internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+        internal_sample_rate    = hwsamplerate;
         frequencyManager        = fm;
         
         clearVoices();
         
-        for (int i = 0; i < 1; i++) {
+        for (int i = 0; i < numVoices; i++) {
             cVoices[i] = new FrequencySynthVoice(internal_sample_rate, frequencyManager);
             cVoices[i]->setVoiceRef(i);
             this->addVoice(cVoices[i]);
@@ -348,11 +359,20 @@ public:
     void prepareToPlay(float hwSampleRate, int blockSize)
     {
 //        printf("Processor Prepare to Play, SR = %f, Blocksize = %i", hwSampleRate, blockSize);
-        internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+        internal_sample_rate = hwSampleRate * oversamplingFactor;
         
         setCurrentPlaybackSampleRate(internal_sample_rate);
     }
     
+    void setOversamplingFactor(int newFactor)
+    {
+        oversamplingFactor = newFactor;
+        
+        for (int i = 0; i < numVoices; i++) {
+            cVoices[i]->set_oversample_factor(newFactor);
+        }
+    }
+    
     void processBlock(AudioBuffer<float>& buffer,
                       MidiBuffer& midiMessages)
     {
@@ -361,14 +381,14 @@ public:
     
     void setParameter(int index, var newValue)
     {
-        for (int i = 0; i < 1; i++) {
+        for (int i = 0; i < numVoices; i++) {
             cVoices[i]->setParameter(index, newValue);
         }
     }
     
     void setPhase(double newPhase)
     {
-        for (int i = 0; i < 1; i++) {
+        for (int i = 0; i < numVoices; i++) {
             cVoices[i]->setPhase(newPhase);
         }
     }
@@ -383,8 +403,10 @@ public:
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
     
-    FrequencySynthVoice * cVoices[1];
+    static constexpr int numVoices = 1;       // mono, every loop over cVoices stops here
+    FrequencySynthVoice * cVoices[numVoices];
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrequencySynthProcessor)
 };
@@ -466,7 +488,7 @@ public:
     // Mono synth...
     FrequencyScannerSynthProcessor(float hwsamplerate, FrequencyManager * fm)
     {
-        internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+        internal_sample_rate    = hwsamplerate;
         frequencyManager        = fm;
         
         clearVoices();
@@ -488,11 +510,20 @@ public:
     void prepareToPlay(float hwSampleRate, int blockSize)
     {
 //        printf("Processor Prepare to Play, SR = %f, Blocksize = %i", hwSampleRate, blockSize);
-        internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+        internal_sample_rate = hwSampleRate * oversamplingFactor;
         
         setCurrentPlaybackSampleRate(internal_sample_rate);
     }
     
+    void setOversamplingFactor(int newFactor)
+    {
+        oversamplingFactor = newFactor;
+        
+        for (int i = 0; i < MAX_NUM_VOICES; i++) {
+            cVoices[i]->set_oversample_factor(newFactor);
+        }
+    }
+    
     void processBlock(AudioBuffer<float>& buffer,
                       MidiBuffer& midiMessages)
     {
@@ -532,6 +563,7 @@ public:
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
     
     FrequencyScannerSynthVoice * cVoices[MAX_NUM_VOICES];
     
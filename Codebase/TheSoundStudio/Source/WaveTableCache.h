@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    WaveTableCache.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include "WaveTableOsc.h"
+
+// Process-wide store of band-limited wavetable sets. Every shortcut synth and voice that
+// asks for the same wave gets the same immutable WaveTableSet, so a table is built (one
+// FFT per octave) the first time it is needed and then shared, instead of once per voice
+// on every waveform change.
+//
+// Sets built from a time-domain wave are keyed by a hash of its samples; their tables are
+// normalised to cycles per sample, so they serve every sample rate. The band-limited
+// sawtooth / square builders depend on the base frequency and sample rate, which become
+// part of their key.
+//
+// Used from the message thread and the wavetable builder thread, never from the audio
+// thread; calls are serialised by its lock. Sets nothing else references any more are
+// released the next time a new set is built. A set that was just swapped out of a playing
+// oscillator is still referenced by its WaveTableSwap until the audio thread is done with it.
+class WaveTableCache
+{
+public:
+    enum Waveform
+    {
+        customWave = 0,
+        bandLimitedSawtooth,
+        bandLimitedSquare
+    };
+
+    static WaveTableCache& getInstance()
+    {
+        static WaveTableCache instance;
+        return instance;
+    }
+
+    // Set for an arbitrary single-cycle wave of tableLen samples
+    WaveTableSet::Ptr getTables (const double* waveSamples, int tableLen)
+    {
+        jassert (waveSamples != nullptr && tableLen > 0);
+
+        const Key key { customWave, 0.0, hashSamples (waveSamples, tableLen), tableLen };
+
+        return getOrBuild (key, [&] (WaveTableSet& tables)
+        {
+            WaveTableOsc::buildFromWave (tables, waveSamples, tableLen);
+        });
+    }
+
+    WaveTableSet::Ptr getBandLimitedTables (Waveform waveform, float baseFreq, float sampleRate)
+    {
+        jassert (waveform != customWave);
+
+        uint64 frequencyBits = 0;
+        std::memcpy (&frequencyBits, &baseFreq, sizeof (baseFreq));
+
+        const Key key { waveform, (double) sampleRate, frequencyBits, 0 };
+
+        return getOrBuild (key, [&] (WaveTableSet& tables)
+        {
+            if (waveform == bandLimitedSquare)
+                WaveTableOsc::buildSquare (tables, baseFreq, sampleRate);
+            else
+                WaveTableOsc::buildSawtooth (tables, baseFreq, sampleRate);
+        });
+    }
+
+    // Drops every set that is only referenced by the cache
+    void releaseUnusedTables()
+    {
+        const ScopedLock sl (cacheLock);
+
+        for (auto it = tableSets.begin(); it != tableSets.end();)
+        {
+            if (it->second->getReferenceCount() == 1)
+                it = tableSets.erase (it);
+            else
+                ++it;
+        }
+    }
+
+    int getNumTableSets()
+    {
+        const ScopedLock sl (cacheLock);
+        return (int) tableSets.size();
+    }
+
+    size_t getSizeInBytes()
+    {
+        const ScopedLock sl (cacheLock);
+
+        size_t total = 0;
+
+        for (auto& entry : tableSets)
+            total += entry.second->getSizeInBytes();
+
+        return total;
+    }
+
+private:
+    WaveTableCache() = default;
+
+    struct Key
+    {
+        int    waveform;
+        double sampleRate;
+        uint64 hash;
+        int    length;
+
+        bool operator< (const Key& other) const noexcept
+        {
+            return std::tie (waveform, sampleRate, hash, length)
+                 < std::tie (other.waveform, other.sampleRate, other.hash, other.length);
+        }
+    };
+
+    template <typename BuildFunction>
+    WaveTableSet::Ptr getOrBuild (const Key& key, BuildFunction&& build)
+    {
+        const ScopedLock sl (cacheLock);
+
+        auto existing = tableSets.find (key);
+
+        if (existing != tableSets.end())
+            return existing->second;
+
+        releaseUnusedTables();
+
+        WaveTableSet::Ptr tables = new WaveTableSet();
+        build (*tables);
+
+        tableSets[key] = tables;
+
+        return tables;
+    }
+
+    // 64 bit FNV-1a over the raw sample bits
+    static uint64 hashSamples (const double* samples, int numSamples) noexcept
+    {
+        auto* bytes = reinterpret_cast<const uint8*> (samples);
+        const size_t numBytes = (size_t) numSamples * sizeof (double);
+
+        uint64 hash = 14695981039346656037ull;
+
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    CriticalSection cacheLock;
+    std::map<Key, WaveTableSet::Ptr> tableSets;
+
+    // static lifetime, so no leak detector: it would outlive the detector's counters
+    JUCE_DECLARE_NON_COPYABLE (WaveTableCache)
+};
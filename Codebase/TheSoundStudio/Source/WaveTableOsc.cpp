@@ -12,16 +12,11 @@
 */
 
 #include "WaveTableOsc.h"
+#include "WaveTableCache.h"
 
-WaveTableOsc::WaveTableOsc(void)
+WaveTableSet::WaveTableSet()
 {
-    phaseParam = 0.0;
-    phasor = 0.0;
-    phaseInc = 0.0;
-    phaseOfs = 0.5;
     numWaveTables = 0;
-    now = false;
-    sample_Rate = 44100;
     
     for (int idx = 0; idx < numWaveTableSlots; idx++)
     {
@@ -29,6 +24,32 @@ WaveTableOsc::WaveTableOsc(void)
         waveTables[idx].waveTableLen = 0;
         waveTables[idx].waveTable = 0;
     }
+}
+
+WaveTableSet::~WaveTableSet()
+{
+    for (int idx = 0; idx < numWaveTables; idx++)
+        delete [] waveTables[idx].waveTable;
+}
+
+size_t WaveTableSet::getSizeInBytes() const
+{
+    size_t total = sizeof (WaveTableSet);
+    
+    for (int idx = 0; idx < numWaveTables; idx++)
+        total += (size_t) waveTables[idx].waveTableLen * sizeof (float);
+    
+    return total;
+}
+
+WaveTableOsc::WaveTableOsc(void)
+{
+    phaseParam = 0.0;
+    phasor = 0.0;
+    phaseInc = 0.0;
+    phaseOfs = 0.5;
+    now = false;
+    sample_Rate = 44100;
     
     // init default wavetable
     
@@ -43,7 +64,7 @@ WaveTableOsc::~WaveTableOsc(void)
 }
 
 
-float WaveTableOsc::makeWaveTable(WaveTableOsc *osc, int len, myFloat *ar, myFloat *ai, myFloat scale, double topFreq) {
+float WaveTableOsc::makeWaveTable(WaveTableSet& tables, int len, myFloat *ar, myFloat *ai, myFloat scale, double topFreq) {
     fft(len, ar, ai);
     
     if (scale == 0.0) {
@@ -63,7 +84,7 @@ float WaveTableOsc::makeWaveTable(WaveTableOsc *osc, int len, myFloat *ar, myFlo
     for (int idx = 0; idx < len; idx++)
         wave[idx] = ai[idx] * scale;
     
-    if (osc->addWaveTable(len, wave, topFreq))
+    if (tables.addWaveTable(len, wave, topFreq))
         scale = 0.0;
 
 	delete [] wave;
@@ -75,11 +96,11 @@ float WaveTableOsc::makeWaveTable(WaveTableOsc *osc, int len, myFloat *ar, myFlo
 //
 // fillTables:
 //
-// The main function of interest here; call this with a pointer to an new, empty oscillator,
-// and the real and imaginary arrays and their length. The function fills the oscillator with
+// The main function of interest here; call this with a new, empty table set,
+// and the real and imaginary arrays and their length. The function fills the set with
 // all wavetables necessary for full-bandwidth operation.
 //
-void WaveTableOsc::fillTables(WaveTableOsc *osc, double *freqWaveRe, double *freqWaveIm, int numSamples)
+void WaveTableOsc::fillTables(WaveTableSet& tables, double *freqWaveRe, double *freqWaveIm, int numSamples)
 {
     int idx;
     
@@ -113,7 +134,7 @@ void WaveTableOsc::fillTables(WaveTableOsc *osc, double *freqWaveRe, double *fre
         }
         
         // make the wavetable
-        scale = makeWaveTable(osc, numSamples, ar, ai, scale, topFreq);
+        scale = makeWaveTable(tables, numSamples, ar, ai, scale, topFreq);
         
         // prepare for next table
         topFreq *= 2;
@@ -127,9 +148,17 @@ void WaveTableOsc::fillTables(WaveTableOsc *osc, double *freqWaveRe, double *fre
     delete [] ai;
 }
 //
-// example that creates and oscillator from an arbitrary time domain wave
+// creates an oscillator from an arbitrary time domain wave, sharing its tables through the cache
 //
 WaveTableOsc * WaveTableOsc::waveOsc(double *waveSamples, int tableLen)
+{
+    WaveTableOsc *osc = new WaveTableOsc();
+    osc->setWaveTables(WaveTableCache::getInstance().getTables(waveSamples, tableLen));
+    
+    return osc;
+}
+
+void WaveTableOsc::buildFromWave(WaveTableSet& tables, const double *waveSamples, int tableLen)
 {
     int idx;
     double *freqWaveRe = new double [tableLen];
@@ -143,15 +172,12 @@ WaveTableOsc * WaveTableOsc::waveOsc(double *waveSamples, int tableLen)
     }
     fft(tableLen, freqWaveRe, freqWaveIm);
     
-    // build a wavetable oscillator
-    WaveTableOsc *osc = new WaveTableOsc();
-    fillTables(osc, freqWaveRe, freqWaveIm, tableLen);
+    // build the wavetables
+    fillTables(tables, freqWaveRe, freqWaveIm, tableLen);
     
     // Fixed memory leak - cleanup allocated arrays
     delete [] freqWaveRe;
     delete [] freqWaveIm;
-    
-    return osc;
 }
 
 void WaveTableOsc::fft(int N, myFloat *ar, myFloat *ai)
@@ -348,10 +374,13 @@ void WaveTableOsc::defineSquare(int len, int numHarmonics, myFloat *ar, myFloat
 //}
 
 
-void WaveTableOsc::setSawtoothOsc(float baseFreq)
+//
+// shared by the band-limited builders: one table per octave from baseFreq up, each with the
+// harmonics that fit below the point where they would alias into the next octave's table
+//
+static void buildBandLimited(WaveTableSet& tables, float baseFreq, float sample_Rate,
+                             void (*defineWave)(int, int, myFloat*, myFloat*))
 {
-    float sample_Rate = getSampleRate();
-    
     // calc number of harmonics where the highest harmonic baseFreq and lowest alias an octave higher would meet
     int maxHarms = sample_Rate / (3.0 * baseFreq) + 0.5;
     
@@ -376,9 +405,9 @@ void WaveTableOsc::setSawtoothOsc(float baseFreq)
     
     for (; maxHarms >= 1; maxHarms >>= 1)
     {
-        defineSawtooth(tableLen, maxHarms, ar, ai);
+        defineWave(tableLen, maxHarms, ar, ai);
         
-        scale = makeWaveTable(this, tableLen, ar, ai, scale, topFreq);
+        scale = WaveTableOsc::makeWaveTable(tables, tableLen, ar, ai, scale, topFreq);
         
         topFreq *= 2;
         if (tableLen > constantRatioLimit) // variable table size (constant oversampling but with minimum table size)
@@ -389,45 +418,24 @@ void WaveTableOsc::setSawtoothOsc(float baseFreq)
     delete [] ai;
 }
 
-void WaveTableOsc::setSquareOsc(float baseFreq)
+void WaveTableOsc::buildSawtooth(WaveTableSet& tables, float baseFreq, float sampleRate)
 {
-    float sample_Rate = getSampleRate();
-    
-    // calc number of harmonics where the highest harmonic baseFreq and lowest alias an octave higher would meet
-    int maxHarms = sample_Rate / (3.0 * baseFreq) + 0.5;
-    
-    // round up to nearest power of two
-    unsigned int v = maxHarms;
-    v--;            // so we don't go up if already a power of 2
-    v |= v >> 1;    // roll the highest bit into all lower bits...
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
-    v++;            // and increment to power of 2
-    int tableLen = v * 2 * overSamp;  // double for the sample rate, then oversampling
-    
-        //myFloat ar[tableLen], ai[tableLen];   // for ifft
+    buildBandLimited(tables, baseFreq, sampleRate, &WaveTableOsc::defineSawtooth);
+}
 
-    double *ar = new double[tableLen];
-    double *ai = new double[tableLen];
-    
-    double topFreq = baseFreq * 2.0 / sample_Rate;
-    myFloat scale = 0.0;
-    
-    for (; maxHarms >= 1; maxHarms >>= 1)
-    {
-        defineSquare(tableLen, maxHarms, ar, ai);
-        
-        scale = makeWaveTable(this, tableLen, ar, ai, scale, topFreq);
-        
-        topFreq *= 2;
-        if (tableLen > constantRatioLimit) // variable table size (constant oversampling but with minimum table size)
-            tableLen >>= 1;
-    }
-    
-    delete [] ar;
-    delete [] ai;
+void WaveTableOsc::buildSquare(WaveTableSet& tables, float baseFreq, float sampleRate)
+{
+    buildBandLimited(tables, baseFreq, sampleRate, &WaveTableOsc::defineSquare);
+}
+
+void WaveTableOsc::setSawtoothOsc(float baseFreq)
+{
+    setWaveTables(WaveTableCache::getInstance().getBandLimitedTables(WaveTableCache::bandLimitedSawtooth, baseFreq, getSampleRate()));
+}
+
+void WaveTableOsc::setSquareOsc(float baseFreq)
+{
+    setWaveTables(WaveTableCache::getInstance().getBandLimitedTables(WaveTableCache::bandLimitedSquare, baseFreq, getSampleRate()));
 }
 
 
@@ -469,11 +477,11 @@ void WaveTableOsc::processBuffer2(float * buffer, int numSamples, bool shouldPro
 //
 // add wavetables in order of lowest frequency to highest
 // topFreq is the highest frequency supported by a wavetable
-// wavetables within an oscillator can be different lengths
+// wavetables within a set can be different lengths
 //
 // returns 0 upon success, or the number of wavetables if no more room is available
 //
-int WaveTableOsc::addWaveTable(int len, float *waveTableIn, double topFreq)
+int WaveTableSet::addWaveTable(int len, float *waveTableIn, double topFreq)
 {
     if (this->numWaveTables < numWaveTableSlots)
     {
@@ -499,15 +507,21 @@ int WaveTableOsc::addWaveTable(int len, float *waveTableIn, double topFreq)
 //
 float WaveTableOsc::getOutput()
 {
+    // nothing to play until tables have been assigned
+    const WaveTableSet* current = liveTables.load(std::memory_order_acquire);
+    
+    if (current == nullptr || current->numWaveTables == 0)
+        return 0.f;
+    
     // grab the appropriate wavetable
     int waveTableIdx = 0;
     
-    while ((this->phaseInc >= this->waveTables[waveTableIdx].topFreq) && (waveTableIdx < (this->numWaveTables - 1)))
+    while ((this->phaseInc >= current->waveTables[waveTableIdx].topFreq) && (waveTableIdx < (current->numWaveTables - 1)))
     {
         ++waveTableIdx;
     }
     
-    waveTable *waveTable = &this->waveTables[waveTableIdx];
+    const waveTable *waveTable = &current->waveTables[waveTableIdx];
     
 #if !doLinearInterp
     
@@ -559,14 +573,19 @@ float WaveTableOsc::getOutput()
 //
 float WaveTableOsc::getOutputMinusOffset()
 {
+    const WaveTableSet* current = liveTables.load(std::memory_order_acquire);
+    
+    if (current == nullptr || current->numWaveTables == 0)
+        return 0.f;
+    
     // grab the appropriate wavetable
     int waveTableIdx = 0;
     
-    while ((this->phaseInc >= this->waveTables[waveTableIdx].topFreq) && (waveTableIdx < (this->numWaveTables - 1))) {
+    while ((this->phaseInc >= current->waveTables[waveTableIdx].topFreq) && (waveTableIdx < (current->numWaveTables - 1))) {
         ++waveTableIdx;
     }
     
-    waveTable *waveTable = &this->waveTables[waveTableIdx];
+    const waveTable *waveTable = &current->waveTables[waveTableIdx];
     
 #if !doLinearInterp
     // truncate
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <iostream>
+#include <atomic>
 #include <math.h>
 #include "JuceHeader.h"
 
@@ -37,6 +38,33 @@ typedef struct
 
 const int numWaveTableSlots = 32;
 
+//
+// WaveTableSet
+//
+// One band-limited set of wavetables, one per octave, lowest frequency first.
+// A set is filled once when it is built and never modified afterwards, so any
+// number of oscillators can play from it at the same time. Sets are shared
+// through WaveTableCache rather than built per oscillator.
+//
+class WaveTableSet : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<WaveTableSet>;
+
+    WaveTableSet();
+    ~WaveTableSet();
+
+    int addWaveTable(int len, float *waveTableIn, double topFreq);
+
+    size_t getSizeInBytes() const;
+
+    int numWaveTables;
+    waveTable waveTables[numWaveTableSlots];
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (WaveTableSet)
+};
+
 class WaveTableOsc
 {
 public:
@@ -72,16 +100,24 @@ public:
     }
     
     
+    // tables are shared, so this only drops this oscillator's reference
     void deleteCurrentTable()
     {
-        for (int idx = 0; idx < numWaveTableSlots; idx++)
-        {
-            float *temp = waveTables[idx].waveTable;
-            if (temp != 0) temp = 0;
-//            if (temp != 0) delete [] temp;
-        }
+        liveTables.store(nullptr);
+        tables = nullptr;
     }
     
+    // O(1): the oscillator only points at a set owned by WaveTableCache.
+    // Not for the audio thread. The audio thread may still be reading the previous set
+    // until its current block ends, so whoever swaps tables on a playing oscillator must
+    // keep the old set alive until then (see WaveTableSwap).
+    void setWaveTables(WaveTableSet::Ptr newTables)
+    {
+        liveTables.store(newTables.get());
+        tables = newTables;
+    }
+    WaveTableSet::Ptr getWaveTables() const { return tables; }
+    
     void renderCustomWave(float * waveBuffer)
     {
         // receives new wave buffer, reprocesses custom
@@ -98,16 +134,18 @@ public:
     // 6. create new custom waveform from view, with interpolation
     // 7. load table from file
     // 8. save table to file
-    int addWaveTable(int len, float *waveTableIn, double topFreq);
-    
-    static void fillTables(WaveTableOsc *osc, double *freqWaveRe, double *freqWaveIm, int numSamples);
+    static void fillTables(WaveTableSet& tables, double *freqWaveRe, double *freqWaveIm, int numSamples);
     static void fft(int N, myFloat *ar, myFloat *ai);
     static WaveTableOsc *waveOsc(double *waveSamples, int tableLen);
-    static float makeWaveTable(WaveTableOsc *osc, int len, myFloat *ar, myFloat *ai, myFloat scale, double topFreq);
+    static float makeWaveTable(WaveTableSet& tables, int len, myFloat *ar, myFloat *ai, myFloat scale, double topFreq);
     
+    // builders used by WaveTableCache when a set is not cached yet
+    static void buildFromWave(WaveTableSet& tables, const double *waveSamples, int tableLen);
+    static void buildSawtooth(WaveTableSet& tables, float baseFreq, float sampleRate);
+    static void buildSquare(WaveTableSet& tables, float baseFreq, float sampleRate);
     
-    void defineSawtooth(int len, int numHarmonics, myFloat *ar, myFloat *ai);
-    void defineSquare(int len, int numHarmonics, myFloat *ar, myFloat *ai);
+    static void defineSawtooth(int len, int numHarmonics, myFloat *ar, myFloat *ai);
+    static void defineSquare(int len, int numHarmonics, myFloat *ar, myFloat *ai);
 
     
     void setSawtoothOsc(float baseFreq);
@@ -122,9 +160,9 @@ protected:
     double phaseOfs;    // phase offset for PWM
     double phaseParam; // our phase parameter
     
-    // list of wavetables
-    int numWaveTables;
-    waveTable waveTables[numWaveTableSlots];
+    // shared, immutable list of wavetables
+    WaveTableSet::Ptr tables;                               // keeps the set alive, never touched by the audio thread
+    std::atomic<const WaveTableSet*> liveTables { nullptr }; // what getOutput() plays
     
     float * customWaveTable; // synchronises with gui object,
     
@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    WaveTableSwap.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "WaveTableOsc.h"
+#include "WaveTableCache.h"
+
+// Background thread shared by every WaveTableSwap, alive while any synth exists
+class WaveTableBuilderThread : public TimeSliceThread
+{
+public:
+    WaveTableBuilderThread() : TimeSliceThread ("Wavetable Builder")
+    {
+        startThread (Thread::Priority::background);
+    }
+
+    ~WaveTableBuilderThread() override
+    {
+        stopThread (1000);
+    }
+};
+
+// Hands new wavetables to the voices of one synth while it is playing, RCU style.
+//
+// requestTables() only copies the wave and returns; the band-limiting FFT passes run on
+// the builder thread, and requests that arrive while one is being built are coalesced so
+// only the latest wave gets built. The finished set is published to every oscillator with
+// a single pointer store each, so the audio thread never waits and never sees a half
+// built table. The set it replaces is kept here until the synth has finished rendering a
+// block that started after the swap, then released on the builder thread.
+class WaveTableSwap : private TimeSliceClient
+{
+public:
+    static constexpr int tableLength = 2048;
+
+    WaveTableSwap()
+    {
+        builderThread->addTimeSliceClient (this);
+    }
+
+    ~WaveTableSwap() override
+    {
+        builderThread->removeTimeSliceClient (this);
+    }
+
+    // Message thread, while setting up the synth's voices
+    void addOscillator (WaveTableOsc* oscillator)
+    {
+        const ScopedLock sl (pendingLock);
+        oscillators.add (oscillator);
+    }
+
+    // Any thread but the audio thread. Copies tableLength samples and returns at once.
+    void requestTables (const double* waveSamples)
+    {
+        {
+            const ScopedLock sl (pendingLock);
+
+            std::copy (waveSamples, waveSamples + tableLength, pendingTable);
+            hasPendingTable = true;
+            numRequested.fetch_add (1);
+        }
+
+        builderThread->moveToFrontOfQueue (this);
+    }
+
+    // Any thread. True once the tables of the latest request have reached the oscillators;
+    // until then they play the previous set, or silence if there was none
+    bool isUpToDate() const noexcept
+    {
+        return numPublished.load() == numRequested.load();
+    }
+
+    // Any thread but the audio thread, for rendering that has to match a live run from its
+    // first sample. False if the tables still weren't there after timeoutMs
+    bool waitUntilUpToDate (int timeoutMs) const
+    {
+        const uint32 startTime = Time::getMillisecondCounter();
+
+        while (! isUpToDate())
+        {
+            if (Time::getMillisecondCounter() - startTime >= (uint32) timeoutMs)
+                return false;
+
+            Thread::sleep (1);
+        }
+
+        return true;
+    }
+
+    // Audio thread, after each render of the synth's voices
+    void audioBlockRendered() noexcept
+    {
+        blocksRendered.fetch_add (1);
+    }
+
+private:
+    static constexpr int idleIntervalMs    = 100;
+    static constexpr int retiredIntervalMs = 10;
+
+    struct RetiredTables
+    {
+        WaveTableSet::Ptr tables;
+        uint32 blocksRenderedAtSwap;
+    };
+
+    // Builder thread
+    int useTimeSlice() override
+    {
+        bool shouldBuild = false;
+        uint32 request = 0;
+
+        {
+            const ScopedLock sl (pendingLock);
+
+            if (hasPendingTable)
+            {
+                std::copy (pendingTable, pendingTable + tableLength, buildTable);
+                hasPendingTable = false;
+                shouldBuild = true;
+                request = numRequested.load();
+            }
+        }
+
+        if (shouldBuild)
+        {
+            publish (WaveTableCache::getInstance().getTables (buildTable, tableLength));
+            numPublished.store (request);
+        }
+
+        releaseRetiredTables();
+
+        return retired.empty() ? idleIntervalMs : retiredIntervalMs;
+    }
+
+    void publish (WaveTableSet::Ptr newTables)
+    {
+        if (newTables == currentTables)
+            return;
+
+        // keep our reference to the outgoing set, the oscillators are about to drop theirs
+        auto outgoing = currentTables;
+        currentTables = newTables;
+
+        {
+            const ScopedLock sl (pendingLock);
+
+            for (auto* oscillator : oscillators)
+                oscillator->setWaveTables (currentTables);
+        }
+
+        // Read after the stores above (both seq_cst): a render that could still see the
+        // outgoing set was already running, and it counts as rendered when it finishes.
+        if (outgoing != nullptr)
+            retired.push_back ({ outgoing, blocksRendered.load() });
+    }
+
+    void releaseRetiredTables()
+    {
+        const uint32 rendered = blocksRendered.load();
+
+        retired.erase (std::remove_if (retired.begin(), retired.end(),
+                                       [rendered] (const RetiredTables& r)
+                                       {
+                                           return (int32) (rendered - r.blocksRenderedAtSwap) > 0;
+                                       }),
+                       retired.end());
+    }
+
+    SharedResourcePointer<WaveTableBuilderThread> builderThread;
+
+    // guards the pending table and the oscillator list, never taken by the audio thread
+    CriticalSection pendingLock;
+    double pendingTable[tableLength];
+    bool hasPendingTable = false;
+    Array<WaveTableOsc*> oscillators;
+
+    // builder thread only
+    double buildTable[tableLength];
+    WaveTableSet::Ptr currentTables;
+    std::vector<RetiredTables> retired;
+
+    std::atomic<uint32> blocksRendered { 0 };
+
+    // requests made, and the last one whose tables were published
+    std::atomic<uint32> numRequested { 0 };
+    std::atomic<uint32> numPublished { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveTableSwap)
+};
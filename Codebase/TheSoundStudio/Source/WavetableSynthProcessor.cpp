@@ -36,7 +36,11 @@ WavetableSynthVoice::WavetableSynthVoice(double newSampleRate, FrequencyManager
     instrumentType = PIANO;
 }
 
-WavetableSynthVoice::~WavetableSynthVoice()  { }
+WavetableSynthVoice::~WavetableSynthVoice()
+{
+    // the voice keeps one oscillator for its lifetime, only the tables it points at change
+    delete oscillator;
+}
 
 void WavetableSynthVoice::setCurrentPlaybackSampleRate (double newRate)
 {
@@ -51,6 +55,9 @@ void WavetableSynthVoice::setCurrentPlaybackSampleRate (double newRate)
         oscillator->setSampleRate(newSampleRate);
         env[i]->setNewSamplerate(newSampleRate);
     }
+    
+    // partial increments depend on the sample rate
+    partialsInstrument = -1;
 }
 
 bool WavetableSynthVoice::canPlaySound (SynthesiserSound* sound)
@@ -67,9 +74,10 @@ void WavetableSynthVoice::startNote (int midiNoteNumber, float velocity, Synthes
 //        oscillator->triggerNote();
 //    }
     
-    // reset per-voice synthesis state
-    phase = 0.0f;
-    harpDecay = 1.0f;
+    // reset per-voice synthesis state, the frequency has already been set by the synth
+    partialsInstrument = -1;
+    updatePartials();
+    partials.reset();
     for (int i = 0; i < 1; i++) env[i]->gate(1);
 }
 
@@ -83,7 +91,7 @@ void WavetableSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -97,8 +105,8 @@ void WavetableSynthVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -137,6 +145,9 @@ void WavetableSynthVoice::ProcessBuffer(float *bufferLeft, float * bufferRight,
 
 void WavetableSynthVoice::process_oscs(float *bufferLeft, float * bufferRight, int buffersize)
 {
+    // picks up instrument changes and retunes while the note is sounding
+    updatePartials();
+    
     // Use instrument-specific synthesis based on selected instrument
     switch (instrumentType)
     {
@@ -247,7 +258,7 @@ void WavetableSynthVoice::setParameter(int index, var newValue)
 
 WavetableSynthProcessor::WavetableSynthProcessor(float hwsamplerate, FrequencyManager * fm)
 {
-    internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+    internal_sample_rate    = hwsamplerate;
     frequencyManager        = fm;
     
     clearVoices();
@@ -257,6 +268,7 @@ WavetableSynthProcessor::WavetableSynthProcessor(float hwsamplerate, FrequencyMa
         cVoices[i] = new WavetableSynthVoice(internal_sample_rate, frequencyManager);
         cVoices[i]->setVoiceRef(i);
         this->addVoice(cVoices[i]);
+        tableSwap.addOscillator(cVoices[i]->oscillator);
     }
     
     clearSounds();
@@ -271,17 +283,35 @@ WavetableSynthProcessor::~WavetableSynthProcessor() { }
 
 void WavetableSynthProcessor::prepareToPlay(float hwSampleRate, int blockSize)
 {
-    internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+    internal_sample_rate = hwSampleRate * oversamplingFactor;
     
     setCurrentPlaybackSampleRate(internal_sample_rate);
 }
 
+void WavetableSynthProcessor::setOversamplingFactor(int newFactor)
+{
+    oversamplingFactor = newFactor;
+    
+    for (int i = 0; i < MAX_NUM_VOICES; i++)
+    {
+        cVoices[i]->set_oversample_factor(newFactor);
+    }
+}
+
 void WavetableSynthProcessor::processBlock(AudioBuffer<float>& buffer,
                   MidiBuffer& midiMessages)
 {
     renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
 
+void WavetableSynthProcessor::renderVoices(AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+    
+    // lets tableSwap release tables this block may have been reading
+    tableSwap.audioBlockRendered();
+}
+
 void WavetableSynthProcessor::setParameter(int index, var newValue)
 {
     for (int i = 0; i < MAX_NUM_VOICES; i++) {
@@ -291,16 +321,16 @@ void WavetableSynthProcessor::setParameter(int index, var newValue)
 
 void WavetableSynthProcessor::initBaseWaveType(int type) // 0= tr
 {
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(getWavetableBuffer(type, 2048), 2048);
-    }
+    // built on the wavetable builder thread, every voice then plays the same shared tables
+    tableSwap.requestTables(getWavetableBuffer(type, WaveTableSwap::tableLength));
 }
 
 
 double * WavetableSynthProcessor::getWavetableBuffer(int type, int length)
 {
-    double * buffer = new double[length];
+    jassert(length <= WaveTableSwap::tableLength);
+    
+    double * buffer = baseWavetable;
     
     if (type == 0)
     {
@@ -355,8 +385,6 @@ double * WavetableSynthProcessor::getWavetableBuffer(int type, int length)
         }
     }
     
-    baseWavetable = buffer;
-    
     return buffer;
 }
 
@@ -367,12 +395,11 @@ double * WavetableSynthProcessor::getBaseWavetableBuffer()
 
 void WavetableSynthProcessor::setWavetableBuffer(double * table)
 {
-    baseWavetable = table;
+    // keep our own copy, the editor's buffer may not outlive this call
+    if (table != baseWavetable)
+        std::copy(table, table + WaveTableSwap::tableLength, baseWavetable);
     
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(baseWavetable, 2048);
-    }
+    tableSwap.requestTables(baseWavetable);
 }
 
 
@@ -424,7 +451,10 @@ FrequencyPlayerWavetableSynthVoice::FrequencyPlayerWavetableSynthVoice(double ne
     env[0]->reset();
 }
 
-FrequencyPlayerWavetableSynthVoice::~FrequencyPlayerWavetableSynthVoice()  { }
+FrequencyPlayerWavetableSynthVoice::~FrequencyPlayerWavetableSynthVoice()
+{
+    delete oscillator;
+}
 
 void FrequencyPlayerWavetableSynthVoice::setCurrentPlaybackSampleRate (double newRate)
 {
@@ -488,7 +518,7 @@ void FrequencyPlayerWavetableSynthVoice::renderNextBlock (AudioBuffer<float>& ou
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -502,8 +532,8 @@ void FrequencyPlayerWavetableSynthVoice::renderNextBlock (AudioBuffer<float>& ou
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -762,7 +792,7 @@ void FrequencyPlayerWavetableSynthVoice::calcManipulateFrequencies()
 
 FrequencyPlayerWavetableSynthProcessor::FrequencyPlayerWavetableSynthProcessor(float hwsamplerate, FrequencyManager * fm)
 {
-    internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+    internal_sample_rate    = hwsamplerate;
     frequencyManager        = fm;
     
     clearVoices();
@@ -772,6 +802,7 @@ FrequencyPlayerWavetableSynthProcessor::FrequencyPlayerWavetableSynthProcessor(f
         cVoices[i] = new FrequencyPlayerWavetableSynthVoice(internal_sample_rate, frequencyManager);
         cVoices[i]->setVoiceRef(i);
         this->addVoice(cVoices[i]);
+        tableSwap.addOscillator(cVoices[i]->oscillator);
     }
     
     clearSounds();
@@ -786,17 +817,34 @@ FrequencyPlayerWavetableSynthProcessor::~FrequencyPlayerWavetableSynthProcessor(
 
 void FrequencyPlayerWavetableSynthProcessor::prepareToPlay(float hwSampleRate, int blockSize)
 {
-    internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+    internal_sample_rate = hwSampleRate * oversamplingFactor;
     
     setCurrentPlaybackSampleRate(internal_sample_rate);
 }
 
+void FrequencyPlayerWavetableSynthProcessor::setOversamplingFactor(int newFactor)
+{
+    oversamplingFactor = newFactor;
+    
+    for (int i = 0; i < MAX_NUM_VOICES; i++)
+    {
+        cVoices[i]->set_oversample_factor(newFactor);
+    }
+}
+
 void FrequencyPlayerWavetableSynthProcessor::processBlock(AudioBuffer<float>& buffer,
                   MidiBuffer& midiMessages)
 {
     renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
 
+void FrequencyPlayerWavetableSynthProcessor::renderVoices(AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+    
+    tableSwap.audioBlockRendered();
+}
+
 void FrequencyPlayerWavetableSynthProcessor::setParameter(int index, var newValue)
 {
     for (int i = 0; i < MAX_NUM_VOICES; i++) {
@@ -806,16 +854,15 @@ void FrequencyPlayerWavetableSynthProcessor::setParameter(int index, var newValu
 
 void FrequencyPlayerWavetableSynthProcessor::initBaseWaveType(int type) // 0= tr
 {
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(getWavetableBuffer(type, 2048), 2048);
-    }
+    tableSwap.requestTables(getWavetableBuffer(type, WaveTableSwap::tableLength));
 }
 
 
 double * FrequencyPlayerWavetableSynthProcessor::getWavetableBuffer(int type, int length)
 {
-    double * buffer = new double[length];
+    jassert(length <= WaveTableSwap::tableLength);
+    
+    double * buffer = baseWavetable;
     
     if (type == 0)
     {
@@ -870,8 +917,6 @@ double * FrequencyPlayerWavetableSynthProcessor::getWavetableBuffer(int type, in
         }
     }
     
-    baseWavetable = buffer;
-    
     return buffer;
 }
 
@@ -882,12 +927,10 @@ double * FrequencyPlayerWavetableSynthProcessor::getBaseWavetableBuffer()
 
 void FrequencyPlayerWavetableSynthProcessor::setWavetableBuffer(double * table)
 {
-    baseWavetable = table;
+    if (table != baseWavetable)
+        std::copy(table, table + WaveTableSwap::tableLength, baseWavetable);
     
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(baseWavetable, 2048);
-    }
+    tableSwap.requestTables(baseWavetable);
 }
 
 
@@ -906,7 +949,10 @@ FrequencyScannerWavetableSynthVoice::FrequencyScannerWavetableSynthVoice(double
     env[0]->reset();
 }
 
-FrequencyScannerWavetableSynthVoice::~FrequencyScannerWavetableSynthVoice()  { }
+FrequencyScannerWavetableSynthVoice::~FrequencyScannerWavetableSynthVoice()
+{
+    delete oscillator;
+}
 
 void FrequencyScannerWavetableSynthVoice::setCurrentPlaybackSampleRate (double newRate)
 {
@@ -950,7 +996,7 @@ void FrequencyScannerWavetableSynthVoice::renderNextBlock (AudioBuffer<float>& o
 {
     if (outputBuffer.getNumChannels() == 1)
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -964,8 +1010,8 @@ void FrequencyScannerWavetableSynthVoice::renderNextBlock (AudioBuffer<float>& o
     }
     else
     {
-        float * buf_left = outputBuffer.getWritePointer(0);
-        float * buf_right = outputBuffer.getWritePointer(1);
+        float * buf_left = outputBuffer.getWritePointer(0, startSample);
+        float * buf_right = outputBuffer.getWritePointer(1, startSample);
         
         float voiceBufferLeft[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferLeft[i] = 0.f;
         float voiceBufferRight[numSamples]; for (int i = 0; i < numSamples; i++) voiceBufferRight[i] = 0.f;
@@ -1086,7 +1132,7 @@ void FrequencyScannerWavetableSynthVoice::setParameter(int index, var newValue)
 
 FrequencyScannerWavetableSynthProcessor::FrequencyScannerWavetableSynthProcessor(float hwsamplerate, FrequencyManager * fm)
 {
-    internal_sample_rate    = hwsamplerate * OVERSAMPLE_FACTOR;
+    internal_sample_rate    = hwsamplerate;
     frequencyManager        = fm;
     
     clearVoices();
@@ -1096,6 +1142,7 @@ FrequencyScannerWavetableSynthProcessor::FrequencyScannerWavetableSynthProcessor
         cVoices[i] = new FrequencyScannerWavetableSynthVoice(internal_sample_rate, frequencyManager);
         cVoices[i]->setVoiceRef(i);
         this->addVoice(cVoices[i]);
+        tableSwap.addOscillator(cVoices[i]->oscillator);
     }
     
     clearSounds();
@@ -1110,17 +1157,34 @@ FrequencyScannerWavetableSynthProcessor::~FrequencyScannerWavetableSynthProcesso
 
 void FrequencyScannerWavetableSynthProcessor::prepareToPlay(float hwSampleRate, int blockSize)
 {
-    internal_sample_rate = hwSampleRate * OVERSAMPLE_FACTOR;
+    internal_sample_rate = hwSampleRate * oversamplingFactor;
     
     setCurrentPlaybackSampleRate(internal_sample_rate);
 }
 
+void FrequencyScannerWavetableSynthProcessor::setOversamplingFactor(int newFactor)
+{
+    oversamplingFactor = newFactor;
+    
+    for (int i = 0; i < MAX_NUM_VOICES; i++)
+    {
+        cVoices[i]->set_oversample_factor(newFactor);
+    }
+}
+
 void FrequencyScannerWavetableSynthProcessor::processBlock(AudioBuffer<float>& buffer,
                   MidiBuffer& midiMessages)
 {
     renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
 
+void FrequencyScannerWavetableSynthProcessor::renderVoices(AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+    
+    tableSwap.audioBlockRendered();
+}
+
 void FrequencyScannerWavetableSynthProcessor::setParameter(int index, var newValue)
 {
     for (int i = 0; i < MAX_NUM_VOICES; i++) {
@@ -1130,16 +1194,15 @@ void FrequencyScannerWavetableSynthProcessor::setParameter(int index, var newVal
 
 void FrequencyScannerWavetableSynthProcessor::initBaseWaveType(int type) // 0= tr
 {
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(getWavetableBuffer(type, 2048), 2048);
-    }
+    tableSwap.requestTables(getWavetableBuffer(type, WaveTableSwap::tableLength));
 }
 
 
 double * FrequencyScannerWavetableSynthProcessor::getWavetableBuffer(int type, int length)
 {
-    double * buffer = new double[length];
+    jassert(length <= WaveTableSwap::tableLength);
+    
+    double * buffer = baseWavetable;
     
     if (type == 0)
     {
@@ -1194,8 +1257,6 @@ double * FrequencyScannerWavetableSynthProcessor::getWavetableBuffer(int type, i
         }
     }
     
-    baseWavetable = buffer;
-    
     return buffer;
 }
 
@@ -1206,12 +1267,10 @@ double * FrequencyScannerWavetableSynthProcessor::getBaseWavetableBuffer()
 
 void FrequencyScannerWavetableSynthProcessor::setWavetableBuffer(double * table)
 {
-    baseWavetable = table;
+    if (table != baseWavetable)
+        std::copy(table, table + WaveTableSwap::tableLength, baseWavetable);
     
-    for (int i =0 ; i < MAX_NUM_VOICES; i++)
-    {
-        cVoices[i]->oscillator = WaveTableOsc::waveOsc(baseWavetable, 2048);
-    }
+    tableSwap.requestTables(baseWavetable);
 }
 
 
@@ -1243,152 +1302,152 @@ void FrequencyScannerWavetableSynthProcessor::noteOn (const int midiChannel, con
 // Instrument-specific synthesis methods for WavetableSynthVoice
 // =================================================================================
 
-void WavetableSynthVoice::synthesizePiano(float* bufferLeft, float* bufferRight, int numSamples)
+void WavetableSynthVoice::updatePartials()
 {
-    // Physically-inspired modal synthesis with mild inharmonicity
-    const float twoPi = 2.0f * juce::MathConstants<float>::pi;
-    const float phaseIncrement = currentFrequency * twoPi / (float)sample_rate;
-    // Railsback-like inharmonicity coefficient (frequency dependent)
-    const float B = 0.0001f * std::pow(std::max(1.0f, currentFrequency / 261.63f), 1.8f);
-    
-    for (int i = 0; i < numSamples; ++i)
+    if (partialsInstrument == instrumentType && partialsFrequency == currentFrequency)
+        return;
+
+    partials.clear();
+
+    switch (instrumentType)
     {
-        float sample = 0.0f;
-        
-        // Fundamental
-        sample += 0.9f * std::sin(phase);
-        
-        // Inharmonic partials (2..10)
-        for (int h = 2; h <= 10; ++h)
+        case PIANO:
+        {
+            // Physically-inspired modal synthesis with mild inharmonicity
+            // Railsback-like inharmonicity coefficient (frequency dependent)
+            const float B = 0.0001f * std::pow(std::max(1.0f, currentFrequency / 261.63f), 1.8f);
+
+            // Fundamental
+            partials.addPartial(1.0f, 0.9f);
+
+            // Inharmonic partials (2..10), with the slow per-partial shimmer folded into
+            // its average level over a cycle
+            for (int h = 2; h <= 10; ++h)
+            {
+                const float ratio = h * std::sqrt(1.0f + B * h * h);
+                const float shimmerRange = 0.02f * juce::MathConstants<float>::pi * h;
+                const float shimmer = (1.0f - std::cos(shimmerRange)) / shimmerRange;
+                partials.addPartial(ratio, (1.0f / (float)h) * (0.85f + 0.15f * shimmer));
+            }
+
+            // Duplex scaling and sympathetic resonances (subtle)
+            partials.addPartial(0.618f, 0.06f);
+            partials.addPartial(2.0f,   0.03f);
+            partials.addPartial(1.5f,   0.02f);
+        }
+            break;
+        case FLUTE:
+            // Flute: strong fundamental, weak overtones
+            partials.addPartial(1.0f, 0.9f);
+            partials.addPartial(2.0f, 0.12f);
+            partials.addPartial(3.0f, 0.05f);
+            break;
+        case GUITAR:
         {
-            const float ratio = h * std::sqrt(1.0f + B * h * h);
-            const float amp = (1.0f / (float)h) * (0.85f + 0.15f * std::sin(0.01f * phase * h));
-            sample += amp * std::sin(phase * ratio);
+            // Plucked string timbre via rich harmonics
+            const float levels[] = { 0.65f, 0.35f, 0.20f, 0.12f, 0.08f };
+            for (int h = 0; h < 5; ++h) partials.addPartial((float)(h + 1), levels[h]);
         }
-        
-        // Duplex scaling and sympathetic resonances (subtle)
-        const float duplex = 0.06f * std::sin(phase * 0.618f);
-        const float octave = 0.03f * std::sin(phase * 2.0f);
-        const float fifth  = 0.02f * std::sin(phase * 1.5f);
-        sample += duplex + octave + fifth;
-        
-        // Simple tone shaping
-        const float brightness = juce::jlimit(0.2f, 0.9f, amplitude * 0.8f + 0.2f);
-        sample = std::tanh(sample * (1.5f + 2.0f * brightness));
-        
-        // Level
-        const float out = sample * amplitude * osc_volume[0] * 0.25f;
+            break;
+        case STRINGS:
+        {
+            // Rich bowed-string-like harmonic stack
+            const float levels[] = { 0.55f, 0.40f, 0.30f, 0.22f, 0.16f, 0.12f, 0.09f, 0.07f };
+            for (int h = 0; h < 8; ++h) partials.addPartial((float)(h + 1), levels[h]);
+        }
+            break;
+        case HARP:
+        {
+            // Plucked harp-like tone, every partial decaying exponentially
+            const float harpDecay = 0.9996f;
+            partials.addPartial(1.0f, 0.80f, harpDecay);
+            partials.addPartial(2.0f, 0.35f, harpDecay);
+            partials.addPartial(3.0f, 0.18f, harpDecay);
+            partials.addPartial(4.0f, 0.10f, harpDecay);
+            // Slight metallic overtones
+            partials.addPartial(2.4f, 0.08f, harpDecay);
+            partials.addPartial(3.2f, 0.04f, harpDecay);
+        }
+            break;
+        default: break;
+    }
+
+    partials.prepare(currentFrequency, sample_rate);
+
+    partialsInstrument = instrumentType;
+    partialsFrequency  = currentFrequency;
+}
+
+// Rational tanh approximation, within 0.024 of tanh over +-3. It reaches exactly +-1 at
+// +-3 with zero slope (tanh(3) is 0.995), so clamping the input there joins smoothly
+static inline float softSaturate(float x)
+{
+    x = juce::jlimit(-3.0f, 3.0f, x);
+    return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+}
+
+void WavetableSynthVoice::synthesizePiano(float* bufferLeft, float* bufferRight, int numSamples)
+{
+    partials.render(bufferLeft, numSamples);
+
+    // Simple tone shaping
+    const float brightness = juce::jlimit(0.2f, 0.9f, amplitude * 0.8f + 0.2f);
+    const float drive = 1.5f + 2.0f * brightness;
+
+    // Level
+    const float gain = amplitude * osc_volume[0] * 0.25f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float out = softSaturate(bufferLeft[i] * drive) * gain;
         bufferLeft[i]  = out;
         bufferRight[i] = out;
-        
-        // Advance phase
-        phase += phaseIncrement;
-        if (phase >= twoPi) phase -= twoPi;
     }
 }
 
 void WavetableSynthVoice::synthesizeFlute(float* bufferLeft, float* bufferRight, int numSamples)
 {
-    // Flute: strong fundamental, weak overtones, gentle breath noise
-    const float twoPi = 2.0f * juce::MathConstants<float>::pi;
-    const float phaseIncrement = currentFrequency * twoPi / (float)sample_rate;
-    Random rng;
-    
+    partials.render(bufferLeft, numSamples);
+
+    const float gain = amplitude * osc_volume[0] * 0.35f;
+
     for (int i = 0; i < numSamples; ++i)
     {
-        float sample = 0.9f * std::sin(phase)
-                     + 0.12f * std::sin(phase * 2.0f)
-                     + 0.05f * std::sin(phase * 3.0f);
-        const float noise = (rng.nextFloat() * 2.0f - 1.0f) * 0.02f;
-        sample += noise;
-        
-        const float out = sample * amplitude * osc_volume[0] * 0.35f;
-        bufferLeft[i] = out;
+        // gentle breath noise
+        const float noise = (breathNoise.nextFloat() * 2.0f - 1.0f) * 0.02f;
+        const float out = (bufferLeft[i] + noise) * gain;
+        bufferLeft[i]  = out;
         bufferRight[i] = out;
-        
-        phase += phaseIncrement;
-        if (phase >= twoPi) phase -= twoPi;
     }
 }
 
 void WavetableSynthVoice::synthesizeGuitar(float* bufferLeft, float* bufferRight, int numSamples)
 {
-    // Simple plucked string timbre via rich harmonics + soft nonlinearity
-    const float twoPi = 2.0f * juce::MathConstants<float>::pi;
-    const float phaseIncrement = currentFrequency * twoPi / (float)sample_rate;
-    
+    partials.render(bufferLeft, numSamples);
+
+    const float gain = amplitude * osc_volume[0] * 0.3f;
+
     for (int i = 0; i < numSamples; ++i)
     {
-        float sample = 0.0f;
-        sample += 0.65f * std::sin(phase);
-        sample += 0.35f * std::sin(phase * 2.0f);
-        sample += 0.20f * std::sin(phase * 3.0f);
-        sample += 0.12f * std::sin(phase * 4.0f);
-        sample += 0.08f * std::sin(phase * 5.0f);
-        
         // Gentle saturation
-        sample = std::tanh(sample * 1.4f);
-        const float out = sample * amplitude * osc_volume[0] * 0.3f;
+        const float out = softSaturate(bufferLeft[i] * 1.4f) * gain;
         bufferLeft[i]  = out;
         bufferRight[i] = out;
-        
-        phase += phaseIncrement;
-        if (phase >= twoPi) phase -= twoPi;
     }
 }
 
 void WavetableSynthVoice::synthesizeStrings(float* bufferLeft, float* bufferRight, int numSamples)
 {
-    // Rich bowed-string-like harmonic stack
-    const float twoPi = 2.0f * juce::MathConstants<float>::pi;
-    const float phaseIncrement = currentFrequency * twoPi / (float)sample_rate;
-    
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float sample = 0.0f;
-        sample += 0.55f * std::sin(phase);
-        sample += 0.40f * std::sin(phase * 2.0f);
-        sample += 0.30f * std::sin(phase * 3.0f);
-        sample += 0.22f * std::sin(phase * 4.0f);
-        sample += 0.16f * std::sin(phase * 5.0f);
-        sample += 0.12f * std::sin(phase * 6.0f);
-        sample += 0.09f * std::sin(phase * 7.0f);
-        sample += 0.07f * std::sin(phase * 8.0f);
-        
-        const float out = sample * amplitude * osc_volume[0] * 0.25f;
-        bufferLeft[i]  = out;
-        bufferRight[i] = out;
-        
-        phase += phaseIncrement;
-        if (phase >= twoPi) phase -= twoPi;
-    }
+    partials.render(bufferLeft, numSamples);
+
+    FloatVectorOperations::multiply(bufferLeft, amplitude * osc_volume[0] * 0.25f, numSamples);
+    FloatVectorOperations::copy(bufferRight, bufferLeft, numSamples);
 }
 
 void WavetableSynthVoice::synthesizeHarp(float* bufferLeft, float* bufferRight, int numSamples)
 {
-    // Plucked harp-like tone with per-voice decay
-    const float twoPi = 2.0f * juce::MathConstants<float>::pi;
-    const float phaseIncrement = currentFrequency * twoPi / (float)sample_rate;
-    
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float sample = 0.0f;
-        sample += 0.80f * std::sin(phase)       * harpDecay;
-        sample += 0.35f * std::sin(phase * 2.0f) * harpDecay;
-        sample += 0.18f * std::sin(phase * 3.0f) * harpDecay;
-        sample += 0.10f * std::sin(phase * 4.0f) * harpDecay;
-        // Slight metallic overtones
-        sample += 0.08f * std::sin(phase * 2.4f) * harpDecay;
-        sample += 0.04f * std::sin(phase * 3.2f) * harpDecay;
-        
-        const float out = sample * amplitude * osc_volume[0] * 0.35f;
-        bufferLeft[i]  = out;
-        bufferRight[i] = out;
-        
-        phase += phaseIncrement;
-        if (phase >= twoPi) phase -= twoPi;
-        
-        // Exponential decay
-        harpDecay *= 0.9996f;
-    }
+    partials.render(bufferLeft, numSamples);
+
+    FloatVectorOperations::multiply(bufferLeft, amplitude * osc_volume[0] * 0.35f, numSamples);
+    FloatVectorOperations::copy(bufferRight, bufferLeft, numSamples);
 }
@@ -20,6 +20,8 @@
 #include "FrequencyManager.h"
 #include "SynthesisLibraryManager.h"
 #include "WaveStackOsc.h"
+#include "PartialBank.h"
+#include "WaveTableSwap.h"
 
 #define NUMVOICES 8
 
@@ -77,6 +79,10 @@ private:
     void synthesizeStrings(float* bufferLeft, float* bufferRight, int numSamples);
     void synthesizeHarp(float* bufferLeft, float* bufferRight, int numSamples);
     
+    // Loads the partials of the selected instrument model into the bank. Ratios only
+    // depend on the instrument and frequency, so this runs on note on and on retune.
+    void updatePartials();
+    
     FrequencyManager * frequencyManager;
     
     
@@ -117,8 +123,10 @@ private:
     int instrumentType; // Based on INSTRUMENTS enum
 
     // Per-voice synthesis state (avoid static shared state)
-    float phase { 0.0f };
-    float harpDecay { 1.0f };
+    PartialBank partials;
+    int   partialsInstrument { -1 };
+    float partialsFrequency { 0.0f };
+    Random breathNoise;
     
 };
 
@@ -132,6 +140,7 @@ public:
     ~WavetableSynthProcessor();
     
     void prepareToPlay(float hwSampleRate, int blockSize);
+    void setOversamplingFactor(int newFactor);
     
     void processBlock(AudioBuffer<float>& buffer,
                       MidiBuffer& midiMessages);
@@ -146,15 +155,24 @@ public:
     
     void setWavetableBuffer(double * table);
     
+    // blocks until the voices have the tables last asked for, false on timeout
+    bool waitForWaveTables(int timeoutMs) { return tableSwap.waitUntilUpToDate(timeoutMs); }
+    
     void noteOn (const int midiChannel, const int midiNoteNumber, const float frequencyDirect) override;
     
+protected:
+    void renderVoices (AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
 
     WavetableSynthVoice * cVoices[MAX_NUM_VOICES];
     
-    double * baseWavetable;
+    // the wave the editor shows; the voices get it through tableSwap
+    double baseWavetable[WaveTableSwap::tableLength];
+    WaveTableSwap tableSwap;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableSynthProcessor)
 };
@@ -275,6 +293,7 @@ public:
     ~FrequencyPlayerWavetableSynthProcessor();
     
     void prepareToPlay(float hwSampleRate, int blockSize);
+    void setOversamplingFactor(int newFactor);
     void processBlock(AudioBuffer<float>& buffer, MidiBuffer& midiMessages);
     void setParameter(int index, var newValue);
     
@@ -283,16 +302,23 @@ public:
     double * getBaseWavetableBuffer();
     void setWavetableBuffer(double * table);
     
+    bool waitForWaveTables(int timeoutMs) { return tableSwap.waitUntilUpToDate(timeoutMs); }
+    
     double getChosenFrequency()
     {
         return cVoices[0]->getChoseFrequency();
     }
     
+protected:
+    void renderVoices (AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
     FrequencyPlayerWavetableSynthVoice * cVoices[MAX_NUM_VOICES];
-    double * baseWavetable;
+    double baseWavetable[WaveTableSwap::tableLength];
+    WaveTableSwap tableSwap;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrequencyPlayerWavetableSynthProcessor)
 };
@@ -383,6 +409,7 @@ public:
     ~FrequencyScannerWavetableSynthProcessor();
     
     void prepareToPlay(float hwSampleRate, int blockSize);
+    void setOversamplingFactor(int newFactor);
     void processBlock(AudioBuffer<float>& buffer, MidiBuffer& midiMessages);
     void setParameter(int index, var newValue);
     
@@ -391,15 +418,22 @@ public:
     double * getBaseWavetableBuffer();
     void setWavetableBuffer(double * table);
     
+    bool waitForWaveTables(int timeoutMs) { return tableSwap.waitUntilUpToDate(timeoutMs); }
+    
     void noteOn (const int midiChannel, const int midiNoteNumber, const float frequencyDirect) override;
     
+protected:
+    void renderVoices (AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    
 private:
     FrequencyManager * frequencyManager;
     float internal_sample_rate;
+    int   oversamplingFactor = 1;
 
     FrequencyScannerWavetableSynthVoice * cVoices[MAX_NUM_VOICES];
     
-    double * baseWavetable;
+    double baseWavetable[WaveTableSwap::tableLength];
+    WaveTableSwap tableSwap;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrequencyScannerWavetableSynthProcessor)
 };
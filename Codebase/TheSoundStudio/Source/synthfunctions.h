@@ -14,7 +14,7 @@
 #pragma once
 #include "pluginconstants.h"
 #include "time.h"
-#include "lookuptables.h"
+#include "BLEPTables.h"
 #include "vConstants.h"
 #include <cmath>
 
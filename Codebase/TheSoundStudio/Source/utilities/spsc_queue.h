@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    spsc_queue.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace audio_devs
+{
+
+// Wait-free bounded single producer / single consumer queue.
+// Storage is allocated once in the constructor; try_push() and try_pop() never
+// allocate, lock or block, so the producer can be the audio thread. When the
+// queue is full try_push() returns false and the caller decides what to drop.
+template<typename Type>
+class spsc_queue
+{
+public:
+
+    static_assert(std::is_trivially_copyable<Type>::value,
+                  "spsc_queue elements are copied into preallocated slots");
+
+    // capacity is rounded up to a power of two
+    explicit spsc_queue(std::size_t min_capacity)
+        : capacity(round_up_to_power_of_two(min_capacity)),
+          mask(capacity - 1),
+          slots(new Type[capacity])
+    {
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    // Producer
+    bool try_push(const Type& item) noexcept
+    {
+        const auto tail = write_index.load(std::memory_order_relaxed);
+
+        if (tail - read_index.load(std::memory_order_acquire) == capacity)
+            return false;
+
+        slots[tail & mask] = item;
+        write_index.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer
+    bool try_pop(Type& item) noexcept
+    {
+        const auto head = read_index.load(std::memory_order_relaxed);
+
+        if (head == write_index.load(std::memory_order_acquire))
+            return false;
+
+        item = slots[head & mask];
+        read_index.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer: oldest element without removing it, nullptr if empty
+    const Type* peek() const noexcept
+    {
+        const auto head = read_index.load(std::memory_order_relaxed);
+
+        if (head == write_index.load(std::memory_order_acquire))
+            return nullptr;
+
+        return &slots[head & mask];
+    }
+
+    bool empty() const noexcept
+    {
+        return read_index.load(std::memory_order_acquire) == write_index.load(std::memory_order_acquire);
+    }
+
+    std::size_t get_capacity() const noexcept { return capacity; }
+
+private:
+
+    static std::size_t round_up_to_power_of_two(std::size_t value) noexcept
+    {
+        std::size_t result = 1;
+
+        while (result < value)
+            result <<= 1;
+
+        return result;
+    }
+
+    const std::size_t capacity;
+    const std::size_t mask;
+    std::unique_ptr<Type[]> slots;
+
+    // kept on separate cache lines so producer and consumer do not false-share
+    alignas(64) std::atomic<std::size_t> write_index { 0 };
+    alignas(64) std::atomic<std::size_t> read_index { 0 };
+};
+
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    triple_buffer.h
+    The Sound Studio
+    Copyright (c) 2026 Ziv Elovitch. All rights reserved.
+    all right reserves... - Ziv Elovitch
+
+    Licensed under the MIT License. See LICENSE file for details.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace audio_devs
+{
+
+// Wait-free single producer / single consumer triple buffer.
+// The producer fills write_buffer() and calls publish(); the consumer calls
+// acquire() and reads the returned object until its next acquire(). Neither
+// side ever blocks or sees a half written object. Slots are reused, so
+// anything sized with for_each_buffer() up front is never reallocated.
+template<typename Type>
+class triple_buffer
+{
+public:
+
+    triple_buffer() = default;
+
+    triple_buffer(triple_buffer&) = delete;
+    triple_buffer operator=(triple_buffer&) = delete;
+
+    // Not thread safe - call before producer and consumer start
+    template<typename Function>
+    void for_each_buffer(Function&& function)
+    {
+        for (auto& buffer : buffers)
+            function(buffer);
+    }
+
+    // Producer
+    Type& write_buffer() noexcept
+    {
+        return buffers[back_index];
+    }
+
+    void publish() noexcept
+    {
+        back_index = state.exchange(static_cast<std::uint8_t>(back_index | dirty_bit),
+                                    std::memory_order_acq_rel) & index_mask;
+    }
+
+    // Consumer: latest published object (or the previous one if nothing new arrived)
+    const Type& acquire() noexcept
+    {
+        if ((state.load(std::memory_order_relaxed) & dirty_bit) != 0)
+            front_index = state.exchange(front_index, std::memory_order_acq_rel) & index_mask;
+
+        return buffers[front_index];
+    }
+
+    bool has_new_data() const noexcept
+    {
+        return (state.load(std::memory_order_relaxed) & dirty_bit) != 0;
+    }
+
+private:
+
+    static constexpr std::uint8_t index_mask = 0x3;
+    static constexpr std::uint8_t dirty_bit  = 0x4;
+
+    std::array<Type, 3> buffers;
+
+    std::atomic<std::uint8_t> state { 1 };   // middle slot index + dirty flag
+
+    std::uint8_t back_index  = 0;            // producer only
+    std::uint8_t front_index = 2;            // consumer only
+};
+
+}
@@ -21,30 +21,19 @@ public:
 
     PitchMPM(int sampleRate, size_t bufferSize) :
     bufferSize (bufferSize),
-    sampleRate (sampleRate),
-    fftSize (2 * bufferSize), // Needs to be a power of 2!
-    real (audiofft::AudioFFT::ComplexSize(fftSize)),
-    imag (audiofft::AudioFFT::ComplexSize(fftSize)),
-    output (fftSize)
+    sampleRate (sampleRate)
     {
-        
+        setBufferSize ((int) bufferSize);
     }
     
     
     ~PitchMPM()
     {
-        maxPositions.clear();
-        ampEstimates.clear();
-        periodEstimates.clear();
     }
     
+    /** Allocation free: every buffer used here is sized by the constructor / setBufferSize */
     float getPitch(const float *audioBuffer)
     {
-        
-        maxPositions.clearQuick();
-        periodEstimates.clearQuick();
-        ampEstimates.clearQuick();
-        
         //nsdfTimeDomain(audioBuffer);
         //nsdfFrequencyDomain(audioBuffer);
         
@@ -52,10 +41,10 @@ public:
         {
             return 0.0f;
         }
-        //nsdf = Array<float> (nsdfFrequencyDomain(audioBuffer).data());
-        std::vector<float> _nsdf = nsdfFrequencyDomain(audioBuffer);
-        std::vector<int> max_positions = peak_picking(_nsdf);
-        std::vector<std::pair<float, float>> estimates;
+        
+        const std::vector<float>& _nsdf = nsdfFrequencyDomain(audioBuffer);
+        const std::vector<int>& max_positions = peak_picking(_nsdf);
+        estimates.clear(); // keeps its capacity
 
         //peakPicking();
         
@@ -96,14 +85,22 @@ public:
         sampleRate = newSampleRate;
     }
 
+    /** Sizes the FFT plan and all scratch buffers, not for the audio thread */
     void setBufferSize (int newBufferSize)
     {
         bufferSize = newBufferSize;
-        input.resize (bufferSize);
-        fftSize = 2 * bufferSize;
-        real.resize (audiofft::AudioFFT::ComplexSize(fftSize));
-        imag.resize (audiofft::AudioFFT::ComplexSize(fftSize));
-        output.resize (fftSize);
+        fftSize = 2 * bufferSize; // Needs to be a power of 2!
+        fft.init (fftSize);
+        input.assign (fftSize, 0.0f);
+        real.assign (audiofft::AudioFFT::ComplexSize(fftSize), 0.0f);
+        imag.assign (audiofft::AudioFFT::ComplexSize(fftSize), 0.0f);
+        output.assign (fftSize, 0.0f);
+        
+        // at most one peak per positive lobe, which is one per two samples
+        maxPositions.clear();
+        maxPositions.reserve (fftSize / 2 + 1);
+        estimates.clear();
+        estimates.reserve (fftSize / 2 + 1);
     }
 
 private:
@@ -121,9 +118,8 @@ private:
     float turningPointX, turningPointY;
     //Array<float> nsdf;
     
-    Array<int> maxPositions;
-    Array<float> periodEstimates;
-    Array<float> ampEstimates;
+    std::vector<int> maxPositions;
+    std::vector<std::pair<float, float>> estimates;
     
     /*
     void parabolicInterpolation(int tau)
@@ -191,7 +187,7 @@ private:
     }
      */
 
-    inline std::pair<float, float> parabolic_interpolation(std::vector<float> array, float x)
+    inline std::pair<float, float> parabolic_interpolation(const std::vector<float>& array, int x)
     {
         int x_adjusted;
 
@@ -202,14 +198,15 @@ private:
         } else {
             float den = array[x+1] + array[x-1] - 2 * array[x];
             float delta = array[x-1] - array[x+1];
-            return (!den) ? std::make_pair(x, array[x]) : std::make_pair(x + delta / (2 * den), array[x] - delta*delta/(8*den));
+            return (!den) ? std::make_pair((float) x, array[x]) : std::make_pair(x + delta / (2 * den), array[x] - delta*delta/(8*den));
         }
         return std::make_pair(x_adjusted, array[x_adjusted]);
     }
     
-    static std::vector<int> peak_picking(std::vector<float> nsdf)
+    const std::vector<int>& peak_picking(const std::vector<float>& nsdf)
     {
-        std::vector<int> max_positions{};
+        std::vector<int>& max_positions = maxPositions;
+        max_positions.clear(); // keeps its capacity
         int pos = 0;
         int curMaxPos = 0;
         ssize_t size = nsdf.size();
@@ -261,45 +258,33 @@ private:
     */
 
     // FFT based methods
-    std::vector<float> nsdfFrequencyDomain (const float *audioBuffer)
+    const std::vector<float>& nsdfFrequencyDomain (const float *audioBuffer)
     {
         //std::vector<std::complex<float>> acf(size2);
         //std::vector<float> acf_real{};
-    
-        real.resize (fftSize);
-        imag.resize (fftSize);
 
         if (audioBuffer == nullptr)
         {
             DBG ("audioBuffer NULL: nsdfFrequencyDomain");
         }
         
-        std::vector<float> acf (autoCorrelation (audioBuffer));
-
-        return acf;
+        return autoCorrelation (audioBuffer);
     }
 
-    std::vector<float> autoCorrelation(const float *audioBuffer)
+    const std::vector<float>& autoCorrelation(const float *audioBuffer)
     {
         if (audioBuffer == nullptr)
             DBG ("audioBuffer NULL: autoCorrelation");
         
         //AudioSampleBuffer paddedAudioBuffer (audioBuffer, 1, fftSize);
-        std::vector<float> input (audioBuffer, audioBuffer + bufferSize);
-        input.resize(fftSize, 0.0f);
-        
-        if (audioBuffer == nullptr)
-            DBG ("audioBuffer NULL: autoCorrelation post resize");
-        
-        if (input.data() == nullptr)
-            DBG ("input.data() NULL: autoCorrelation post resize");
+        // the upper half of input stays zero from setBufferSize()
+        std::copy (audioBuffer, audioBuffer + bufferSize, input.begin());
 
-        fft.init(fftSize);
         fft.fft(input.data(), real.data(), imag.data());
         //fft.fft(audioBuffer, real.data(), imag.data());
 
         // Complex Conjugate
-        for (int i = 0; i < fftSize; ++i)
+        for (size_t i = 0; i < real.size(); ++i)
         {
             /**
              * std::complex method
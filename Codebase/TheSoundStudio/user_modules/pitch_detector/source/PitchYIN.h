@@ -6,11 +6,13 @@ public:
     PitchYIN (int sampleRate, unsigned int bufferSize) : yin (1, bufferSize), bufferSize (bufferSize), tolerence (0.15),  sampleRate(sampleRate),
     deltaWasNegative (false)
     {
+        initFrequencyDomain();
     }
     
     PitchYIN (unsigned int bufferSize) : yin (1, bufferSize), bufferSize (bufferSize), tolerence (0.15), sampleRate(44100),
     deltaWasNegative (false)
     {
+        initFrequencyDomain();
     }
     
     void setSampleRate(unsigned int newSampleRate)
@@ -74,26 +76,21 @@ public:
     }
     
     
-    /** Full YIN algorithm */
+    /** Full YIN algorithm, input holds 2 * bufferSize samples */
     float calculatePitch (const float* inputData) noexcept
     {
         int period;
-        float delta = 0.0, runningSum = 0.0;
+        float runningSum = 0.0;
         float *yinData = yin.getWritePointer(0);
         //deltaWasNegative = false;
 
         //DBG ("calculatePitch");
 
+        differenceFrequencyDomain (inputData);
+
         yinData[0] = 1.0;
         for (int tau = 1; tau < yin.getNumSamples(); tau++)
         {
-            yinData[tau] = 0.0;
-            for (int j = 0; j < yin.getNumSamples(); j++)
-            {
-                delta = inputData[j] - inputData[j + tau];
-                yinData[tau] += (delta * delta);
-                //if (delta < 0) deltaWasNegative = true;
-            }
             runningSum += yinData[tau];
             if (runningSum != 0)
             {
@@ -139,6 +136,73 @@ public:
     }
 
 private:
+    /** FFT based difference function, O(N log N) instead of O(N^2)
+
+        d(tau) = sum_j (x[j] - x[j + tau])^2, j in [0, N)
+               = energy(0) + energy(tau) - 2 * r(tau)
+
+        where energy(tau) is the sum of x^2 over [tau, tau + N), updated incrementally,
+        and r(tau) = sum_j x[j] * x[j + tau] is the cross correlation of the first N
+        samples with the whole 2N frame. With the first half zero padded to 2N the
+        circular correlation never wraps for tau < N, so one 2N point FFT pair is enough.
+    */
+    void differenceFrequencyDomain (const float* inputData) noexcept
+    {
+        float *yinData = yin.getWritePointer(0);
+        const size_t numLags = (size_t) yin.getNumSamples();
+
+        std::copy (inputData, inputData + numLags, firstHalf.begin());
+        // the second half of firstHalf stays zero from initFrequencyDomain()
+
+        fft.fft (firstHalf.data(), firstHalfReal.data(), firstHalfImag.data());
+        fft.fft (inputData, frameReal.data(), frameImag.data());
+
+        // conj (A) * B
+        for (size_t i = 0; i < frameReal.size(); ++i)
+        {
+            const float ar = firstHalfReal[i], ai = firstHalfImag[i];
+            const float br = frameReal[i],     bi = frameImag[i];
+
+            frameReal[i] = ar * br + ai * bi;
+            frameImag[i] = ar * bi - ai * br;
+        }
+
+        fft.ifft (crossCorrelation.data(), frameReal.data(), frameImag.data());
+
+        double energyAtZero = 0.0;
+
+        for (size_t j = 0; j < numLags; ++j)
+            energyAtZero += (double) inputData[j] * inputData[j];
+
+        double energyAtTau = energyAtZero;
+
+        yinData[0] = 0.0;
+
+        for (size_t tau = 1; tau < numLags; ++tau)
+        {
+            energyAtTau += (double) inputData[tau + numLags - 1] * inputData[tau + numLags - 1]
+                         - (double) inputData[tau - 1] * inputData[tau - 1];
+
+            // rounding can take a near perfect match just below zero
+            yinData[tau] = (float) jmax (0.0, energyAtZero + energyAtTau - 2.0 * crossCorrelation[tau]);
+        }
+    }
+
+    void initFrequencyDomain()
+    {
+        fftSize = 2 * bufferSize; // Needs to be a power of 2!
+        fft.init (fftSize);
+
+        const size_t complexSize = audiofft::AudioFFT::ComplexSize (fftSize);
+
+        firstHalf.assign (fftSize, 0.0f);
+        crossCorrelation.assign (fftSize, 0.0f);
+        firstHalfReal.assign (complexSize, 0.0f);
+        firstHalfImag.assign (complexSize, 0.0f);
+        frameReal.assign (complexSize, 0.0f);
+        frameImag.assign (complexSize, 0.0f);
+    }
+
     AudioSampleBuffer yin; //, buf;
     //float* yinData;
     unsigned int bufferSize;
@@ -148,6 +212,14 @@ private:
     float currentPitch;
     Logger *log;
 
+    // FFT workspace, sized once in the constructor
+    audiofft::AudioFFT fft;
+    size_t fftSize;
+    std::vector<float> firstHalf;
+    std::vector<float> crossCorrelation;
+    std::vector<float> firstHalfReal, firstHalfImag;
+    std::vector<float> frameReal, frameImag;
+
 //    /** adapter to stack ibuf new samples at the end of buf, and trim `buf` to `bufsize` */
 //    void slideBlock (AudioSampleBuffer& ibuf)
 //    {